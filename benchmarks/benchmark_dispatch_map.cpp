@@ -13,130 +13,102 @@
 
 #include <dispatcher.hpp>
 
+#include <dynd/callables/less_callable.hpp>
 #include <dynd/dispatcher.hpp>
+#include <dynd/functional.hpp>
 #include <dynd/type.hpp>
 #include <dynd/type_registry.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
 
 using namespace std;
 using namespace dynd;
 
-template <size_t N>
-class DispatchFixture : public ::benchmark::Fixture {
-public:
-  vector<type_id_t[N]> ids;
+namespace {
 
-  void SetUp(const benchmark::State &state) {
-    ids.resize(state.range_x());
+typedef type_sequence<bool, int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t, uint32_t, uint64_t, float, double>
+    numeric_types;
 
-    default_random_engine generator;
-    uniform_int_distribution<underlying_type_t<type_id_t>> d(bool_id, callable_id);
+void func_ptr(const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+              ndt::type *res_tp) {
+  res_tp[0] = src_tp[0];
+  res_tp[1] = src_tp[1];
+}
 
-    for (auto &id : ids) {
-      for (size_t i = 0; i < N; ++i) {
-        id[i] = static_cast<type_id_t>(d(generator));
-      }
-    }
-  }
-};
+dispatcher<2, nd::callable> make_binary_dispatcher() {
+  return nd::callable::make_all<nd::less_callable, numeric_types, numeric_types>(func_ptr);
+}
+
+const vector<ndt::type> &numeric_dyn_types() {
+  static const vector<ndt::type> tps = {
+      ndt::make_type<bool>(),     ndt::make_type<int8_t>(),   ndt::make_type<int16_t>(), ndt::make_type<int32_t>(),
+      ndt::make_type<int64_t>(),  ndt::make_type<uint8_t>(),  ndt::make_type<uint16_t>(),
+      ndt::make_type<uint32_t>(), ndt::make_type<uint64_t>(), ndt::make_type<float>(),   ndt::make_type<double>()};
+  return tps;
+}
+
+} // anonymous namespace
 
-template <>
-class DispatchFixture<1> : public ::benchmark::Fixture {
+class BinaryDispatchFixture : public ::benchmark::Fixture {
 public:
-  vector<pair<type_id_t, type_id_t>> pairs;
+  vector<array<ndt::type, 2>> tps;
 
   void SetUp(const benchmark::State &state) {
-    pairs.resize(state.range_x());
+    tps.resize(state.range_x());
 
     default_random_engine generator;
-    uniform_int_distribution<underlying_type_t<type_id_t>> d(bool_id, callable_id);
+    uniform_int_distribution<size_t> d(0, numeric_dyn_types().size() - 1);
 
-    for (auto &pair : pairs) {
-      pair.first = static_cast<type_id_t>(d(generator));
-      pair.second = static_cast<type_id_t>(d(generator));
+    for (auto &tp : tps) {
+      tp[0] = numeric_dyn_types()[d(generator)];
+      tp[1] = numeric_dyn_types()[d(generator)];
     }
   }
 };
 
-typedef DispatchFixture<1> X;
-
-/*
-BENCHMARK_DEFINE_F(X, BM_IsBaseIDOf)(benchmark::State &state)
-{
+// Lookups through the dispatch table, which is warm after the first pass
+BENCHMARK_DEFINE_F(BinaryDispatchFixture, BM_BinaryDispatch)(benchmark::State &state) {
+  dispatcher<2, nd::callable> dispatcher = make_binary_dispatcher();
   while (state.KeepRunning()) {
-    for (const auto &pair : pairs) {
-      benchmark::DoNotOptimize(is_base_id_of(pair.first, pair.second));
-      benchmark::DoNotOptimize(is_base_id_of(pair.first, pair.second));
-      benchmark::DoNotOptimize(is_base_id_of(pair.first, pair.second));
-      benchmark::DoNotOptimize(is_base_id_of(pair.first, pair.second));
-      benchmark::DoNotOptimize(is_base_id_of(pair.first, pair.second));
-      benchmark::DoNotOptimize(is_base_id_of(pair.first, pair.second));
-      benchmark::DoNotOptimize(is_base_id_of(pair.first, pair.second));
-      benchmark::DoNotOptimize(is_base_id_of(pair.first, pair.second));
-      benchmark::DoNotOptimize(is_base_id_of(pair.first, pair.second));
-      benchmark::DoNotOptimize(is_base_id_of(pair.first, pair.second));
+    for (const auto &tp : tps) {
+      benchmark::DoNotOptimize(dispatcher(ndt::type(), 2, tp.data()));
     }
   }
-  state.SetItemsProcessed(10 * state.iterations() * state.range_x());
+  state.SetItemsProcessed(state.iterations() * state.range_x());
 }
 
-BENCHMARK_REGISTER_F(X, BM_IsBaseIDOf)->Arg(100)->Arg(1000)->Arg(10000);
-*/
-
-typedef DispatchFixture<1> UnaryDispatchFixture;
-typedef DispatchFixture<2> BinaryDispatchFixture;
+BENCHMARK_REGISTER_F(BinaryDispatchFixture, BM_BinaryDispatch)->Arg(100)->Arg(1000)->Arg(10000);
 
-/*
-BENCHMARK_DEFINE_F(BinaryDispatchFixture, BM_Supercedes)(benchmark::State &state)
-{
+// The linear scan over the topologically sorted children that the table replaces
+BENCHMARK_DEFINE_F(BinaryDispatchFixture, BM_BinarySearch)(benchmark::State &state) {
+  dispatcher<2, nd::callable> dispatcher = make_binary_dispatcher();
   while (state.KeepRunning()) {
-    for (const auto &pair : pairs) {
-      benchmark::DoNotOptimize(supercedes(pair.first, pair.second));
+    for (const auto &tp : tps) {
+      benchmark::DoNotOptimize(dispatcher.search(tp));
     }
   }
   state.SetItemsProcessed(state.iterations() * state.range_x());
 }
-*/
 
-// BENCHMARK_REGISTER_F(BinaryDispatchFixture, BM_Supercedes)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK_REGISTER_F(BinaryDispatchFixture, BM_BinarySearch)->Arg(100)->Arg(1000)->Arg(10000);
+
+// Dimension types fall outside of the table and always take the linear scan
+static void BM_BinaryDispatchDim(benchmark::State &state) {
+  dispatcher<2, nd::callable> dispatcher = make_binary_dispatcher();
+  dispatcher.insert(nd::get_elwise(ndt::type("(Dims... * Scalar, Dims... * Scalar) -> Any")));
 
-BENCHMARK_DEFINE_F(UnaryDispatchFixture, BM_UnaryDispatch)(benchmark::State &state) {
-  dispatcher<1, int> dispatcher{{{any_kind_id}, 0}, {{scalar_kind_id}, 1}, {{bool_id}, 2},    {{int8_id}, 3},
-                                {{int16_id}, 4},    {{int32_id}, 5},       {{int64_id}, 6},   {{int128_id}, 7},
-                                {{uint8_id}, 8},    {{uint16_id}, 9},      {{uint32_id}, 10}, {{uint64_id}, 11},
-                                {{uint128_id}, 12}, {{float32_id}, 13},    {{float64_id}, 14}};
+  ndt::type tps[2] = {ndt::make_type<ndt::fixed_dim_type>(10, ndt::make_type<int32_t>()),
+                      ndt::make_type<ndt::fixed_dim_type>(10, ndt::make_type<double>())};
   while (state.KeepRunning()) {
-    for (const auto &pair : pairs) {
-      benchmark::DoNotOptimize(dispatcher(pair.first));
-    }
+    benchmark::DoNotOptimize(dispatcher(ndt::type(), 2, tps));
   }
-  state.SetItemsProcessed(state.iterations() * state.range_x());
 }
 
-BENCHMARK_REGISTER_F(UnaryDispatchFixture, BM_UnaryDispatch)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK(BM_BinaryDispatchDim);
 
-/*
-static void BM_VirtualDispatch(benchmark::State &state)
-{
+static void BM_VirtualDispatch(benchmark::State &state) {
   while (state.KeepRunning()) {
     benchmark::DoNotOptimize((*item)());
   }
 }
 
 BENCHMARK(BM_VirtualDispatch);
-*/
-
-BENCHMARK_DEFINE_F(UnaryDispatchFixture, BM_BinaryDispatch)(benchmark::State &state) {
-  dispatcher<2, int> dispatcher{{{any_kind_id, int64_id}, 0},
-                                {{scalar_kind_id, int64_id}, 1},
-                                {{int32_id, int64_id}, 2},
-                                {{float32_id, int64_id}, 3},
-                                {{any_kind_id, any_kind_id}, 4}};
-  while (state.KeepRunning()) {
-    for (const auto &pair : pairs) {
-      benchmark::DoNotOptimize(dispatcher(pair.first, pair.second));
-    }
-  }
-  state.SetItemsProcessed(state.iterations() * state.range_x());
-}
-
-BENCHMARK_REGISTER_F(UnaryDispatchFixture, BM_BinaryDispatch)->Arg(100)->Arg(1000)->Arg(10000);
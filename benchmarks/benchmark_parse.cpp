@@ -0,0 +1,74 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <dynd/parse_util.hpp>
+
+using namespace std;
+using namespace dynd;
+
+static vector<std::string> make_numbers(const char *format) {
+  vector<std::string> numbers;
+  uint64_t bits = 12345;
+  char buffer[64];
+  while (numbers.size() < 1024) {
+    bits = bits * UINT64_C(6364136223846793005) + UINT64_C(1442695040888963407);
+    double value = static_cast<double>(bits >> 11) / static_cast<double>(UINT64_C(1) << 53) * 1e6;
+    numbers.push_back(std::string(buffer, snprintf(buffer, sizeof(buffer), format, value)));
+  }
+  return numbers;
+}
+
+static void BM_Parse_Double(benchmark::State &state) {
+  vector<std::string> numbers = make_numbers("%.17g");
+  while (state.KeepRunning()) {
+    for (const std::string &s : numbers) {
+      benchmark::DoNotOptimize(parse<double>(s.data(), s.data() + s.size()));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * numbers.size());
+}
+BENCHMARK(BM_Parse_Double);
+
+static void BM_Parse_DoubleStrtod(benchmark::State &state) {
+  vector<std::string> numbers = make_numbers("%.17g");
+  while (state.KeepRunning()) {
+    for (const std::string &s : numbers) {
+      benchmark::DoNotOptimize(strtod(s.c_str(), NULL));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * numbers.size());
+}
+BENCHMARK(BM_Parse_DoubleStrtod);
+
+static void BM_Parse_Float(benchmark::State &state) {
+  vector<std::string> numbers = make_numbers("%.9g");
+  while (state.KeepRunning()) {
+    for (const std::string &s : numbers) {
+      benchmark::DoNotOptimize(parse<float>(s.data(), s.data() + s.size()));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * numbers.size());
+}
+BENCHMARK(BM_Parse_Float);
+
+template <typename T>
+static void BM_Parse_UInt(benchmark::State &state) {
+  vector<std::string> numbers = make_numbers("%.0f");
+  while (state.KeepRunning()) {
+    for (const std::string &s : numbers) {
+      benchmark::DoNotOptimize(parse<T>(s.data(), s.data() + s.size()));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * numbers.size());
+}
+BENCHMARK_TEMPLATE(BM_Parse_UInt, uint32_t);
+BENCHMARK_TEMPLATE(BM_Parse_UInt, uint64_t);
@@ -19,9 +19,10 @@ typedef type_sequence<uint8_t, uint16_t, uint32_t, uint64_t, int8_t, int16_t, in
                       dynd::complex<float>, dynd::complex<double>>
     binop_types;
 
-inline std::vector<ndt::type> func_ptr(const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc),
-                                       const ndt::type *src_tp) {
-  return {src_tp[0], src_tp[1]};
+inline void func_ptr(const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+                     ndt::type *res_tp) {
+  res_tp[0] = src_tp[0];
+  res_tp[1] = src_tp[1];
 }
 
 template <template <typename, typename> class KernelType, template <typename, typename> class Condition,
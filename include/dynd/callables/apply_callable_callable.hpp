@@ -14,6 +14,24 @@ namespace nd {
   namespace functional {
     namespace detail {
 
+      /**
+       * Whether calling a ``func_type`` can't change it, which is false for a
+       * functor with a non-const ``operator()``, like a ``mutable`` lambda.
+       */
+      template <typename func_type, typename Enable = void>
+      struct is_const_callable {
+        static const bool value = true;
+      };
+
+      template <typename T, typename R, typename... A>
+      struct is_const_callable<R (T::*)(A...)> {
+        static const bool value = false;
+      };
+
+      template <typename func_type>
+      struct is_const_callable<func_type, std::enable_if_t<std::is_class<func_type>::value>>
+          : is_const_callable<decltype(&func_type::operator())> {};
+
       template <typename func_type, typename ReturnType, typename ArgSequence, typename KwdSequence, int N>
       class apply_callable_callable : public base_apply_callable<ReturnType, ArgSequence, KwdSequence> {
         func_type m_func;
@@ -28,6 +46,11 @@ namespace nd {
                           const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
           typedef functional::apply_callable_kernel<func_type, N> kernel_type;
 
+          // The kernel owns a copy of the functor, which keeps any changes a call makes to it
+          if (!is_const_callable<func_type>::value) {
+            cg.mark_stateful();
+          }
+
           cg.emplace_back([ func = m_func, kwds = typename kernel_type::kwds_type(nkwd, kwds) ](
               kernel_builder & kb, kernel_request_t kernreq, char *data, const char *dst_arrmeta,
               size_t DYND_UNUSED(narg), const char *const *src_arrmeta) {
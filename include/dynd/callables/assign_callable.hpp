@@ -262,7 +262,8 @@ namespace nd {
           size_t DYND_UNUSED(nsrc), const char *const *DYND_UNUSED(src_arrmeta)) {
         kb.emplace_back<detail::assignment_kernel<ndt::fixed_string_type, string, assign_error_nocheck>>(
             kernreq, get_next_unicode_codepoint_function(src0_encoding, error_mode),
-            get_append_unicode_codepoint_function(dst_encoding, error_mode), dst_data_size,
+            get_append_unicode_codepoint_function(dst_encoding, error_mode),
+            get_transcode_ascii_function(dst_encoding, src0_encoding), dst_data_size,
             error_mode != assign_error_nocheck);
       });
 
@@ -288,12 +289,13 @@ namespace nd {
                           const char *DYND_UNUSED(dst_arrmeta), size_t DYND_UNUSED(nsrc),
                           const char *const *DYND_UNUSED(src_arrmeta)) {
         const ndt::fixed_string_type *src_fs = src_tp[0].extended<ndt::fixed_string_type>();
+        string_encoding_t dst_encoding = dst_tp.extended<ndt::fixed_string_type>()->get_encoding();
         kb.emplace_back<
             detail::assignment_kernel<ndt::fixed_string_type, ndt::fixed_string_type, assign_error_nocheck>>(
             kernreq, get_next_unicode_codepoint_function(src_fs->get_encoding(), error_mode),
-            get_append_unicode_codepoint_function(dst_tp.extended<ndt::fixed_string_type>()->get_encoding(),
-                                                  error_mode),
-            dst_tp.get_data_size(), src_fs->get_data_size(), error_mode != assign_error_nocheck);
+            get_append_unicode_codepoint_function(dst_encoding, error_mode),
+            get_transcode_ascii_function(dst_encoding, src_fs->get_encoding()), dst_tp.get_data_size(),
+            src_fs->get_data_size(), error_mode != assign_error_nocheck);
       });
 
       return dst_tp;
@@ -474,7 +476,8 @@ namespace nd {
           size_t DYND_UNUSED(nsrc), const char *const *DYND_UNUSED(src_arrmeta)) {
         kb.emplace_back<detail::assignment_kernel<ndt::fixed_string_type, string, assign_error_nocheck>>(
             kernreq, get_next_unicode_codepoint_function(src0_encoding, error_mode),
-            get_append_unicode_codepoint_function(dst_encoding, error_mode), dst_data_size,
+            get_append_unicode_codepoint_function(dst_encoding, error_mode),
+            get_transcode_ascii_function(dst_encoding, src0_encoding), dst_data_size,
             error_mode != assign_error_nocheck);
       });
 
@@ -506,6 +509,37 @@ namespace nd {
     }
   };
 
+  template <typename Arg0Type>
+  class assign_callable<string_view, Arg0Type> : public base_callable {
+  public:
+    assign_callable()
+        : base_callable(ndt::make_type<ndt::callable_type>(
+              ndt::make_type<string_view>(), {ndt::make_type<Arg0Type>()},
+              {{ndt::make_type<ndt::option_type>(ndt::make_type<assign_error_mode>()), "error_mode"}})) {}
+
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
+                      size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
+                      const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
+      cg.emplace_back([](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data), const char *dst_arrmeta,
+                         size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
+        const memory_block &dst_memblock = reinterpret_cast<const string_view_type_arrmeta *>(dst_arrmeta)->blockref;
+        // Views of bytes the destination already holds a reference to are assigned as they are
+        bool shares_memblock =
+            std::is_same<Arg0Type, string_view>::value && dst_memblock &&
+            reinterpret_cast<const string_view_type_arrmeta *>(src_arrmeta[0])->blockref == dst_memblock;
+        if (!shares_memblock && !dst_memblock) {
+          throw std::runtime_error("cannot assign to a string_view without a memory block to copy into");
+        }
+
+        kb.emplace_back<detail::assignment_kernel<string_view, Arg0Type, assign_error_nocheck>>(kernreq, dst_memblock,
+                                                                                                 shares_memblock);
+      });
+
+      return dst_tp;
+    }
+  };
+
   template <>
   class assign_callable<ndt::option_type, ndt::option_type> : public base_callable {
   public:
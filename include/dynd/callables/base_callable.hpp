@@ -7,10 +7,14 @@
 
 #include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <typeinfo>
+#include <vector>
 
 #include <dynd/array.hpp>
 #include <dynd/callables/call_graph.hpp>
+#include <dynd/kernels/kernel_builder.hpp>
 #include <dynd/kernels/kernel_prefix.hpp>
 #include <dynd/types/callable_type.hpp>
 #include <dynd/types/substitute_typevars.hpp>
@@ -24,7 +28,8 @@ namespace nd {
     none = 0x00000000,
     left_associative = 0x00000001,
     right_associative = 0x00000002,
-    commutative = 0x00000004
+    commutative = 0x00000004,
+    associative = 0x00000008
   };
 
   inline callable_property operator|(callable_property a, callable_property b) {
@@ -50,12 +55,54 @@ namespace nd {
    * with different array arrmeta.
    */
   class DYND_API base_callable {
+    /**
+     * A ckernel instantiated from a cached call graph. The kernel is built
+     * against ``arrmeta``, a private copy of the dst and src arrmeta, so
+     * any arrmeta pointers it keeps stay valid for as long as it is cached.
+     */
+    struct cached_kernel {
+      kernel_request_t kernreq;
+      bool pooled;
+      std::vector<char> arrmeta;
+      std::unique_ptr<kernel_builder> kb;
+    };
+
+    /**
+     * The result of ``resolve`` for one (dst_tp, src_tp, tp_vars) signature,
+     * along with a small pool of ckernels instantiated from it. Only ckernels
+     * made entirely of kernels declared by ``is_stateless_kernel`` are pooled.
+     */
+    struct cached_resolution {
+      ndt::type dst_tp;
+      std::vector<ndt::type> src_tp;
+      std::map<std::string, ndt::type> tp_vars;
+      ndt::type res_tp;
+      call_graph cg;
+      // True when every type has arrmeta made only of plain values (no memory
+      // block references), so ckernels can be keyed on arrmeta bytes
+      bool pod_arrmeta;
+      std::vector<cached_kernel> kernels;
+    };
+
+    std::mutex m_cache_mutex;
+    size_t m_cache_generation;
+    std::vector<std::shared_ptr<cached_resolution>> m_cache;
+
+    std::shared_ptr<cached_resolution> find_or_resolve(const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp,
+                                                       const std::map<std::string, ndt::type> &tp_vars);
+
+    cached_kernel acquire_kernel(cached_resolution &res, kernel_request_t kernreq, const ndt::type &dst_tp,
+                                 const char *dst_arrmeta, size_t nsrc, const ndt::type *src_tp,
+                                 const char *const *src_arrmeta);
+
+    void release_kernel(cached_resolution &res, cached_kernel &&ck);
+
   protected:
     std::atomic_long m_use_count;
     ndt::type m_tp;
 
   public:
-    base_callable(const ndt::type &tp) : m_use_count(0), m_tp(tp) {}
+    base_callable(const ndt::type &tp) : m_cache_generation(0), m_use_count(0), m_tp(tp) {}
 
     // non-copyable
     base_callable(const base_callable &) = delete;
@@ -140,6 +187,13 @@ namespace nd {
               const char *const *src_arrmeta, char *const *src_data, size_t nkwd, const array *kwds,
               const std::map<std::string, ndt::type> &tp_vars);
 
+    /**
+     * Discards the resolved call graphs and ckernels cached by every callable.
+     * This must be called whenever a change to a callable (e.g. adding an
+     * overload) can alter what ``resolve`` produces.
+     */
+    static void invalidate_call_caches();
+
     friend void intrusive_ptr_retain(base_callable *ptr);
     friend void intrusive_ptr_release(base_callable *ptr);
     friend long intrusive_ptr_use_count(base_callable *ptr);
@@ -32,6 +32,7 @@ namespace nd {
         intptr_t res_alignment;
         size_t ndim;
         bool res_ignore;
+        bool parallel;
       };
 
     public:
@@ -39,6 +40,12 @@ namespace nd {
 
       virtual void subresolve(call_graph &cg, const char *data) = 0;
 
+      /**
+       * Stops the node that ``subresolve`` emplaced at ``node_offset`` from
+       * splitting its loop across threads.
+       */
+      virtual void disable_parallel(call_graph &DYND_UNUSED(cg), intptr_t DYND_UNUSED(node_offset)) {}
+
       virtual ndt::type with_return_type(intptr_t ret_size, const ndt::type &ret_element_tp) = 0;
 
       ndt::type resolve(base_callable *caller, char *codata, call_graph &cg, const ndt::type &res_tp,
@@ -63,9 +70,6 @@ namespace nd {
             arg_element_tp[i] = arg_tp[i];
           } else {
             arg_size[i] = arg_tp[i].extended<ndt::base_dim_type>()->get_dim_size();
-            if (arg_size[i] == 1) {
-              data.arg_broadcast[i] = true;
-            }
             arg_element_tp[i] = arg_tp[i].extended<ndt::base_dim_type>()->get_element_type();
           }
         }
@@ -74,6 +78,14 @@ namespace nd {
           data.arg_var[i] = arg_tp[i].get_id() == var_dim_id;
         }
 
+        // Types that reference memory blocks may allocate from them, which can't be done from several threads
+        data.parallel = true;
+        for (size_t i = 0; i < N; ++i) {
+          if (arg_tp[i].get_flags() & type_flag_blockref) {
+            data.parallel = false;
+          }
+        }
+
         intptr_t res_size;
         ndt::type res_element_tp;
         if (res_ignore) {
@@ -103,6 +115,7 @@ namespace nd {
           }
         }
 
+        intptr_t node_offset = cg.size();
         subresolve(cg, reinterpret_cast<char *>(&data));
 
         if (--reinterpret_cast<codata_type *>(codata)->ndim > 0) {
@@ -113,10 +126,21 @@ namespace nd {
                                           arg_element_tp.data(), nkwd, kwds, tp_vars);
         }
 
+        // A child that keeps state from one element to the next, like a mutable functor, has to see them in
+        // order from one thread
+        if (cg.is_stateful()) {
+          disable_parallel(cg, node_offset);
+        }
+
         if (res_ignore) {
           return res_element_tp;
         }
 
+        // The return type is only known for certain once the child has resolved it
+        if (res_element_tp.get_flags() & type_flag_blockref) {
+          disable_parallel(cg, node_offset);
+        }
+
         return with_return_type(res_size, res_element_tp);
       }
     };
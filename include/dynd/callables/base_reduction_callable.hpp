@@ -21,6 +21,7 @@ namespace nd {
       struct data_type {
         callable identity;
         callable child;
+        bool associative;
         bool keepdims;
         size_t naxis;
         const int *axes;
@@ -32,6 +33,8 @@ namespace nd {
         bool inner;
         bool broadcast;
         bool keepdim;
+        // The size of a partial result when an inner reduction may be split across threads, otherwise zero
+        size_t partial_size;
       };
 
       base_reduction_callable() : base_callable(ndt::type()) {}
@@ -54,6 +57,7 @@ namespace nd {
         }
         node.broadcast = !reduce;
         node.keepdim = reinterpret_cast<data_type *>(data)->keepdims;
+        node.partial_size = 0;
 
         std::vector<ndt::type> arg_element_tp(2);
         for (size_t i = 0; i < nsrc; ++i) {
@@ -68,6 +72,10 @@ namespace nd {
         ndt::type ret_element_tp;
         if (reinterpret_cast<data_type *>(data)->axis == reinterpret_cast<data_type *>(data)->ndim) {
           node.inner = true;
+          if (reinterpret_cast<data_type *>(data)->associative && nsrc == 1 && arg_element_tp[0].is_builtin() &&
+              (child_ret_tp.is_symbolic() || child_ret_tp == arg_element_tp[0])) {
+            node.partial_size = arg_element_tp[0].get_data_size();
+          }
           resolve(cg, reinterpret_cast<char *>(&node));
 
           ret_element_tp =
@@ -103,10 +111,11 @@ namespace nd {
         bool inner = reinterpret_cast<node_type *>(data)->inner;
         bool broadcast = reinterpret_cast<node_type *>(data)->broadcast;
         bool keepdim = reinterpret_cast<node_type *>(data)->keepdim;
+        size_t partial_size = reinterpret_cast<node_type *>(data)->partial_size;
 
-        cg.emplace_back([inner, broadcast, keepdim](kernel_builder &kb, kernel_request_t kernreq,
-                                                    char *DYND_UNUSED(data), const char *dst_arrmeta, size_t nsrc,
-                                                    const char *const *src_arrmeta) {
+        cg.emplace_back([inner, broadcast, keepdim, partial_size](kernel_builder &kb, kernel_request_t kernreq,
+                                                                  char *DYND_UNUSED(data), const char *dst_arrmeta,
+                                                                  size_t nsrc, const char *const *src_arrmeta) {
           if (inner) {
             if (!broadcast) {
               intptr_t src_size = reinterpret_cast<const size_stride_t *>(src_arrmeta[0])->dim_size;
@@ -119,6 +128,7 @@ namespace nd {
                 e->src_stride[i] = reinterpret_cast<const size_stride_t *>(src_arrmeta[i])->stride;
               }
               e->_size = src_size;
+              e->partial_size = partial_size;
 
               e->size_first = e->_size;
               for (size_t i = 0; i < NArg; ++i) {
@@ -12,9 +12,19 @@ namespace dynd {
 namespace nd {
 
   class call_graph : public storagebuf<call_node, call_graph> {
+    bool m_stateful = false;
+
   public:
     void destroy() {}
 
+    /**
+     * Records that the ckernels built from this graph keep state from one call
+     * to the next, so a ckernel must not be reused for another call.
+     */
+    void mark_stateful() { m_stateful = true; }
+
+    bool is_stateful() const { return m_stateful; }
+
     ~call_graph() {
       intptr_t offset = 0;
       while (offset != m_size) {
@@ -24,6 +34,15 @@ namespace nd {
       }
     }
 
+    /**
+     * Gets the closure of the node at the requested offset, for a callable to
+     * amend the node it emplaced once the rest of the graph has been resolved.
+     */
+    template <typename ClosureType>
+    ClosureType *get_closure_at(intptr_t offset) {
+      return reinterpret_cast<ClosureType *>(get_at<char>(offset) + aligned_size(sizeof(call_node)));
+    }
+
     template <typename ClosureType, typename... ArgTypes>
     void emplace_back(ArgTypes &&... args) {
       storagebuf<call_node, call_graph>::emplace_back_sep<ClosureType>(std::forward<ArgTypes>(args)...);
@@ -14,6 +14,9 @@ namespace nd {
   namespace functional {
 
     struct no_traits {
+      // The child holds no state, so it may be evaluated from several threads at once
+      static const bool parallel = true;
+
       no_traits(char *DYND_UNUSED(data)) {}
 
       size_t begin() { return 0; }
@@ -22,6 +25,8 @@ namespace nd {
     };
 
     struct state_traits {
+      static const bool parallel = false;
+
       size_t &it;
 
       state_traits(char *data) : it(*reinterpret_cast<size_t *>(data)) {}
@@ -45,14 +50,14 @@ namespace nd {
     class elwise_callable<fixed_dim_id, fixed_dim_id, TraitsType, N> : public base_elwise_callable<N> {
       typedef typename base_elwise_callable<N>::data_type data_type;
 
-    public:
-      void subresolve(call_graph &cg, const char *data) {
-        bool res_broadcast = reinterpret_cast<const data_type *>(data)->res_ignore;
-        const std::array<bool, N> &arg_broadcast = reinterpret_cast<const data_type *>(data)->arg_broadcast;
+      struct node_type {
+        bool res_broadcast;
+        std::array<bool, N> arg_broadcast;
+        bool parallel;
+        size_t ndim;
 
-        cg.emplace_back([res_broadcast, arg_broadcast](kernel_builder &kb, kernel_request_t kernreq, char *data,
-                                                       const char *dst_arrmeta, size_t DYND_UNUSED(nsrc),
-                                                       const char *const *src_arrmeta) {
+        void operator()(kernel_builder &kb, kernel_request_t kernreq, char *data, const char *dst_arrmeta,
+                        size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) const {
           size_t size;
           if (res_broadcast) {
             size = reinterpret_cast<const size_stride_t *>(src_arrmeta[0])->dim_size;
@@ -77,16 +82,44 @@ namespace nd {
               src_stride[i] = 0;
               child_src_arrmeta[i] = src_arrmeta[i];
             } else {
-              src_stride[i] = reinterpret_cast<const size_stride_t *>(src_arrmeta[i])->stride;
+              // A dimension of size one is broadcast, but its arrmeta is still skipped
+              const size_stride_t *src_md = reinterpret_cast<const size_stride_t *>(src_arrmeta[i]);
+              src_stride[i] = (src_md->dim_size == 1) ? 0 : src_md->stride;
               child_src_arrmeta[i] = src_arrmeta[i] + sizeof(size_stride_t);
             }
           }
 
-          kb.emplace_back<elwise_kernel<fixed_dim_id, fixed_dim_id, TraitsType, N>>(kernreq, data, size, dst_stride,
-                                                                                    src_stride.data());
+          // The number of elements in the remaining elementwise dimensions, all of which are fixed when parallel
+          size_t inner_size = 0;
+          if (parallel) {
+            inner_size = 1;
+            for (size_t i = 1; i < ndim; ++i) {
+              inner_size *= reinterpret_cast<const size_stride_t *>(child_dst_arrmeta)[i - 1].dim_size;
+            }
+          }
+
+          intptr_t root_kb_offset = kb.size();
+          kb.emplace_back<elwise_kernel<fixed_dim_id, fixed_dim_id, TraitsType, N>>(
+              kernreq, data, size, dst_stride, src_stride.data(), inner_size, ndim == 1);
 
           kb(kernel_request_strided, TraitsType::child_data(data), child_dst_arrmeta, N, child_src_arrmeta.data());
-        });
+
+          // The kernels of the dimensions inside this one exist now, so their loops can be rearranged
+          kb.get_at<elwise_kernel<fixed_dim_id, fixed_dim_id, TraitsType, N>>(root_kb_offset)->optimize_loops();
+        }
+      };
+
+    public:
+      void subresolve(call_graph &cg, const char *data) {
+        const data_type *node_data = reinterpret_cast<const data_type *>(data);
+        bool res_broadcast = node_data->res_ignore;
+        bool parallel = TraitsType::parallel && !res_broadcast && node_data->parallel;
+
+        cg.emplace_back(node_type{res_broadcast, node_data->arg_broadcast, parallel, node_data->ndim});
+      }
+
+      void disable_parallel(call_graph &cg, intptr_t node_offset) {
+        cg.get_closure_at<node_type>(node_offset)->parallel = false;
       }
 
       ndt::type with_return_type(intptr_t ret_size, const ndt::type &ret_element_tp) {
@@ -125,9 +158,10 @@ namespace nd {
                 src_stride[i] = 0;
                 child_src_arrmeta[i] = src_arrmeta[i];
               } else {
+                const size_stride_t *src_md = reinterpret_cast<const size_stride_t *>(src_arrmeta[i]);
                 src_offset[i] = 0;
-                src_stride[i] = reinterpret_cast<const size_stride_t *>(src_arrmeta[i])->stride;
-                child_src_arrmeta[i] = src_arrmeta[i] + sizeof(ndt::var_dim_type::metadata_type);
+                src_stride[i] = (src_md->dim_size == 1) ? 0 : src_md->stride;
+                child_src_arrmeta[i] = src_arrmeta[i] + sizeof(size_stride_t);
               }
             }
           }
@@ -191,6 +225,7 @@ namespace nd {
                 src_offset[i] = 0;
                 src_stride[i] = reinterpret_cast<const size_stride_t *>(src_arrmeta[i])->stride;
                 src_size[i] = reinterpret_cast<const size_stride_t *>(src_arrmeta[i])->dim_size;
+                child_src_arrmeta[i] = src_arrmeta[i] + sizeof(size_stride_t);
               }
             }
           }
@@ -0,0 +1,73 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/callables/base_callable.hpp>
+#include <dynd/kernels/fused_kernel.hpp>
+#include <dynd/kernels/jit_kernel.hpp>
+
+namespace dynd {
+namespace nd {
+  namespace functional {
+
+    /**
+     * A scalar callable that applies the steps of a fused program, producing one
+     * kernel that runs all of them. Lifting it with ``elwise`` streams the inputs
+     * once, instead of writing an array for the result of each step.
+     */
+    class fused_callable : public base_callable {
+      std::shared_ptr<const fused_program> m_program;
+
+    public:
+      fused_callable(const ndt::type &tp, const std::shared_ptr<const fused_program> &program)
+          : base_callable(tp), m_program(program) {}
+
+      ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                        const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
+                        size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
+                        const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
+#ifdef DYND_LLVM
+        // Machine code for the whole program replaces the kernels of its steps
+        jit::strided_function function = jit::compile(*m_program);
+        if (function != nullptr) {
+          cg.emplace_back([ function, program = m_program ](kernel_builder & kb, kernel_request_t kernreq,
+                                                            char *DYND_UNUSED(data),
+                                                            const char *DYND_UNUSED(dst_arrmeta),
+                                                            size_t DYND_UNUSED(nsrc),
+                                                            const char *const *DYND_UNUSED(src_arrmeta)) {
+            kb.emplace_back<jit_kernel>(kernreq, function, program->nsrc);
+          });
+          return dst_tp;
+        }
+#endif
+
+        cg.emplace_back([program = m_program](kernel_builder & kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                                              const char *DYND_UNUSED(dst_arrmeta), size_t DYND_UNUSED(nsrc),
+                                              const char *const *DYND_UNUSED(src_arrmeta)) {
+          intptr_t root_kb_offset = kb.size();
+          kb.emplace_back<fused_kernel>(kernreq, program);
+
+          // The steps only see scalars, whose types have no arrmeta
+          const char *child_arrmeta[max_fused_args] = {nullptr};
+          for (const fused_step &step : program->steps) {
+            intptr_t kb_offset = kb.size();
+            kb(kernel_request_strided, nullptr, nullptr, step.args.size(), child_arrmeta);
+            kb.get_at<fused_kernel>(root_kb_offset)->m_child_offsets.push_back(kb_offset - root_kb_offset);
+          }
+        });
+
+        for (const fused_step &step : m_program->steps) {
+          step.f->resolve(this, nullptr, cg, step.dst_tp, step.src_tp.size(), step.src_tp.data(), 0, nullptr,
+                         step.tp_vars);
+        }
+
+        return dst_tp;
+      }
+    };
+
+  } // namespace dynd::nd::functional
+} // namespace dynd::nd
+} // namespace dynd
@@ -5,8 +5,11 @@
 
 #pragma once
 
+#include <dynd/arithmetic.hpp>
 #include <dynd/callables/base_callable.hpp>
 #include <dynd/kernels/mean_kernel.hpp>
+#include <dynd/option.hpp>
+#include <dynd/types/option_type.hpp>
 
 namespace dynd {
 namespace nd {
@@ -20,35 +23,31 @@ namespace nd {
                                                            {ndt::make_type<ndt::any_kind_type>()})),
           m_tp(tp) {}
 
-    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &DYND_UNUSED(cg),
-                      const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
-                      size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
-                      const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
-      return dst_tp;
-    }
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp, size_t DYND_UNUSED(nkwd),
+                      const array *DYND_UNUSED(kwds), const std::map<std::string, ndt::type> &tp_vars) {
+      ndt::type arg0_tp = src_tp[0];
+      cg.emplace_back([arg0_tp](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                                const char *dst_arrmeta, size_t nsrc, const char *const *src_arrmeta) {
+        intptr_t mean_offset = kb.size();
+        kb.emplace_back<mean_kernel>(kernreq, arg0_tp.get_size(src_arrmeta[0]));
+
+        kb(kernel_request_single, nullptr, dst_arrmeta, nsrc, src_arrmeta);
+
+        kb.get_at<mean_kernel>(mean_offset)->compound_div_offset = kb.size() - mean_offset;
+        const char *child_src_arrmeta[1] = {nullptr};
+        kb(kernel_request_single, nullptr, dst_arrmeta, 1, child_src_arrmeta);
+      });
 
-    /*
-        void instantiate(call_node *&node, char *data, kernel_builder *ckb, const ndt::type &dst_tp,
-                         const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp, const char *const
-       *src_arrmeta,
-                         kernel_request_t kernreq, intptr_t nkwd, const array *kwds,
-                         const std::map<std::string, ndt::type> &tp_vars) {
-          intptr_t mean_offset = ckb->size();
-          ckb->emplace_back<mean_kernel>(kernreq, src_tp[0].get_size(src_arrmeta[0]));
-          node = next(node);
-
-          nd::sum->instantiate(node, reinterpret_cast<data_type *>(data)->sum_data, ckb, dst_tp, dst_arrmeta, nsrc,
-       src_tp,
-                               src_arrmeta, kernreq, nkwd, kwds, tp_vars);
-
-          mean_kernel *self = ckb->get_at<mean_kernel>(mean_offset);
-          self->compound_div_offset = ckb->size();
-          nd::compound_div->instantiate(node, reinterpret_cast<data_type *>(data)->compound_div_data, ckb, dst_tp,
-                                        dst_arrmeta, 1, &m_tp, NULL, kernreq, nkwd, kwds, tp_vars);
-
-          delete reinterpret_cast<data_type *>(data);
-        }
-    */
+      // Without "axes" or "keepdims", sum reduces all the dimensions
+      ndt::type na_tp = ndt::make_type<ndt::option_type>(ndt::make_type<void>());
+      array sum_kwds[2] = {assign_na({{"dst_tp", na_tp}}), assign_na({{"dst_tp", na_tp}})};
+      ndt::type res_tp = sum->resolve(this, nullptr, cg, dst_tp, nsrc, src_tp, 2, sum_kwds, tp_vars);
+
+      compound_div->resolve(this, nullptr, cg, res_tp, 1, &m_tp, 0, nullptr, tp_vars);
+
+      return res_tp;
+    }
   };
 
 } // namespace dynd::nd
@@ -13,6 +13,19 @@ namespace dynd {
 namespace nd {
 
   class sort_callable : public base_callable {
+    template <typename Arg0Type>
+    static const ndt::type &resolve_typed(call_graph &cg, const ndt::type &dst_tp) {
+      cg.emplace_back([](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                         const char *DYND_UNUSED(dst_arrmeta), size_t DYND_UNUSED(nsrc),
+                         const char *const *src_arrmeta) {
+        kb.emplace_back<typed_sort_kernel<Arg0Type>>(
+            kernreq, reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
+            reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride);
+      });
+
+      return dst_tp;
+    }
+
   public:
     sort_callable()
         : base_callable(ndt::make_type<ndt::callable_type>(ndt::make_type<void>(), {ndt::type("Fixed * Scalar")})) {}
@@ -22,6 +35,35 @@ namespace nd {
                       size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
                       const std::map<std::string, ndt::type> &tp_vars) {
       const ndt::type &src0_element_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
+
+      // Builtin integer, floating point and boolean values are sorted directly, anything else through nd::less
+      switch (src0_element_tp.get_id()) {
+      case bool_id:
+        return resolve_typed<bool1>(cg, dst_tp);
+      case int8_id:
+        return resolve_typed<int8_t>(cg, dst_tp);
+      case int16_id:
+        return resolve_typed<int16_t>(cg, dst_tp);
+      case int32_id:
+        return resolve_typed<int32_t>(cg, dst_tp);
+      case int64_id:
+        return resolve_typed<int64_t>(cg, dst_tp);
+      case uint8_id:
+        return resolve_typed<uint8_t>(cg, dst_tp);
+      case uint16_id:
+        return resolve_typed<uint16_t>(cg, dst_tp);
+      case uint32_id:
+        return resolve_typed<uint32_t>(cg, dst_tp);
+      case uint64_id:
+        return resolve_typed<uint64_t>(cg, dst_tp);
+      case float32_id:
+        return resolve_typed<float>(cg, dst_tp);
+      case float64_id:
+        return resolve_typed<double>(cg, dst_tp);
+      default:
+        break;
+      }
+
       size_t src0_element_data_size = src0_element_tp.get_data_size();
       cg.emplace_back([src0_element_data_size](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
                                                const char *DYND_UNUSED(dst_arrmeta), size_t DYND_UNUSED(nsrc),
@@ -0,0 +1,52 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/callables/base_callable.hpp>
+#include <dynd/kernels/string_contains_any_kernel.hpp>
+#include <dynd/types/fixed_dim_kind_type.hpp>
+#include <dynd/types/string_kind_type.hpp>
+
+namespace dynd {
+namespace nd {
+
+  template <typename Arg0Type>
+  class string_contains_any_callable : public base_callable {
+  public:
+    string_contains_any_callable()
+        : base_callable(ndt::make_type<ndt::callable_type>(
+              ndt::make_type<bool1>(), {ndt::make_type<Arg0Type>()},
+              {{ndt::make_type<ndt::fixed_dim_kind_type>(ndt::make_type<ndt::string_kind_type>()), "patterns"}})) {}
+
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc),
+                      const ndt::type *DYND_UNUSED(src_tp), size_t DYND_UNUSED(nkwd), const array *kwds,
+                      const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
+      // The automaton depends on the pattern values, which calls with keywords
+      // resolve afresh every time
+      intptr_t npatterns = kwds[0].get_dim_size();
+      std::vector<std::string> patterns(npatterns);
+      std::vector<std::pair<const char *, size_t>> ranges(npatterns);
+      for (intptr_t i = 0; i < npatterns; ++i) {
+        patterns[i] = kwds[0](i).as<std::string>();
+        ranges[i] = std::make_pair(patterns[i].data(), patterns[i].size());
+      }
+
+      std::shared_ptr<dynd::detail::aho_corasick> matcher = std::make_shared<dynd::detail::aho_corasick>();
+      matcher->assign(ranges);
+
+      cg.emplace_back([matcher](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                                const char *DYND_UNUSED(dst_arrmeta), size_t DYND_UNUSED(nsrc),
+                                const char *const *DYND_UNUSED(src_arrmeta)) {
+        kb.emplace_back<string_contains_any_kernel<Arg0Type>>(kernreq, matcher);
+      });
+
+      return get_ret_type();
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
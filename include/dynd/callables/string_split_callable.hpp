@@ -11,23 +11,60 @@
 namespace dynd {
 namespace nd {
 
+  template <typename Arg0Type, typename Arg1Type>
   class string_split_callable : public base_callable {
   public:
     string_split_callable()
-        : base_callable(ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::var_dim_type>(ndt::make_type<string>()),
-                                                           {ndt::make_type<string>(), ndt::make_type<string>()})) {}
+        : base_callable(
+              ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::var_dim_type>(ndt::make_type<Arg0Type>()),
+                                                 {ndt::make_type<Arg0Type>(), ndt::make_type<Arg1Type>()})) {}
 
     ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
-                      const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
-                      size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
+                      const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc),
+                      const ndt::type *DYND_UNUSED(src_tp), size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
+                      const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
+      cg.emplace_back([](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data), const char *dst_arrmeta,
+                         size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
+        if (std::is_same<Arg0Type, string_view>::value) {
+          // The pieces are views of the bytes the source views, so the memory block given to the
+          // destination's views when it was allocated keeps the source's alive
+          const string_view_type_arrmeta *dst_element_md = reinterpret_cast<const string_view_type_arrmeta *>(
+              dst_arrmeta + sizeof(ndt::var_dim_type::metadata_type));
+          const string_view_type_arrmeta *src_md = reinterpret_cast<const string_view_type_arrmeta *>(src_arrmeta[0]);
+          if (!dst_element_md->blockref) {
+            throw std::runtime_error("cannot split into string_views without a memory block to reference the source");
+          }
+          if (src_md->blockref) {
+            dst_element_md->blockref->add_reference(src_md->blockref.get());
+          }
+        }
+
+        kb.emplace_back<string_split_kernel<Arg0Type, Arg1Type>>(
+            kernreq, reinterpret_cast<const ndt::var_dim_type::metadata_type *>(dst_arrmeta)->blockref);
+      });
+
+      return get_ret_type();
+    }
+  };
+
+  template <typename Arg0Type, typename Arg1Type>
+  class string_split_offsets_callable : public base_callable {
+  public:
+    string_split_offsets_callable()
+        : base_callable(ndt::make_type<ndt::callable_type>(ndt::type("var * 2 * intptr"),
+                                                           {ndt::make_type<Arg0Type>(), ndt::make_type<Arg1Type>()})) {}
+
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc),
+                      const ndt::type *DYND_UNUSED(src_tp), size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
                       const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
       cg.emplace_back([](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data), const char *dst_arrmeta,
                          size_t DYND_UNUSED(nsrc), const char *const *DYND_UNUSED(src_arrmeta)) {
-        kb.emplace_back<string_split_kernel>(
+        kb.emplace_back<string_split_offsets_kernel<Arg0Type, Arg1Type>>(
             kernreq, reinterpret_cast<const ndt::var_dim_type::metadata_type *>(dst_arrmeta)->blockref);
       });
 
-      return dst_tp;
+      return get_ret_type();
     }
   };
 
@@ -11,11 +11,14 @@
 namespace dynd {
 namespace nd {
 
-  class string_startswith_callable : public default_instantiable_callable<string_startswith_kernel> {
+  template <typename Arg0Type, typename Arg1Type>
+  class string_startswith_callable
+      : public default_instantiable_callable<string_startswith_kernel<Arg0Type, Arg1Type>> {
   public:
     string_startswith_callable()
-        : default_instantiable_callable<string_startswith_kernel>(ndt::make_type<ndt::callable_type>(
-              ndt::make_type<bool>(), {ndt::make_type<string>(), ndt::make_type<string>()})) {}
+        : default_instantiable_callable<string_startswith_kernel<Arg0Type, Arg1Type>>(
+              ndt::make_type<ndt::callable_type>(ndt::make_type<bool>(),
+                                                 {ndt::make_type<Arg0Type>(), ndt::make_type<Arg1Type>()})) {}
   };
 
 } // namespace dynd::nd
@@ -7,40 +7,98 @@
 
 #include <dynd/callables/base_callable.hpp>
 #include <dynd/kernels/unique_kernel.hpp>
+#include <dynd/types/callable_type.hpp>
+#include <dynd/types/option_type.hpp>
 
 namespace dynd {
 namespace nd {
 
   class unique_callable : public base_callable {
+    template <typename Arg0Type>
+    static void resolve_typed(call_graph &cg, const ndt::type &dst_tp) {
+      cg.emplace_back([dst_tp](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                               const char *dst_arrmeta, size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
+        kb.emplace_back<unique_kernel<Arg0Type>>(
+            kernreq, reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
+            reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride, dst_tp, dst_arrmeta);
+      });
+    }
+
   public:
     unique_callable()
-        : base_callable(ndt::make_type<ndt::callable_type>(ndt::make_type<void>(), {ndt::type("Fixed * Scalar")})) {}
+        : base_callable(ndt::make_type<ndt::callable_type>(
+              ndt::make_type<ndt::any_kind_type>(), {ndt::type("Fixed * Scalar")},
+              {{ndt::make_type<ndt::option_type>(ndt::make_type<bool1>()), "counts"},
+               {ndt::make_type<ndt::option_type>(ndt::make_type<bool1>()), "inverse"}})) {}
 
-    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &DYND_UNUSED(cg),
-                      const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
-                      size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+                      size_t DYND_UNUSED(nkwd), const array *kwds,
                       const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
-      return dst_tp;
-    }
+      const ndt::type &src0_element_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
+      bool counts = !kwds[0].is_na() && kwds[0].as<bool>();
+      bool inverse = !kwds[1].is_na() && kwds[1].as<bool>();
 
-    /*
-        void instantiate(call_node *&node, char *data, kernel_builder *ckb, const ndt::type &DYND_UNUSED(dst_tp),
-                         const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
-                         const char *const *src_arrmeta, kernel_request_t kernreq, intptr_t nkwd, const nd::array *kwds,
-                         const std::map<std::string, ndt::type> &tp_vars) {
-          const ndt::type &src0_element_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
-          ckb->emplace_back<unique_kernel>(
-              kernreq, reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
-              reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride,
-       src0_element_tp.get_data_size());
-          node = next(node);
-
-          const ndt::type equal_src_tp[2] = {src0_element_tp, src0_element_tp};
-          equal->instantiate(node, data, ckb, ndt::make_type<bool1>(), NULL, 2, equal_src_tp, NULL,
-       kernel_request_single,
-                             nkwd, kwds, tp_vars);
+      // The values alone, or a struct of the values with the counts and inverse that were asked for
+      ndt::type res_tp = ndt::make_type<ndt::var_dim_type>(src0_element_tp);
+      if (counts || inverse) {
+        std::vector<std::string> names{"values"};
+        std::vector<ndt::type> types{res_tp};
+        if (counts) {
+          names.push_back("counts");
+          types.push_back(ndt::make_type<ndt::var_dim_type>(ndt::make_type<int64_t>()));
+        }
+        if (inverse) {
+          names.push_back("inverse");
+          types.push_back(ndt::make_fixed_dim(src_tp[0].extended<ndt::fixed_dim_type>()->get_fixed_dim_size(),
+                                              ndt::make_type<int64_t>()));
         }
-    */
+        res_tp = ndt::make_type<ndt::struct_type>(names, types);
+      }
+
+      switch (src0_element_tp.get_id()) {
+      case bool_id:
+        resolve_typed<bool1>(cg, res_tp);
+        break;
+      case int8_id:
+        resolve_typed<int8_t>(cg, res_tp);
+        break;
+      case int16_id:
+        resolve_typed<int16_t>(cg, res_tp);
+        break;
+      case int32_id:
+        resolve_typed<int32_t>(cg, res_tp);
+        break;
+      case int64_id:
+        resolve_typed<int64_t>(cg, res_tp);
+        break;
+      case uint8_id:
+        resolve_typed<uint8_t>(cg, res_tp);
+        break;
+      case uint16_id:
+        resolve_typed<uint16_t>(cg, res_tp);
+        break;
+      case uint32_id:
+        resolve_typed<uint32_t>(cg, res_tp);
+        break;
+      case uint64_id:
+        resolve_typed<uint64_t>(cg, res_tp);
+        break;
+      case float32_id:
+        resolve_typed<float>(cg, res_tp);
+        break;
+      case float64_id:
+        resolve_typed<double>(cg, res_tp);
+        break;
+      case string_id:
+        resolve_typed<string>(cg, res_tp);
+        break;
+      default:
+        throw std::invalid_argument("nd::unique: unsupported element type " + src0_element_tp.str());
+      }
+
+      return res_tp;
+    }
   };
 
 } // namespace dynd::nd
@@ -30,7 +30,25 @@
 #define DYND_UNUSED(x)
 
 /** The number of elements to process at once when doing chunking/buffering */
+#ifndef DYND_BUFFER_CHUNK_SIZE
 #define DYND_BUFFER_CHUNK_SIZE 128
+#endif
+
+/**
+ * The most bytes a buffered chunk should take, so that a chunk written by one
+ * kernel is still in cache when the next one reads it
+ */
+#ifndef DYND_BUFFER_CHUNK_BYTES
+#define DYND_BUFFER_CHUNK_BYTES 16384
+#endif
+
+/**
+ * The most bytes of one operand a tile should take when a kernel walks
+ * operands with different axis orders, like a transpose, in tiles
+ */
+#ifndef DYND_TILE_BYTES
+#define DYND_TILE_BYTES 16384
+#endif
 
 #ifdef __clang__
 
@@ -562,6 +580,17 @@ typedef uintptr_t offset_t;
 #define DYND_END_IGNORE_UNNECESSARY_PARENTHESES
 #endif
 
+/**
+ * Attributes for compiling a function for a wider instruction set than the rest
+ * of the library, for code that checks what the processor supports at runtime.
+ * They are left undefined where that isn't available.
+ */
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) &&                       \
+    !defined(__CUDACC__) && !defined(DYND_CLING)
+#define DYND_TARGET_AVX2 __attribute__((target("avx2")))
+#define DYND_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
 // Check endian: define DYND_BIG_ENDIAN if big endian, otherwise assume little
 #if defined(__GLIBC__)
 #include <endian.h>
@@ -5,24 +5,26 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 
-// #include <sparsehash/dense_hash_map>
-
 #include <dynd/type_registry.hpp>
 
 namespace dynd {
 
-typedef std::vector<ndt::type> (*dispatch_t)(const ndt::type &, size_t, const ndt::type *);
+/**
+ * Function prototype for selecting the types a dispatcher matches on from the
+ * types of a call. The function writes as many types to ``res_tp`` as the
+ * dispatcher has dimensions.
+ */
+typedef void (*dispatch_t)(const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp, ndt::type *res_tp);
 
 template <size_t N>
-std::array<ndt::type, N> as_array(const std::vector<ndt::type> &in) {
-  std::array<ndt::type, N> out;
-  for (size_t i = 0; i < N; ++i) {
-    out[i] = in[i];
-  }
+std::array<ndt::type, N> dispatch(dispatch_t func, const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp) {
+  std::array<ndt::type, N> res_tp;
+  func(dst_tp, nsrc, src_tp, res_tp.data());
 
-  return out;
+  return res_tp;
 }
 template <size_t N>
 bool ambiguous(const std::array<type_id_t, N> &lhs, const std::array<type_id_t, N> &rhs) {
@@ -91,6 +93,93 @@ namespace detail {
     }
   }
 
+  /**
+   * An open addressing hash table from tuples of builtin type ids to the index of the
+   * child they dispatch to. Lookups are lock-free, so concurrent calls can share it;
+   * clearing it is not, and has to be synchronized like any other change to the
+   * dispatcher. Copies start out empty.
+   */
+  template <size_t N>
+  class dispatch_table {
+    static const size_t capacity = 512;
+
+    // Each slot holds (index + 1) << 32 | key, with zero marking an empty slot
+    std::unique_ptr<std::atomic<uint64_t>[]> m_slots;
+
+    static size_t hash(uint32_t key) {
+      return static_cast<size_t>((key * UINT64_C(0x9E3779B97F4A7C15)) >> 55) & (capacity - 1);
+    }
+
+  public:
+    typedef uint32_t key_type;
+
+    dispatch_table() : m_slots(new std::atomic<uint64_t>[capacity]) { clear(); }
+
+    dispatch_table(const dispatch_table &DYND_UNUSED(other)) : dispatch_table() {}
+
+    dispatch_table &operator=(const dispatch_table &DYND_UNUSED(other)) {
+      clear();
+      return *this;
+    }
+
+    /**
+     * Packs the ids of ``tps`` into a key, which is only possible when every type is
+     * builtin. Other types are matched structurally, so their id alone doesn't
+     * determine the child.
+     */
+    static bool make_key(const std::array<ndt::type, N> &tps, key_type &key) {
+      if (N > sizeof(key_type)) {
+        return false;
+      }
+
+      key = 0;
+      for (size_t i = 0; i < N; ++i) {
+        if (!tps[i].is_builtin()) {
+          return false;
+        }
+        key |= static_cast<key_type>(tps[i].get_id()) << (8 * i);
+      }
+
+      return true;
+    }
+
+    intptr_t find(key_type key) const {
+      size_t j = hash(key);
+      for (size_t i = 0; i < capacity; ++i, j = (j + 1) & (capacity - 1)) {
+        uint64_t slot = m_slots[j].load(std::memory_order_acquire);
+        if (slot == 0) {
+          return -1;
+        }
+        if (static_cast<key_type>(slot) == key) {
+          return static_cast<intptr_t>(slot >> 32) - 1;
+        }
+      }
+
+      return -1;
+    }
+
+    void insert(key_type key, size_t index) {
+      uint64_t value = (static_cast<uint64_t>(index + 1) << 32) | key;
+
+      size_t j = hash(key);
+      for (size_t i = 0; i < capacity; ++i, j = (j + 1) & (capacity - 1)) {
+        uint64_t slot = 0;
+        if (m_slots[j].compare_exchange_strong(slot, value, std::memory_order_release, std::memory_order_acquire) ||
+            static_cast<key_type>(slot) == key) {
+          return;
+        }
+      }
+
+      // The table is full, so later lookups of this key keep searching the children
+    }
+
+    void clear() {
+      for (size_t i = 0; i < capacity; ++i) {
+        m_slots[i].store(0, std::memory_order_relaxed);
+      }
+    }
+  };
+
 } // namespace dynd::detail
 
 template <typename VertexIterator, typename EdgeIterator, typename Iterator>
@@ -132,36 +221,20 @@ inline std::ostream &print_ids(std::ostream &o, size_t nids, const ndt::type *tp
 
 template <size_t N, typename T>
 class dispatcher {
-  typedef std::map<size_t, T> Map;
-
 public:
   typedef T value_type;
 
-  typedef Map map_type;
-  //  typedef google::dense_hash_map<size_t, value_type> map_type;
-
   typedef typename std::vector<T>::iterator iterator;
   typedef typename std::vector<T>::const_iterator const_iterator;
 
 private:
   std::vector<T> m_children;
-  //  map_type m_map;
   dispatch_t m_dispatch;
+  // Children already resolved for tuples of builtin types, filled in on first use
+  detail::dispatch_table<N> m_table;
 
-  static size_t hash_combine(size_t seed, type_id_t id) { return seed ^ (id + (seed << 6) + (seed >> 2)); }
-
-  template <typename... IDTypes>
-  static size_t hash_combine(size_t seed, type_id_t id0, IDTypes... ids) {
-    return hash_combine(hash_combine(seed, id0), ids...);
-  }
-
-  template <size_t M>
-  static size_t hash_combine(size_t seed, std::array<type_id_t, M> ids) {
-    for (size_t i = 0; i < M; ++i) {
-      seed = hash_combine(seed, ids[i]);
-    }
-
-    return seed;
+  std::array<ndt::type, N> dispatch(const T &child) const {
+    return dynd::dispatch<N>(m_dispatch, child->get_ret_type(), child->get_narg(), child->get_arg_types().data());
   }
 
 public:
@@ -171,8 +244,6 @@ public:
 
   template <typename Iterator>
   dispatcher(dispatch_t dispatch, Iterator begin, Iterator end) : m_dispatch(dispatch) {
-    //    m_map.set_empty_key(uninitialized_id);
-
     assign(begin, end);
   }
 
@@ -182,23 +253,22 @@ public:
   void assign(Iterator begin, Iterator end) {
     m_children.resize(end - begin);
 
+    std::vector<std::array<ndt::type, N>> tps(m_children.size());
+    for (size_t i = 0; i < tps.size(); ++i) {
+      tps[i] = dispatch(begin[i]);
+    }
+
     std::vector<std::vector<size_t>> edges(m_children.size());
     for (size_t i = 0; i < edges.size(); ++i) {
-      const auto &f_i = begin[i];
-      std::array<ndt::type, N> tp_i =
-          as_array<N>(m_dispatch(f_i->get_ret_type(), f_i->get_narg(), f_i->get_arg_types().data()));
+      const std::array<ndt::type, N> &tp_i = tps[i];
 
       for (size_t j = i + 1; j < edges.size(); ++j) {
-        const auto &f_j = begin[j];
-        std::array<ndt::type, N> tp_j =
-            as_array<N>(m_dispatch(f_j->get_ret_type(), f_j->get_narg(), f_j->get_arg_types().data()));
+        const std::array<ndt::type, N> &tp_j = tps[j];
 
         if (ambiguous(tp_i, tp_j)) {
           bool ok = false;
           for (size_t k = 0; k < edges.size(); ++k) {
-            const auto &f_k = begin[k];
-            std::array<ndt::type, N> tp_k =
-                as_array<N>(m_dispatch(f_k->get_ret_type(), f_k->get_narg(), f_k->get_arg_types().data()));
+            const std::array<ndt::type, N> &tp_k = tps[k];
 
             if (supercedes(tp_k, tp_i) && supercedes(tp_k, tp_j)) {
               ok = true;
@@ -225,7 +295,7 @@ public:
 
     topological_sort(begin, end, edges, m_children.begin());
 
-    //    m_map.clear();
+    m_table.clear();
   }
 
   void assign(std::initializer_list<T> pairs) { assign(pairs.begin(), pairs.end()); }
@@ -250,31 +320,14 @@ public:
   const_iterator end() const { return m_children.end(); }
   const_iterator cend() const { return m_children.cend(); }
 
-  const value_type &operator()(const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp) {
-    std::vector<ndt::type> vector_tps = m_dispatch(dst_tp, nsrc, src_tp);
-    std::array<ndt::type, N> tps;
-
-    std::array<type_id_t, N> ids;
-    for (size_t i = 0; i < N; ++i) {
-      tps[i] = vector_tps[i];
-      ids[i] = tps[i].get_id();
-    }
-
-    //    size_t key = hash(ids);
-
-    /*
-        const auto &it = m_map.find(key);
-        if (it != m_map.end()) {
-          return it->second;
-        }
-    */
-
-    for (const T &child : m_children) {
-      std::array<ndt::type, N> other_tps =
-          as_array<N>(m_dispatch(child->get_ret_type(), child->get_narg(), child->get_arg_types().data()));
-
-      if (supercedes(tps, other_tps)) {
-        return child;
+  /**
+   * Returns the index of the first child whose signature supercedes ``tps``, doing
+   * a linear scan over the children in topological order.
+   */
+  size_t search(const std::array<ndt::type, N> &tps) const {
+    for (size_t i = 0; i < m_children.size(); ++i) {
+      if (supercedes(tps, dispatch(m_children[i]))) {
+        return i;
       }
     }
 
@@ -288,7 +341,22 @@ public:
     throw std::out_of_range(ss.str());
   }
 
-  //  const value_type &operator()(std::initializer_list<type_id_t> ids) { return operator()(ids.size(), ids.begin()); }
+  const value_type &operator()(const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp) {
+    std::array<ndt::type, N> tps = dynd::dispatch<N>(m_dispatch, dst_tp, nsrc, src_tp);
+
+    typename detail::dispatch_table<N>::key_type key;
+    if (!detail::dispatch_table<N>::make_key(tps, key)) {
+      return m_children[search(tps)];
+    }
+
+    intptr_t i = m_table.find(key);
+    if (i == -1) {
+      i = search(tps);
+      m_table.insert(key, i);
+    }
+
+    return m_children[i];
+  }
 
   static bool edge(const std::array<type_id_t, N> &u, const std::array<type_id_t, N> &v) {
     if (supercedes(u, v)) {
@@ -311,23 +379,6 @@ public:
     }
     return false;
   }
-
-  static size_t hash(type_id_t id) { return static_cast<size_t>(id); }
-
-  template <typename... IDTypes>
-  static size_t hash(type_id_t id0, IDTypes... ids) {
-    return hash_combine(hash(id0), ids...);
-  }
-
-  template <size_t M>
-  static size_t hash(std::array<type_id_t, M> ids) {
-    std::array<type_id_t, M - 1> new_ids;
-    for (size_t i = 1; i < M; ++i) {
-      new_ids[i - 1] = ids[i];
-    }
-
-    return hash_combine(hash(ids[0]), new_ids);
-  }
 };
 
 } // namespace dynd
@@ -13,8 +13,12 @@ namespace eval {
   struct DYNDT_API eval_context {
     // Default error mode for computations
     assign_error_mode errmode;
+    // Maximum number of threads used to evaluate an elementwise computation
+    size_t nthreads;
+    // Minimum number of elements a thread evaluates at a time
+    size_t grain_size;
 
-    eval_context() : errmode(assign_error_fractional) {}
+    eval_context() : errmode(assign_error_fractional), nthreads(1), grain_size(32768) {}
   };
 
   extern DYNDT_API eval_context default_eval_context;
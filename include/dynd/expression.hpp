@@ -0,0 +1,80 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <initializer_list>
+#include <memory>
+
+#include <dynd/callable.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * A deferred computation over arrays, built by applying callables to arrays and
+   * to other expressions. Nothing is computed until ``eval()``, which lowers the
+   * whole expression into one elementwise kernel when every step works on builtin
+   * scalars, so that each input is read once and no intermediate arrays are made.
+   *
+   * Example:
+   *     nd::array r = (nd::lazy(a) + b * c).eval();
+   */
+  class DYND_API expression {
+  public:
+    struct node;
+
+  private:
+    std::shared_ptr<const node> m_node;
+
+  public:
+    /** Constructs an expression which evaluates to ``value`` */
+    expression(const array &value);
+
+    /** Constructs an expression from a C++ value */
+    template <typename T,
+              typename = std::enable_if_t<ndt::has_traits<typename remove_reference_then_cv<T>::type>::value>>
+    expression(T &&value)
+        : expression(array(std::forward<T>(value))) {}
+
+    /**
+     * Constructs an expression applying ``f``, which must not take keyword arguments,
+     * to the values of ``args``.
+     */
+    expression(const callable &f, std::initializer_list<expression> args);
+
+    /**
+     * The type of the elements of the result, or a null type if it is only known
+     * once the arguments have been evaluated.
+     */
+    const ndt::type &get_dtype() const;
+
+    /**
+     * Returns whether ``eval()`` will run the expression as one fused kernel.
+     */
+    bool is_fusable() const;
+
+    /**
+     * Computes the value of the expression.
+     */
+    array eval() const;
+  };
+
+  /**
+   * Starts a deferred computation, so that arithmetic on the result builds an
+   * expression instead of evaluating each operation.
+   */
+  DYND_API expression lazy(const array &a);
+
+  DYND_API expression operator+(const expression &a0);
+  DYND_API expression operator-(const expression &a0);
+
+  DYND_API expression operator+(const expression &op0, const expression &op1);
+  DYND_API expression operator-(const expression &op0, const expression &op1);
+  DYND_API expression operator*(const expression &op0, const expression &op1);
+  DYND_API expression operator/(const expression &op0, const expression &op1);
+
+} // namespace dynd::nd
+} // namespace dynd
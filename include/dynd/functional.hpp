@@ -158,8 +158,13 @@ namespace nd {
     /**
      * Lifts the provided callable, broadcasting it as necessary to execute
      * across the additional dimensions in the ``lifted_types`` array.
+     *
+     * If ``properties`` includes ``associative``, the child combines values of a
+     * single type and ``identity`` leaves them unchanged, so long reductions may
+     * be split into partial results that are evaluated on several threads.
      */
-    DYND_API callable reduction(const callable &identity, const callable &child);
+    DYND_API callable reduction(const callable &identity, const callable &child,
+                                callable_property properties = none);
 
     DYND_API callable where(const callable &child);
 
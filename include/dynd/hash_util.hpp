@@ -0,0 +1,30 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+namespace detail {
+
+  /**
+   * Hashes the bytes in [begin, end) with FNV-1a, which is cheap for the
+   * short keys (field names, categories) it is used on.
+   */
+  inline size_t hash_bytes(const char *begin, const char *end) {
+    uint64_t h = UINT64_C(0xCBF29CE484222325);
+    for (; begin != end; ++begin) {
+      h = (h ^ static_cast<unsigned char>(*begin)) * UINT64_C(0x100000001B3);
+    }
+
+    return static_cast<size_t>(h ^ (h >> 32));
+  }
+
+} // namespace dynd::detail
+} // namespace dynd
@@ -0,0 +1,38 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/kernels/fused_kernel.hpp>
+
+namespace dynd {
+namespace nd {
+  namespace jit {
+
+    /**
+     * Machine code for a fused program, which evaluates it for ``count`` elements
+     * with the same signature as a strided ckernel.
+     */
+    typedef void (*strided_function)(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride,
+                                     size_t count);
+
+#ifdef DYND_LLVM
+
+    /**
+     * Compiles ``program`` to vectorized machine code with LLVM, or returns null if
+     * it has a step the JIT can't generate code for. That is currently arithmetic
+     * (``plus``, ``minus``, ``add``, ``subtract``, ``multiply`` and floating point
+     * ``divide``) on integers and floats of up to 64 bits.
+     *
+     * The code is cached by the steps and types of the program, so compiling
+     * another program that does the same thing returns the same function.
+     */
+    DYND_API strided_function compile(const functional::fused_program &program);
+
+#endif
+
+  } // namespace dynd::nd::jit
+} // namespace dynd::nd
+} // namespace dynd
@@ -5,10 +5,20 @@
 
 #pragma once
 
+#include <functional>
+#include <iosfwd>
+
 #include <dynd/array.hpp>
+#include <dynd/eval/eval_context.hpp>
 
 namespace dynd {
 
+/**
+ * Receives formatted JSON as consecutive chunks ``[begin, end)``, which are only
+ * valid for the duration of the call.
+ */
+typedef std::function<void(const char *begin, const char *end)> json_sink_t;
+
 /**
  * Formats the nd::array as JSON.
  *
@@ -18,4 +28,43 @@ namespace dynd {
  */
 DYND_API nd::array format_json(const nd::array &a, bool struct_as_list = false);
 
+/**
+ * Formats the nd::array as JSON, passing it to ``sink`` in chunks of about
+ * ``chunk_size`` bytes instead of building it in memory.
+ *
+ * If ``ndjson`` is true, the elements of the leading dimension are written one
+ * per line as newline-delimited JSON, rather than as one JSON list.
+ *
+ * If ``ectx->nthreads`` is more than one and the leading dimension has at least
+ * ``2 * ectx->grain_size`` elements, slices of it are formatted in parallel, a
+ * window at a time, and passed to the sink in order.
+ *
+ * \param a  The array to format as JSON.
+ * \param sink  The function receiving the chunks of JSON.
+ * \param struct_as_list  If true, formats struct objects as lists, otherwise
+ *                        formats them as objects/dicts.
+ * \param ndjson  If true, writes the leading dimension as one element per line.
+ * \param chunk_size  The size of the chunks passed to the sink. Raises
+ *                    std::invalid_argument if it is zero or doesn't fit in
+ *                    an intptr_t.
+ * \param ectx  The evaluation context, controlling the number of threads.
+ */
+DYND_API void write_json(const nd::array &a, const json_sink_t &sink, bool struct_as_list = false,
+                         bool ndjson = false, size_t chunk_size = 1 << 16,
+                         const eval::eval_context *ectx = &eval::default_eval_context);
+
+/**
+ * Formats the nd::array as JSON to the output stream, as ``write_json`` does to
+ * a sink.
+ */
+DYND_API void write_json(const nd::array &a, std::ostream &o, bool struct_as_list = false, bool ndjson = false,
+                         const eval::eval_context *ectx = &eval::default_eval_context);
+
+/**
+ * Formats the nd::array as JSON to the file descriptor, as ``write_json`` does
+ * to a sink. Raises std::runtime_error if writing fails.
+ */
+DYND_API void write_json_fd(const nd::array &a, int fd, bool struct_as_list = false, bool ndjson = false,
+                            const eval::eval_context *ectx = &eval::default_eval_context);
+
 } // namespace dynd
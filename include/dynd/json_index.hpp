@@ -0,0 +1,64 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <vector>
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+
+/**
+ * An index of the structure of a JSON document, built in one vectorized pass over
+ * the input before any values are parsed. It holds the position of every
+ * brace, bracket and unescaped quote that is not inside a string, in order, along
+ * with the position of the character that closes each of them.
+ *
+ * The typed parser uses it to find the end of a string or nested value without
+ * looking at the bytes in between. Its cursor only moves forward as the parser
+ * consumes the document, so each lookup is O(1) amortized.
+ *
+ * If the braces, brackets or quotes don't balance, the index is left invalid and
+ * ``skip`` always fails, leaving the parser to find and report the error.
+ */
+class DYND_API json_structural_index {
+  const char *m_begin;
+  std::vector<uint32_t> m_positions;
+  std::vector<uint32_t> m_matches;
+  size_t m_cursor;
+  bool m_valid;
+
+public:
+  json_structural_index() : m_begin(NULL), m_cursor(0), m_valid(false) {}
+
+  json_structural_index(const char *begin, const char *end) : json_structural_index() { build(begin, end); }
+
+  /**
+   * Indexes the document ``[begin, end)``, reusing the memory of any previous index.
+   */
+  void build(const char *begin, const char *end);
+
+  bool is_valid() const { return m_valid; }
+
+  /**
+   * The number of indexed characters.
+   */
+  size_t size() const { return m_positions.size(); }
+
+  /**
+   * The position of the ``i``th indexed character.
+   */
+  const char *operator[](size_t i) const { return m_begin + m_positions[i]; }
+
+  /**
+   * Given the position of an indexed opening brace, bracket or quote, returns one
+   * past the character that closes it. Returns NULL if ``pos`` isn't an indexed
+   * opening character or the index is invalid.
+   */
+  const char *skip(const char *pos);
+};
+
+} // namespace dynd
@@ -5,7 +5,12 @@
 
 #pragma once
 
+#include <iosfwd>
+#include <string>
+#include <vector>
+
 #include <dynd/array.hpp>
+#include <dynd/json_index.hpp>
 
 namespace dynd {
 namespace ndt {
@@ -51,6 +56,10 @@ DYND_API void validate_json(const char *json_begin, const char *json_end);
  * The type must have a fixed data size, so every dimension must be
  * either variable-sized or fixed-sized, not a free variable.
  *
+ * When the evaluation context allows more than one thread, long arrays whose
+ * elements are all strings, arrays or objects are split at element boundaries
+ * and parsed in parallel, unless the element type has var dims.
+ *
  * \param tp  The type to interpret the JSON data.
  * \param json_begin  The beginning of the UTF-8 buffer containing the JSON.
  * \param json_end  One past the end of the UTF-8 buffer containing the JSON.
@@ -101,4 +110,75 @@ inline nd::array parse_json(const char (&dt)[M], const char (&json)[N],
   return parse_json(ndt::type(dt, dt + M - 1), json, json + N - 1, ectx);
 }
 
+/**
+ * Parses newline-delimited JSON (NDJSON), one record per line, into a growing
+ * ``var * T`` array. The input is fed in chunks of any size, which may split a
+ * record anywhere. Records that lie within a chunk are parsed in place, and only
+ * the incomplete record at the end of a chunk is buffered, so a document of any
+ * size can be parsed while holding at most one chunk and one record of it.
+ *
+ * Blank lines are skipped. Errors are reported with the line of the input the
+ * record was on.
+ *
+ * When the evaluation context allows more than one thread, the complete records
+ * of a chunk are split among threads in groups of at least its grain size, so
+ * chunks should hold many records. Records whose type has var dims are always
+ * parsed serially.
+ */
+class DYND_API ndjson_parser {
+  struct record {
+    const char *begin;
+    const char *end;
+    size_t line;
+  };
+
+  ndt::type m_tp;
+  const eval::eval_context *m_ectx;
+  nd::array m_result;
+  size_t m_size;
+  size_t m_capacity;
+  size_t m_line;
+  std::string m_partial;
+  std::vector<record> m_records;
+  json_structural_index m_index;
+
+  void reset();
+  void add_line(const char *begin, const char *end);
+  void parse_records();
+
+public:
+  /**
+   * \param tp  The type of each record, which must have a fixed data size.
+   * \param ectx  An evaluation context.
+   */
+  ndjson_parser(const ndt::type &tp, const eval::eval_context *ectx = &eval::default_eval_context);
+
+  /**
+   * Parses the records completed by the chunk ``[begin, end)``.
+   */
+  void feed(const char *begin, const char *end);
+
+  void feed(const std::string &chunk) { feed(chunk.data(), chunk.data() + chunk.size()); }
+
+  /**
+   * The number of records parsed so far.
+   */
+  size_t size() const { return m_size; }
+
+  /**
+   * Parses the last record, if the input didn't end with a newline, and returns
+   * the records as a ``var * T`` array. The parser is then empty again, ready for
+   * another input.
+   */
+  nd::array finish();
+};
+
+/**
+ * Parses newline-delimited JSON from ``in`` into a ``var * T`` array, reading
+ * ``chunk_size`` bytes at a time. Raises std::invalid_argument if ``chunk_size``
+ * is zero or doesn't fit in a std::streamsize.
+ */
+DYND_API nd::array parse_ndjson(const ndt::type &tp, std::istream &in, size_t chunk_size = 1 << 20,
+                                const eval::eval_context *ectx = &eval::default_eval_context);
+
 } // namespace dynd
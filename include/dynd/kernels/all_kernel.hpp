@@ -20,6 +20,15 @@ namespace nd {
     {
       char *src0 = src[0];
       intptr_t src0_stride = src_stride[0];
+      if (dst_stride == 0) {
+        // Accumulating along the reduced dimension, which can stop at the first false value
+        for (size_t i = 0; i < count && *reinterpret_cast<bool1 *>(dst); ++i) {
+          *reinterpret_cast<bool1 *>(dst) = *reinterpret_cast<bool1 *>(src0);
+          src0 += src0_stride;
+        }
+        return;
+      }
+
       for (size_t i = 0; i < count; ++i) {
         *reinterpret_cast<bool1 *>(dst) = *reinterpret_cast<bool1 *>(dst) && *reinterpret_cast<bool1 *>(src0);
         dst += dst_stride;
@@ -7,6 +7,7 @@
 
 #include <dynd/kernels/apply.hpp>
 #include <dynd/kernels/base_strided_kernel.hpp>
+#include <dynd/kernels/contiguous_loop.hpp>
 
 namespace dynd {
 namespace nd {
@@ -33,6 +34,26 @@ namespace nd {
         void single(char *dst, char *const *DYND_IGNORE_UNUSED(src)) {
           *reinterpret_cast<R *>(dst) = func(apply_arg<A, I>::assign(src[I])..., apply_kwd<K, J>::get()...);
         }
+
+        void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+          // Functions of plain values without keywords get a vectorized loop over contiguous data
+          typedef std::integral_constant<bool, sizeof...(K) == 0 && nd::detail::all_contiguous_values<R, A...>::value>
+              contiguous;
+          strided(contiguous(), dst, dst_stride, src, src_stride, count);
+        }
+
+        void strided(std::true_type, char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride,
+                     size_t count) {
+          if (!strided_contiguous<R, A...>([](A... a) { return func(a...); }, dst, dst_stride, src, src_stride,
+                                           count)) {
+            base_strided_kernel<apply_function_kernel, sizeof...(A)>::strided(dst, dst_stride, src, src_stride, count);
+          }
+        }
+
+        void strided(std::false_type, char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride,
+                     size_t count) {
+          base_strided_kernel<apply_function_kernel, sizeof...(A)>::strided(dst, dst_stride, src, src_stride, count);
+        }
       };
 
       template <typename func_type, func_type func, typename... A, size_t... I, typename... K, size_t... J>
@@ -63,5 +84,10 @@ namespace nd {
                                       std::make_index_sequence<arity_of<func_type>::value - N>>;
 
   } // namespace dynd::nd::functional
+
+  template <typename func_type, func_type func, typename R, typename A, typename I, typename K, typename J>
+  struct is_stateless_kernel<functional::detail::apply_function_kernel<func_type, func, R, A, I, K, J>>
+      : std::true_type {};
+
 } // namespace dynd::nd
 } // namespace dynd
@@ -24,6 +24,7 @@
 #include <dynd/types/fixed_bytes_type.hpp>
 #include <dynd/types/fixed_string_type.hpp>
 #include <dynd/types/option_type.hpp>
+#include <dynd/types/string_view_type.hpp>
 #include <dynd/types/type_id.hpp>
 #include <map>
 
@@ -883,6 +884,9 @@ namespace nd {
 
   } // namespace dynd::nd::detail
 
+  template <typename ReturnType, typename Arg0Type, assign_error_mode ErrorMode, typename Enable>
+  struct is_stateless_kernel<detail::assignment_kernel<ReturnType, Arg0Type, ErrorMode, Enable>> : std::true_type {};
+
   /**
    * A ckernel which assigns option[S] to T.
    */
@@ -1009,11 +1013,13 @@ namespace nd {
       intptr_t m_src_element_size;
       next_unicode_codepoint_t m_next_fn;
       append_unicode_codepoint_t m_append_fn;
+      transcode_ascii_t m_transcode_ascii;
 
       assignment_kernel(string_encoding_t dst_encoding, string_encoding_t src_encoding, intptr_t src_element_size,
                         next_unicode_codepoint_t next_fn, append_unicode_codepoint_t append_fn)
           : m_dst_encoding(dst_encoding), m_src_encoding(src_encoding), m_src_element_size(src_element_size),
-            m_next_fn(next_fn), m_append_fn(append_fn) {}
+            m_next_fn(next_fn), m_append_fn(append_fn),
+            m_transcode_ascii(get_transcode_ascii_function(dst_encoding, src_encoding)) {}
 
       void single(char *dst, char *const *src) {
         dynd::string *dst_d = reinterpret_cast<dynd::string *>(dst);
@@ -1033,6 +1039,10 @@ namespace nd {
 
         dst_current = dst_begin;
         while (src_begin < src_end) {
+          m_transcode_ascii(dst_current, dst_end, src_begin, src_end);
+          if (src_begin == src_end) {
+            break;
+          }
           cp = next_fn(src_begin, src_end);
           // Append the codepoint, or increase the allocated memory as necessary
           if (cp != 0) {
@@ -1297,13 +1307,15 @@ namespace nd {
         : base_strided_kernel<assignment_kernel<ndt::fixed_string_type, ndt::fixed_string_type, ErrorMode>, 1> {
       next_unicode_codepoint_t m_next_fn;
       append_unicode_codepoint_t m_append_fn;
+      transcode_ascii_t m_transcode_ascii;
       intptr_t m_dst_data_size, m_src_data_size;
       bool m_overflow_check;
 
-      assignment_kernel(next_unicode_codepoint_t next_fn, append_unicode_codepoint_t append_fn, intptr_t dst_data_size,
-                        intptr_t src_data_size, bool overflow_check)
-          : m_next_fn(next_fn), m_append_fn(append_fn), m_dst_data_size(dst_data_size), m_src_data_size(src_data_size),
-            m_overflow_check(overflow_check) {}
+      assignment_kernel(next_unicode_codepoint_t next_fn, append_unicode_codepoint_t append_fn,
+                        transcode_ascii_t transcode_ascii, intptr_t dst_data_size, intptr_t src_data_size,
+                        bool overflow_check)
+          : m_next_fn(next_fn), m_append_fn(append_fn), m_transcode_ascii(transcode_ascii),
+            m_dst_data_size(dst_data_size), m_src_data_size(src_data_size), m_overflow_check(overflow_check) {}
 
       void single(char *dst, char *const *src) {
         char *dst_end = dst + m_dst_data_size;
@@ -1314,6 +1326,10 @@ namespace nd {
 
         char *src_copy = src[0];
         while (src_copy < src_end && dst < dst_end) {
+          m_transcode_ascii(dst, dst_end, const_cast<const char *&>(src_copy), src_end);
+          if (src_copy == src_end || dst == dst_end) {
+            break;
+          }
           cp = next_fn(const_cast<const char *&>(src_copy), src_end);
           // The fixed_string type uses null-terminated strings
           if (cp == 0) {
@@ -1359,13 +1375,14 @@ namespace nd {
         : base_strided_kernel<assignment_kernel<ndt::fixed_string_type, string, ErrorMode>, 1> {
       next_unicode_codepoint_t m_next_fn;
       append_unicode_codepoint_t m_append_fn;
+      transcode_ascii_t m_transcode_ascii;
       intptr_t m_dst_data_size;
       bool m_overflow_check;
 
-      assignment_kernel(next_unicode_codepoint_t next_fn, append_unicode_codepoint_t append_fn, intptr_t dst_data_size,
-                        bool overflow_check)
-          : m_next_fn(next_fn), m_append_fn(append_fn), m_dst_data_size(dst_data_size),
-            m_overflow_check(overflow_check) {}
+      assignment_kernel(next_unicode_codepoint_t next_fn, append_unicode_codepoint_t append_fn,
+                        transcode_ascii_t transcode_ascii, intptr_t dst_data_size, bool overflow_check)
+          : m_next_fn(next_fn), m_append_fn(append_fn), m_transcode_ascii(transcode_ascii),
+            m_dst_data_size(dst_data_size), m_overflow_check(overflow_check) {}
 
       void single(char *dst, char *const *src) {
         char *dst_end = dst + m_dst_data_size;
@@ -1377,6 +1394,10 @@ namespace nd {
         uint32_t cp;
 
         while (src_begin < src_end && dst < dst_end) {
+          m_transcode_ascii(dst, dst_end, src_begin, src_end);
+          if (src_begin == src_end || dst == dst_end) {
+            break;
+          }
           cp = next_fn(src_begin, src_end);
           append_fn(cp, dst, dst_end);
         }
@@ -1415,6 +1436,30 @@ namespace nd {
       }
     };
 
+    /**
+     * Assigns a view of the source string, copying its bytes into the memory block
+     * of the destination's arrmeta unless they are already held by that block.
+     */
+    template <typename Arg0Type>
+    struct assignment_kernel<string_view, Arg0Type, assign_error_nocheck>
+        : base_strided_kernel<assignment_kernel<string_view, Arg0Type, assign_error_nocheck>, 1> {
+      memory_block m_dst_memblock;
+      bool m_shares_memblock;
+
+      assignment_kernel(const memory_block &dst_memblock, bool shares_memblock)
+          : m_dst_memblock(dst_memblock), m_shares_memblock(shares_memblock) {}
+
+      void single(char *dst, char *const *src) {
+        string_view s = *reinterpret_cast<const Arg0Type *>(src[0]);
+        if (!m_shares_memblock && !s.empty()) {
+          char *begin = m_dst_memblock->alloc(s.size());
+          DYND_MEMCPY(begin, s.data(), s.size());
+          s = string_view(begin, s.size());
+        }
+        *reinterpret_cast<string_view *>(dst) = s;
+      }
+    };
+
     template <assign_error_mode ErrorMode>
     struct assignment_kernel<ndt::type, string, ErrorMode>
         : base_strided_kernel<assignment_kernel<ndt::type, string, ErrorMode>, 1> {
@@ -9,27 +9,29 @@
 #include <dynd/callable.hpp>
 #include <dynd/kernels/base_kernel.hpp>
 #include <dynd/kernels/convert_kernel.hpp>
+#include <dynd/kernels/scratch_arena.hpp>
 
 namespace dynd {
 namespace nd {
   namespace functional {
 
     /**
-     * A kernel for chaining two other kernels, using temporary buffers
-     * dynamically allocated on the heap.
+     * A kernel for chaining two other kernels, using a temporary buffer drawn
+     * from the calling thread's scratch arena.
      */
     // All methods are inlined, so this does not need to be declared DYND_API.
     struct compose_kernel : base_strided_kernel<compose_kernel, 1> {
       intptr_t second_offset; // The offset to the second child kernel
       ndt::type buffer_tp;
       arrmeta_holder buffer_arrmeta;
-      std::vector<intptr_t> buffer_shape;
+      // The number of elements buffered at a time
+      size_t chunk_size;
 
       compose_kernel(const ndt::type &buffer_tp) : buffer_tp(buffer_tp)
       {
         arrmeta_holder(this->buffer_tp).swap(buffer_arrmeta);
         buffer_arrmeta.arrmeta_default_construct(true);
-        buffer_shape.push_back(DYND_BUFFER_CHUNK_SIZE);
+        chunk_size = get_buffer_chunk_size(buffer_tp.get_data_size());
       }
 
       ~compose_kernel()
@@ -40,11 +42,33 @@ namespace nd {
         get_child(second_offset)->destroy();
       }
 
+      /** Zeroes buffer elements, if the first child expects them zeroed */
+      void clear_buffer(char *data, size_t count)
+      {
+        if (buffer_tp.get_flags() & (type_flag_blockref | type_flag_zeroinit | type_flag_destructor)) {
+          memset(data, 0, count * buffer_tp.get_data_size());
+        }
+      }
+
+      /**
+       * Destroys the values the first child wrote to buffer elements, and resets
+       * the memory blocks of the buffer arrmeta so the next chunk reuses their memory
+       */
+      void release_buffer(char *data, size_t count)
+      {
+        if (buffer_tp.get_flags() & type_flag_destructor) {
+          buffer_tp.extended()->data_destruct_strided(buffer_arrmeta.get(), data, buffer_tp.get_data_size(), count);
+        }
+        if (buffer_tp.get_flags() & type_flag_blockref) {
+          buffer_tp.extended()->arrmeta_reset_buffers(buffer_arrmeta.get());
+        }
+      }
+
       void single(char *dst, char *const *src)
       {
-        // Allocate a temporary buffer on the heap
-        array buffer = empty(buffer_tp);
-        char *buffer_data = buffer.data();
+        scratch_frame frame;
+        char *buffer_data = frame.allocate(buffer_tp.get_data_size());
+        clear_buffer(buffer_data, 1);
 
         kernel_prefix *first = get_child();
         kernel_single_t first_func = first->get_function<kernel_single_t>();
@@ -52,16 +76,23 @@ namespace nd {
         kernel_prefix *second = get_child(second_offset);
         kernel_single_t second_func = second->get_function<kernel_single_t>();
 
-        first_func(first, buffer_data, src);
-        second_func(second, dst, &buffer_data);
+        try {
+          first_func(first, buffer_data, src);
+          second_func(second, dst, &buffer_data);
+        }
+        catch (...) {
+          release_buffer(buffer_data, 1);
+          throw;
+        }
+        release_buffer(buffer_data, 1);
       }
 
       void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count)
       {
-        // Allocate a temporary buffer on the heap
-        array buffer = empty(buffer_shape[0], buffer_tp);
-        char *buffer_data = buffer.data();
-        intptr_t buffer_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(buffer.get()->metadata())->stride;
+        // The buffer is reused for every chunk
+        scratch_frame frame;
+        intptr_t buffer_stride = buffer_tp.get_data_size();
+        char *buffer_data = frame.allocate(std::min(count, chunk_size) * buffer_stride);
 
         kernel_prefix *first = get_child();
         kernel_strided_t first_func = first->get_function<kernel_strided_t>();
@@ -72,18 +103,22 @@ namespace nd {
         char *src0 = src[0];
         intptr_t src0_stride = src_stride[0];
 
-        size_t chunk_size = std::min(count, static_cast<size_t>(DYND_BUFFER_CHUNK_SIZE));
-        first_func(first, buffer_data, buffer_stride, &src0, src_stride, chunk_size);
-        second_func(second, dst, dst_stride, &buffer_data, &buffer_stride, chunk_size);
-        count -= chunk_size;
         while (count) {
-          src0 += chunk_size * src0_stride;
-          dst += chunk_size * dst_stride;
-          reset_strided_buffer_array(buffer);
-          chunk_size = std::min(count, static_cast<size_t>(DYND_BUFFER_CHUNK_SIZE));
-          first_func(first, buffer_data, buffer_stride, &src0, src_stride, chunk_size);
-          second_func(second, dst, dst_stride, &buffer_data, &buffer_stride, chunk_size);
-          count -= chunk_size;
+          size_t n = std::min(count, chunk_size);
+          clear_buffer(buffer_data, n);
+          try {
+            first_func(first, buffer_data, buffer_stride, &src0, src_stride, n);
+            second_func(second, dst, dst_stride, &buffer_data, &buffer_stride, n);
+          }
+          catch (...) {
+            release_buffer(buffer_data, n);
+            throw;
+          }
+          release_buffer(buffer_data, n);
+
+          src0 += n * src0_stride;
+          dst += n * dst_stride;
+          count -= n;
         }
       }
     };
@@ -0,0 +1,423 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+#include <dynd/bool1.hpp>
+#include <dynd/config.hpp>
+#include <dynd/type_sequence.hpp>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace dynd {
+namespace nd {
+  namespace detail {
+
+    /**
+     * Types whose values can be loaded and stored directly in a contiguous loop.
+     */
+    template <typename T>
+    struct is_contiguous_value
+        : std::integral_constant<bool, std::is_arithmetic<T>::value || std::is_same<T, bool1>::value> {};
+
+    template <typename... T>
+    struct all_contiguous_values;
+
+    template <>
+    struct all_contiguous_values<> : std::true_type {};
+
+    template <typename T0, typename... T>
+    struct all_contiguous_values<T0, T...>
+        : std::integral_constant<bool, is_contiguous_value<T0>::value && all_contiguous_values<T...>::value> {};
+
+    enum simd_level { simd_level_default, simd_level_avx2, simd_level_avx512 };
+
+    /**
+     * Returns the widest instruction set the contiguous loops were compiled for and
+     * the processor supports.
+     */
+    inline simd_level get_simd_level() {
+#ifdef DYND_TARGET_AVX2
+      static const simd_level level = __builtin_cpu_supports("avx512f")
+                                          ? simd_level_avx512
+                                          : (__builtin_cpu_supports("avx2") ? simd_level_avx2 : simd_level_default);
+      return level;
+#else
+      return simd_level_default;
+#endif
+    }
+
+    /**
+     * Returns the index of the lowest set bit of ``x``, which must not be zero.
+     * Used to find the first matching lane in a vector compare mask, or the
+     * first match in a 64-bit mask of bytes.
+     */
+    inline size_t count_trailing_zeros(uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+      return static_cast<size_t>(__builtin_ctz(x));
+#elif defined(_MSC_VER)
+      unsigned long i;
+      _BitScanForward(&i, x);
+      return i;
+#else
+      size_t i = 0;
+      for (; (x & 1) == 0; x >>= 1) {
+        ++i;
+      }
+      return i;
+#endif
+    }
+
+    inline size_t count_trailing_zeros(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+      return static_cast<size_t>(__builtin_ctzll(x));
+#elif defined(_MSC_VER) && defined(_WIN64)
+      unsigned long i;
+      _BitScanForward64(&i, x);
+      return i;
+#else
+      uint32_t lo = static_cast<uint32_t>(x);
+      return (lo != 0) ? count_trailing_zeros(lo) : 32 + count_trailing_zeros(static_cast<uint32_t>(x >> 32));
+#endif
+    }
+
+    /**
+     * An argument of a contiguous loop, either an array with unit stride or, when
+     * broadcast, a single value.
+     */
+    template <typename T, bool Broadcast>
+    struct contiguous_arg;
+
+    template <typename T>
+    struct contiguous_arg<T, false> {
+      const T *data;
+
+      contiguous_arg(const char *data) : data(reinterpret_cast<const T *>(data)) {}
+
+      const T &operator[](size_t i) const { return data[i]; }
+    };
+
+    template <typename T>
+    struct contiguous_arg<T, true> {
+      T value;
+
+      contiguous_arg(const char *data) : value(*reinterpret_cast<const T *>(data)) {}
+
+      const T &operator[](size_t DYND_UNUSED(i)) const { return value; }
+    };
+
+    template <typename ReturnType, typename ArgSequence, typename BroadcastSequence>
+    struct contiguous_loop;
+
+    template <typename ReturnType, typename... ArgTypes, bool... Broadcast>
+    struct contiguous_loop<ReturnType, type_sequence<ArgTypes...>, std::integer_sequence<bool, Broadcast...>> {
+      // The same loop is compiled once per instruction set, leaving the vectorization to the compiler
+      template <typename FuncType>
+      static void run_default(FuncType func, ReturnType *dst, contiguous_arg<ArgTypes, Broadcast>... src,
+                              size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+          dst[i] = func(src[i]...);
+        }
+      }
+
+#ifdef DYND_TARGET_AVX2
+      template <typename FuncType>
+      DYND_TARGET_AVX2 static void run_avx2(FuncType func, ReturnType *dst, contiguous_arg<ArgTypes, Broadcast>... src,
+                                            size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+          dst[i] = func(src[i]...);
+        }
+      }
+
+      template <typename FuncType>
+      DYND_TARGET_AVX512 static void run_avx512(FuncType func, ReturnType *dst,
+                                                contiguous_arg<ArgTypes, Broadcast>... src, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+          dst[i] = func(src[i]...);
+        }
+      }
+#endif
+
+      template <typename FuncType, size_t... I>
+      static void run(FuncType func, char *dst, char *const *src, size_t count, std::index_sequence<I...>) {
+        switch (get_simd_level()) {
+#ifdef DYND_TARGET_AVX2
+        case simd_level_avx512:
+          run_avx512(func, reinterpret_cast<ReturnType *>(dst), contiguous_arg<ArgTypes, Broadcast>(src[I])..., count);
+          break;
+        case simd_level_avx2:
+          run_avx2(func, reinterpret_cast<ReturnType *>(dst), contiguous_arg<ArgTypes, Broadcast>(src[I])..., count);
+          break;
+#endif
+        default:
+          run_default(func, reinterpret_cast<ReturnType *>(dst), contiguous_arg<ArgTypes, Broadcast>(src[I])...,
+                      count);
+          break;
+        }
+      }
+
+      template <typename FuncType>
+      static void run(FuncType func, char *dst, char *const *src, size_t count) {
+        run(func, dst, src, count, std::make_index_sequence<sizeof...(ArgTypes)>());
+      }
+    };
+
+    template <size_t I>
+    using not_broadcast = std::false_type;
+
+    template <typename ReturnType, typename ArgSequence,
+              typename IndexSequence = std::make_index_sequence<ArgSequence::size()>>
+    struct contiguous_dispatch;
+
+    template <typename ReturnType, typename... ArgTypes, size_t... I>
+    struct contiguous_dispatch<ReturnType, type_sequence<ArgTypes...>, std::index_sequence<I...>> {
+      template <typename FuncType>
+      static bool run(FuncType func, char *dst, char *const *src, size_t count, unsigned broadcast) {
+        if (broadcast == 0) {
+          contiguous_loop<ReturnType, type_sequence<ArgTypes...>,
+                          std::integer_sequence<bool, not_broadcast<I>::value...>>::run(func, dst, src, count);
+          return true;
+        }
+
+        return false;
+      }
+    };
+
+    // Binary operations also get loops for either argument being a scalar
+    template <typename ReturnType, typename Arg0Type, typename Arg1Type>
+    struct contiguous_dispatch<ReturnType, type_sequence<Arg0Type, Arg1Type>, std::index_sequence<0, 1>> {
+      template <typename FuncType>
+      static bool run(FuncType func, char *dst, char *const *src, size_t count, unsigned broadcast) {
+        typedef type_sequence<Arg0Type, Arg1Type> arg_sequence;
+
+        switch (broadcast) {
+        case 0:
+          contiguous_loop<ReturnType, arg_sequence, std::integer_sequence<bool, false, false>>::run(func, dst, src,
+                                                                                                    count);
+          return true;
+        case 1:
+          contiguous_loop<ReturnType, arg_sequence, std::integer_sequence<bool, true, false>>::run(func, dst, src,
+                                                                                                   count);
+          return true;
+        case 2:
+          contiguous_loop<ReturnType, arg_sequence, std::integer_sequence<bool, false, true>>::run(func, dst, src,
+                                                                                                   count);
+          return true;
+        default:
+          return false;
+        }
+      }
+    };
+
+    template <typename ReturnType, typename... ArgTypes, typename FuncType>
+    bool strided_contiguous(std::true_type, FuncType func, char *dst, intptr_t dst_stride, char *const *src,
+                            const intptr_t *src_stride, size_t count) {
+      if (dst_stride != sizeof(ReturnType)) {
+        return false;
+      }
+
+      const size_t arg_size[sizeof...(ArgTypes)] = {sizeof(ArgTypes)...};
+      unsigned broadcast = 0;
+      for (size_t i = 0; i < sizeof...(ArgTypes); ++i) {
+        if (src_stride[i] == 0) {
+          broadcast |= 1u << i;
+        } else if (src_stride[i] != static_cast<intptr_t>(arg_size[i])) {
+          return false;
+        }
+      }
+
+      return contiguous_dispatch<ReturnType, type_sequence<ArgTypes...>>::run(func, dst, src, count, broadcast);
+    }
+
+    template <typename ReturnType, typename... ArgTypes, typename FuncType>
+    bool strided_contiguous(std::false_type, FuncType DYND_UNUSED(func), char *DYND_UNUSED(dst),
+                            intptr_t DYND_UNUSED(dst_stride), char *const *DYND_UNUSED(src),
+                            const intptr_t *DYND_UNUSED(src_stride), size_t DYND_UNUSED(count)) {
+      return false;
+    }
+
+    /**
+     * An argument of a reduction loop with an arbitrary stride.
+     */
+    template <typename T>
+    struct strided_arg {
+      const char *data;
+      intptr_t stride;
+
+      strided_arg(const char *data, intptr_t stride) : data(data), stride(stride) {}
+
+      const T &operator[](size_t i) const { return *reinterpret_cast<const T *>(data + i * stride); }
+    };
+
+    template <typename T>
+    struct pairwise_sum {
+      // Runs no longer than this are summed directly, longer ones are split in half
+      static const size_t block_size = 128;
+
+      /**
+       * Sums ``count >= 1`` values with eight interleaved partial sums, which the
+       * compiler can keep in vector registers.
+       */
+      template <typename ArgType>
+      static T block(ArgType src, size_t count) {
+        if (count < 8) {
+          T res = src[0];
+          for (size_t i = 1; i < count; ++i) {
+            res = static_cast<T>(res + src[i]);
+          }
+          return res;
+        }
+
+        T r[8];
+        for (size_t j = 0; j < 8; ++j) {
+          r[j] = src[j];
+        }
+        size_t i = 8;
+        for (; i + 8 <= count; i += 8) {
+          for (size_t j = 0; j < 8; ++j) {
+            r[j] = static_cast<T>(r[j] + src[i + j]);
+          }
+        }
+
+        T res = static_cast<T>(static_cast<T>(static_cast<T>(r[0] + r[1]) + static_cast<T>(r[2] + r[3])) +
+                               static_cast<T>(static_cast<T>(r[4] + r[5]) + static_cast<T>(r[6] + r[7])));
+        for (; i < count; ++i) {
+          res = static_cast<T>(res + src[i]);
+        }
+        return res;
+      }
+
+      static T block_default(const char *src, size_t count) { return block(contiguous_arg<T, false>(src), count); }
+
+#ifdef DYND_TARGET_AVX2
+      DYND_TARGET_AVX2 static T block_avx2(const char *src, size_t count) {
+        return block(contiguous_arg<T, false>(src), count);
+      }
+
+      DYND_TARGET_AVX512 static T block_avx512(const char *src, size_t count) {
+        return block(contiguous_arg<T, false>(src), count);
+      }
+#endif
+
+      static T run(const char *src, intptr_t src_stride, size_t count) {
+        if (count <= block_size) {
+          if (src_stride != static_cast<intptr_t>(sizeof(T))) {
+            return block(strided_arg<T>(src, src_stride), count);
+          }
+
+          switch (get_simd_level()) {
+#ifdef DYND_TARGET_AVX2
+          case simd_level_avx512:
+            return block_avx512(src, count);
+          case simd_level_avx2:
+            return block_avx2(src, count);
+#endif
+          default:
+            return block_default(src, count);
+          }
+        }
+
+        // Split on a multiple of the interleave width, so that every block but the last is a whole number of rows
+        size_t half = count / 2;
+        half -= half % 8;
+        return static_cast<T>(run(src, src_stride, half) + run(src + half * src_stride, src_stride, count - half));
+      }
+    };
+
+    template <typename T>
+    struct accumulate_loop {
+      template <typename FuncType, typename ArgType>
+      static T run(FuncType func, T acc, ArgType src, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+          acc = func(acc, src[i]);
+        }
+        return acc;
+      }
+
+#ifdef DYND_TARGET_AVX2
+      template <typename FuncType>
+      DYND_TARGET_AVX2 static T run_avx2(FuncType func, T acc, contiguous_arg<T, false> src, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+          acc = func(acc, src[i]);
+        }
+        return acc;
+      }
+
+      template <typename FuncType>
+      DYND_TARGET_AVX512 static T run_avx512(FuncType func, T acc, contiguous_arg<T, false> src, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+          acc = func(acc, src[i]);
+        }
+        return acc;
+      }
+#endif
+    };
+
+    template <typename T, typename FuncType>
+    T strided_accumulate(std::true_type, FuncType func, T acc, const char *src, intptr_t src_stride, size_t count) {
+      if (src_stride != static_cast<intptr_t>(sizeof(T))) {
+        return accumulate_loop<T>::run(func, acc, strided_arg<T>(src, src_stride), count);
+      }
+
+      switch (get_simd_level()) {
+#ifdef DYND_TARGET_AVX2
+      case simd_level_avx512:
+        return accumulate_loop<T>::run_avx512(func, acc, contiguous_arg<T, false>(src), count);
+      case simd_level_avx2:
+        return accumulate_loop<T>::run_avx2(func, acc, contiguous_arg<T, false>(src), count);
+#endif
+      default:
+        return accumulate_loop<T>::run(func, acc, contiguous_arg<T, false>(src), count);
+      }
+    }
+
+    template <typename T, typename FuncType>
+    T strided_accumulate(std::false_type, FuncType func, T acc, const char *src, intptr_t src_stride, size_t count) {
+      return accumulate_loop<T>::run(func, acc, strided_arg<T>(src, src_stride), count);
+    }
+
+  } // namespace dynd::nd::detail
+
+  /**
+   * Evaluates ``dst[i] = func(src0[i], ...)`` in a tight loop, vectorized for the
+   * widest instruction set available at runtime, if every stride is either the
+   * size of its element or, for the arguments, zero. Returns false without doing
+   * anything otherwise, or if any of the types isn't a plain value, in which case
+   * the caller should fall back to its generic strided loop.
+   */
+  template <typename ReturnType, typename... ArgTypes, typename FuncType>
+  bool strided_contiguous(FuncType func, char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride,
+                          size_t count) {
+    return detail::strided_contiguous<ReturnType, ArgTypes...>(
+        detail::all_contiguous_values<ReturnType, ArgTypes...>(), func, dst, dst_stride, src, src_stride, count);
+  }
+
+  /**
+   * Returns the sum of ``count >= 1`` values at ``src``, added pairwise in blocks
+   * so that the rounding error grows with the logarithm of ``count`` rather than
+   * linearly. Blocks with a unit stride are vectorized.
+   */
+  template <typename T>
+  T pairwise_sum(const char *src, intptr_t src_stride, size_t count) {
+    return detail::pairwise_sum<T>::run(src, src_stride, count);
+  }
+
+  /**
+   * Folds ``count`` values at ``src`` into ``acc`` with ``acc = func(acc, value)``,
+   * in a loop that is vectorized when the stride is the size of the value and
+   * the value is plain.
+   */
+  template <typename T, typename FuncType>
+  T strided_accumulate(FuncType func, T acc, const char *src, intptr_t src_stride, size_t count) {
+    return detail::strided_accumulate(detail::is_contiguous_value<T>(), func, acc, src, src_stride, count);
+  }
+
+} // namespace dynd::nd
+} // namespace dynd
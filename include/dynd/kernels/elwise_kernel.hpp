@@ -5,8 +5,16 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
 #include <dynd/callable.hpp>
+#include <dynd/eval/eval_context.hpp>
 #include <dynd/kernels/base_kernel.hpp>
+#include <dynd/shape_tools.hpp>
+#include <dynd/thread_pool.hpp>
 
 namespace dynd {
 namespace nd {
@@ -21,6 +29,12 @@ namespace nd {
     template <type_id_t DstTypeID, type_id_t SrcTypeID, typename TraitsType, size_t N>
     struct elwise_kernel;
 
+    /**
+     * When ``inner_size`` is nonzero, the child may be evaluated concurrently over
+     * disjoint parts of the dimension, each of which holds ``inner_size`` elements
+     * per index. Whether that happens is decided at evaluation time from the
+     * thread count and grain size of the default eval context.
+     */
     template <typename TraitsType, size_t N>
     struct elwise_kernel<fixed_dim_id, fixed_dim_id, TraitsType, N>
         : base_strided_kernel<elwise_kernel<fixed_dim_id, fixed_dim_id, TraitsType, N>, N>, TraitsType {
@@ -28,22 +42,243 @@ namespace nd {
 
       typedef elwise_kernel self_type;
 
+      // The most nested loops optimize_loops() looks at
+      static const size_t max_loops = 16;
+
       intptr_t m_size;
       intptr_t m_dst_stride, m_src_stride[N];
-
-      elwise_kernel(char *data, intptr_t size, intptr_t dst_stride, const intptr_t *src_stride)
-          : TraitsType(data), m_size(size), m_dst_stride(dst_stride) {
+      size_t m_inner_size;
+      bool m_innermost;
+      // The offset of the kernel called for each index, which is further than the
+      // child once the loop of the child has been merged into this one
+      intptr_t m_child_offset;
+      // When nonzero, this loop and the loop of the child are walked in square
+      // tiles of this many indices a side
+      intptr_t m_tile_size;
+
+      elwise_kernel(char *data, intptr_t size, intptr_t dst_stride, const intptr_t *src_stride, size_t inner_size = 0,
+                    bool innermost = true)
+          : TraitsType(data), m_size(size), m_dst_stride(dst_stride), m_inner_size(inner_size),
+            m_innermost(innermost), m_child_offset(sizeof(self_type)), m_tile_size(0) {
         memcpy(m_src_stride, src_stride, sizeof(m_src_stride));
       }
 
       ~elwise_kernel() { this->get_child()->destroy(); }
 
       void single(char *dst, char *const *src) {
-        kernel_prefix *child = this->get_child();
+        if (m_tile_size != 0) {
+          single_tiled(dst, src);
+          return;
+        }
+
+        kernel_prefix *child = this->get_child(m_child_offset);
         kernel_strided_t opchild = child->get_function<kernel_strided_t>();
 
+        if (m_inner_size != 0 && eval::default_eval_context.nthreads > 1 && !in_parallel_region()) {
+          const eval::eval_context &ectx = eval::default_eval_context;
+
+          // Split into chunks of at least grain_size elements, leaving an outer dimension that is too short to
+          // occupy every thread to the dimensions inside it
+          size_t size = static_cast<size_t>(m_size);
+          size_t grain = std::max(ectx.grain_size / m_inner_size, static_cast<size_t>(1));
+          size_t nchunks = size / grain;
+          if (nchunks >= 2 && (nchunks >= ectx.nthreads || m_innermost)) {
+            parallel_for(ectx.nthreads, size, grain, [&](size_t begin, size_t end) {
+              char *chunk_dst = dst + static_cast<intptr_t>(begin) * m_dst_stride;
+              char *chunk_src[N];
+              for (size_t i = 0; i < N; ++i) {
+                chunk_src[i] = src[i] + static_cast<intptr_t>(begin) * m_src_stride[i];
+              }
+
+              opchild(child, chunk_dst, m_dst_stride, chunk_src, m_src_stride, end - begin);
+            });
+            return;
+          }
+        }
+
         opchild(child, dst, m_dst_stride, src, m_src_stride, m_size);
       }
+
+      /**
+       * Evaluates this loop and the loop of the child one tile at a time, calling
+       * what the child calls for each row of a tile. The rows of tiles may be
+       * evaluated concurrently like the indices in ``single()``.
+       */
+      void single_tiled(char *dst, char *const *src) {
+        self_type *inner = reinterpret_cast<self_type *>(this->get_child(m_child_offset));
+        kernel_prefix *child = inner->get_child(inner->m_child_offset);
+        kernel_strided_t opchild = child->get_function<kernel_strided_t>();
+
+        auto tile_rows = [&](size_t begin, size_t end) {
+          char *tile_src[N];
+          for (intptr_t i0 = static_cast<intptr_t>(begin) * m_tile_size,
+                        i_end = std::min(static_cast<intptr_t>(end) * m_tile_size, m_size);
+               i0 < i_end; i0 += m_tile_size) {
+            intptr_t i1 = std::min(i0 + m_tile_size, i_end);
+            for (intptr_t j0 = 0; j0 < inner->m_size; j0 += m_tile_size) {
+              size_t count = static_cast<size_t>(std::min(m_tile_size, inner->m_size - j0));
+              for (intptr_t i = i0; i < i1; ++i) {
+                char *tile_dst = dst + i * m_dst_stride + j0 * inner->m_dst_stride;
+                for (size_t k = 0; k < N; ++k) {
+                  tile_src[k] = src[k] + i * m_src_stride[k] + j0 * inner->m_src_stride[k];
+                }
+
+                opchild(child, tile_dst, inner->m_dst_stride, tile_src, inner->m_src_stride, count);
+              }
+            }
+          }
+        };
+
+        size_t ntiles = static_cast<size_t>((m_size + m_tile_size - 1) / m_tile_size);
+        if (m_inner_size != 0 && eval::default_eval_context.nthreads > 1 && !in_parallel_region()) {
+          const eval::eval_context &ectx = eval::default_eval_context;
+
+          size_t grain = std::max(ectx.grain_size / (m_inner_size * static_cast<size_t>(m_tile_size)),
+                                  static_cast<size_t>(1));
+          if (ntiles / grain >= 2) {
+            parallel_for(ectx.nthreads, ntiles, grain, tile_rows);
+            return;
+          }
+        }
+
+        tile_rows(0, ntiles);
+      }
+
+      /**
+       * Optimizes the loops of this kernel and of the elwise kernels nested in it,
+       * which must already have been instantiated. The loops are reordered so that
+       * the innermost has the smallest strides, then each loop that steps over the
+       * whole of the loop inside it is merged with it, so that a contiguous array
+       * is walked by one loop however many dimensions it has. The two innermost
+       * loops left are tiled if the operands disagree on their order.
+       */
+      void optimize_loops() {
+        // A kernel with state expects its indices in order, and a result that is
+        // broadcast must get the value of the last one
+        if (!TraitsType::parallel) {
+          return;
+        }
+
+        self_type *loops[max_loops];
+        size_t nloops = 0;
+        for (self_type *self = this;;) {
+          if (self->m_dst_stride == 0 && self->m_size != 1) {
+            return;
+          }
+          self->m_tile_size = 0;
+          loops[nloops++] = self;
+
+          kernel_prefix *child = self->get_child(self->m_child_offset);
+          if (nloops == max_loops || child->get_function<kernel_strided_t>() != &self_type::strided_wrapper) {
+            break;
+          }
+          self = reinterpret_cast<self_type *>(child);
+        }
+        if (nloops < 2) {
+          return;
+        }
+
+        intptr_t size[max_loops], stride[N + 1][max_loops];
+        size_t inner_size = std::max(loops[nloops - 1]->m_inner_size, static_cast<size_t>(1));
+        for (size_t j = 0; j < nloops; ++j) {
+          // A loop with one index never applies its strides, so they don't affect the order
+          size[j] = loops[j]->m_size;
+          stride[0][j] = (size[j] == 1) ? 0 : loops[j]->m_dst_stride;
+          for (size_t i = 0; i < N; ++i) {
+            stride[i + 1][j] = (size[j] == 1) ? 0 : loops[j]->m_src_stride[i];
+          }
+        }
+
+        // The axes ordered from the smallest strides to the largest, which for a
+        // C order array is the reverse of the loops
+        const intptr_t *operstrides[N + 1];
+        for (size_t i = 0; i <= N; ++i) {
+          operstrides[i] = stride[i];
+        }
+        int axis_perm[max_loops];
+        multistrides_to_axis_perm(nloops, static_cast<int>(N + 1), operstrides, axis_perm);
+
+        for (size_t j = nloops; j-- > 0;) {
+          int axis = axis_perm[nloops - 1 - j];
+          self_type *self = loops[j];
+          self->m_size = size[axis];
+          self->m_dst_stride = stride[0][axis];
+          for (size_t i = 0; i < N; ++i) {
+            self->m_src_stride[i] = stride[i + 1][axis];
+          }
+          if (self->m_inner_size != 0) {
+            self->m_inner_size = inner_size;
+          }
+          inner_size *= static_cast<size_t>(size[axis]);
+        }
+
+        for (size_t j = nloops - 1; j-- > 0;) {
+          self_type *outer = loops[j];
+          self_type *inner = loops[j + 1];
+          if (inner->m_size != 1) {
+            bool contiguous = outer->m_size == 1 || outer->m_dst_stride == inner->m_size * inner->m_dst_stride;
+            for (size_t i = 0; i < N; ++i) {
+              contiguous = contiguous && (outer->m_size == 1 ||
+                                          outer->m_src_stride[i] == inner->m_size * inner->m_src_stride[i]);
+            }
+            if (!contiguous) {
+              continue;
+            }
+
+            outer->m_size *= inner->m_size;
+            outer->m_dst_stride = inner->m_dst_stride;
+            memcpy(outer->m_src_stride, inner->m_src_stride, sizeof(m_src_stride));
+          }
+
+          // Call what the inner kernel calls, leaving the inner kernel in place to be destroyed
+          if (outer->m_inner_size != 0) {
+            outer->m_inner_size = inner->m_inner_size;
+          }
+          outer->m_innermost = inner->m_innermost;
+          outer->m_child_offset =
+              reinterpret_cast<char *>(inner) - reinterpret_cast<char *>(outer) + inner->m_child_offset;
+
+          std::copy(loops + j + 2, loops + nloops, loops + j + 1);
+          --nloops;
+        }
+
+        if (nloops >= 2) {
+          loops[nloops - 2]->choose_tile_size();
+        }
+      }
+
+      /**
+       * Tiles this loop and the loop of the child if some operands are walked
+       * along the one and others along the other, as in a transpose. Walking the
+       * latter with a large stride would touch a new cache line, and often a new
+       * page, for every element.
+       */
+      void choose_tile_size() {
+        const self_type *inner = reinterpret_cast<const self_type *>(this->get_child(m_child_offset));
+
+        // The operands that are contiguous along the inner loop and along this one
+        bool inner_order = false, outer_order = false;
+        intptr_t data_size = std::numeric_limits<intptr_t>::max();
+        for (size_t i = 0; i <= N; ++i) {
+          intptr_t outer_stride = std::abs((i == 0) ? m_dst_stride : m_src_stride[i - 1]);
+          intptr_t inner_stride = std::abs((i == 0) ? inner->m_dst_stride : inner->m_src_stride[i - 1]);
+          if (outer_stride != 0 && inner_stride != 0) {
+            inner_order = inner_order || inner_stride < outer_stride;
+            outer_order = outer_order || outer_stride < inner_stride;
+            data_size = std::min(data_size, std::min(inner_stride, outer_stride));
+          }
+        }
+        if (!inner_order || !outer_order) {
+          return;
+        }
+
+        // Tiles whose elements of one operand fit in DYND_TILE_BYTES
+        intptr_t tile_size = static_cast<intptr_t>(std::sqrt(static_cast<double>(DYND_TILE_BYTES / data_size)));
+        tile_size = std::max(tile_size, static_cast<intptr_t>(8));
+        if (m_size > tile_size && inner->m_size > tile_size) {
+          m_tile_size = tile_size;
+        }
+      }
     };
 
     template <typename TraitsType>
@@ -54,7 +289,8 @@ namespace nd {
       intptr_t m_size;
       intptr_t m_dst_stride;
 
-      elwise_kernel(char *data, intptr_t size, intptr_t dst_stride, const intptr_t *DYND_UNUSED(src_stride))
+      elwise_kernel(char *data, intptr_t size, intptr_t dst_stride, const intptr_t *DYND_UNUSED(src_stride),
+                    size_t DYND_UNUSED(inner_size) = 0, bool DYND_UNUSED(innermost) = true)
           : TraitsType(data), m_size(size), m_dst_stride(dst_stride) {}
 
       ~elwise_kernel() { this->get_child()->destroy(); }
@@ -65,6 +301,8 @@ namespace nd {
         opchild(child, dst, m_dst_stride, src, NULL, m_size);
       }
 
+      void optimize_loops() {}
+
       void strided(char *dst, intptr_t dst_stride, char *const *DYND_UNUSED(src),
                    const intptr_t *DYND_UNUSED(src_stride), size_t count) {
         kernel_prefix *child = this->get_child();
@@ -361,5 +599,11 @@ namespace nd {
         : elwise_kernel<var_dim_id, fixed_dim_id, TraitsType, N> {};
 
   } // namespace dynd::nd::functional
+
+  // The loops hold only strides and sizes, apart from the index kept by the traits of a stateful child
+  template <type_id_t DstTypeID, type_id_t SrcTypeID, typename TraitsType, size_t N>
+  struct is_stateless_kernel<functional::elwise_kernel<DstTypeID, SrcTypeID, TraitsType, N>>
+      : std::integral_constant<bool, TraitsType::parallel> {};
+
 } // namespace dynd::nd
 } // namespace dynd
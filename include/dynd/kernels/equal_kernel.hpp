@@ -6,6 +6,7 @@
 #pragma once
 
 #include <dynd/kernels/base_kernel.hpp>
+#include <dynd/kernels/contiguous_loop.hpp>
 #include <dynd/types/callable_type.hpp>
 
 namespace dynd {
@@ -19,6 +20,14 @@ namespace nd {
       *reinterpret_cast<bool1 *>(dst) = static_cast<T>(*reinterpret_cast<Arg0Type *>(src[0])) ==
                                         static_cast<T>(*reinterpret_cast<Arg1Type *>(src[1]));
     }
+
+    void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+      if (!strided_contiguous<bool1, Arg0Type, Arg1Type>(
+              [](const Arg0Type &x, const Arg1Type &y) { return static_cast<T>(x) == static_cast<T>(y); },
+              dst, dst_stride, src, src_stride, count)) {
+        base_strided_kernel<equal_kernel, 2>::strided(dst, dst_stride, src, src_stride, count);
+      }
+    }
   };
 
   template <typename Arg0Type>
@@ -26,6 +35,13 @@ namespace nd {
     void single(char *dst, char *const *src) {
       *reinterpret_cast<bool1 *>(dst) = *reinterpret_cast<Arg0Type *>(src[0]) == *reinterpret_cast<Arg0Type *>(src[1]);
     }
+
+    void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+      if (!strided_contiguous<bool1, Arg0Type, Arg0Type>([](const Arg0Type &x, const Arg0Type &y) { return x == y; },
+                                                         dst, dst_stride, src, src_stride, count)) {
+        base_strided_kernel<equal_kernel, 2>::strided(dst, dst_stride, src, src_stride, count);
+      }
+    }
   };
 
   template <>
@@ -0,0 +1,151 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <dynd/callable.hpp>
+#include <dynd/kernels/base_strided_kernel.hpp>
+
+namespace dynd {
+namespace nd {
+  namespace functional {
+
+    // The most arguments a fused expression, or any step of one, may have
+    static const size_t max_fused_args = 7;
+
+    // The bytes of stack space a fused kernel uses for the results of its steps
+    static const size_t fused_scratch_size = 8192;
+
+    /**
+     * One callable of a fused expression. Each argument refers to either an input
+     * of the expression (``arg < nsrc``) or the result of an earlier step
+     * (``arg - nsrc``).
+     */
+    struct fused_step {
+      callable f;
+      ndt::type dst_tp;
+      std::vector<ndt::type> src_tp;
+      std::map<std::string, ndt::type> tp_vars;
+      std::vector<size_t> args;
+    };
+
+    /**
+     * A sequence of steps evaluated in order, the last of which produces the result.
+     * The results of the others are held in chunks of ``chunk_size`` elements at
+     * ``buffer_offset`` in a scratch buffer.
+     */
+    struct fused_program {
+      size_t nsrc;
+      std::vector<fused_step> steps;
+      std::vector<intptr_t> buffer_offset;
+      size_t chunk_size;
+
+      fused_program(size_t nsrc, const std::vector<fused_step> &steps) : nsrc(nsrc), steps(steps), chunk_size(0) {
+        size_t element_size = 0;
+        for (size_t i = 0; i + 1 < steps.size(); ++i) {
+          element_size += steps[i].dst_tp.get_data_size();
+        }
+
+        // Leave room to round each buffer up to 16 bytes, with a chunk size of zero
+        // meaning the buffers don't fit
+        if (16 * steps.size() < fused_scratch_size) {
+          chunk_size = DYND_BUFFER_CHUNK_SIZE;
+          if (element_size != 0) {
+            chunk_size = std::min(chunk_size, (fused_scratch_size - 16 * steps.size()) / element_size);
+          }
+        }
+
+        intptr_t offset = 0;
+        for (size_t i = 0; i < steps.size(); ++i) {
+          buffer_offset.push_back(offset);
+          if (i + 1 < steps.size()) {
+            offset += (chunk_size * steps[i].dst_tp.get_data_size() + 15) & ~static_cast<intptr_t>(15);
+          }
+        }
+      }
+    };
+
+    /**
+     * A kernel that evaluates a whole expression chunk by chunk, passing each chunk
+     * through all the steps while it is still in cache. The intermediate results
+     * live on the stack, so several threads may run the same kernel at once.
+     */
+    struct fused_kernel : base_strided_kernel<fused_kernel> {
+      std::shared_ptr<const fused_program> m_program;
+      std::vector<intptr_t> m_child_offsets;
+
+      fused_kernel(const std::shared_ptr<const fused_program> &program) : m_program(program) {}
+
+      ~fused_kernel() {
+        for (intptr_t offset : m_child_offsets) {
+          get_child(offset)->destroy();
+        }
+      }
+
+      void call(array *dst, const array *src) {
+        char *src_data[max_fused_args];
+        for (size_t i = 0; i < m_program->nsrc; ++i) {
+          src_data[i] = const_cast<char *>(src[i].cdata());
+        }
+        single(const_cast<char *>(dst->cdata()), src_data);
+      }
+
+      void single(char *dst, char *const *src) {
+        static const intptr_t src_stride[max_fused_args] = {0};
+        strided(dst, 0, src, src_stride, 1);
+      }
+
+      void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+        alignas(16) char scratch[fused_scratch_size];
+        const fused_program &program = *m_program;
+
+        char *src_copy[max_fused_args];
+        memcpy(src_copy, src, program.nsrc * sizeof(char *));
+
+        char *child_src[max_fused_args];
+        intptr_t child_src_stride[max_fused_args];
+        while (count != 0) {
+          size_t chunk_size = std::min(count, program.chunk_size);
+          for (size_t i = 0; i < program.steps.size(); ++i) {
+            const fused_step &step = program.steps[i];
+            for (size_t j = 0; j < step.args.size(); ++j) {
+              size_t arg = step.args[j];
+              if (arg < program.nsrc) {
+                child_src[j] = src_copy[arg];
+                child_src_stride[j] = src_stride[arg];
+              } else {
+                child_src[j] = scratch + program.buffer_offset[arg - program.nsrc];
+                child_src_stride[j] = step.src_tp[j].get_data_size();
+              }
+            }
+
+            kernel_prefix *child = get_child(m_child_offsets[i]);
+            kernel_strided_t child_fn = child->get_function<kernel_strided_t>();
+            if (i + 1 == program.steps.size()) {
+              child_fn(child, dst, dst_stride, child_src, child_src_stride, chunk_size);
+            } else {
+              child_fn(child, scratch + program.buffer_offset[i], step.dst_tp.get_data_size(), child_src,
+                       child_src_stride, chunk_size);
+            }
+          }
+
+          dst += chunk_size * dst_stride;
+          for (size_t i = 0; i < program.nsrc; ++i) {
+            src_copy[i] += chunk_size * src_stride[i];
+          }
+          count -= chunk_size;
+        }
+      }
+    };
+
+  } // namespace dynd::nd::functional
+} // namespace dynd::nd
+} // namespace dynd
@@ -0,0 +1,44 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/jit.hpp>
+
+namespace dynd {
+namespace nd {
+  namespace functional {
+
+    /**
+     * A kernel that evaluates a fused program with the machine code the JIT made
+     * for it, in place of a child kernel per step.
+     */
+    struct jit_kernel : base_strided_kernel<jit_kernel> {
+      jit::strided_function m_function;
+      size_t m_nsrc;
+
+      jit_kernel(jit::strided_function function, size_t nsrc) : m_function(function), m_nsrc(nsrc) {}
+
+      void call(array *dst, const array *src) {
+        char *src_data[max_fused_args];
+        for (size_t i = 0; i < m_nsrc; ++i) {
+          src_data[i] = const_cast<char *>(src[i].cdata());
+        }
+        single(const_cast<char *>(dst->cdata()), src_data);
+      }
+
+      void single(char *dst, char *const *src) {
+        static const intptr_t src_stride[max_fused_args] = {0};
+        m_function(dst, 0, src, src_stride, 1);
+      }
+
+      void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+        m_function(dst, dst_stride, src, src_stride, count);
+      }
+    };
+
+  } // namespace dynd::nd::functional
+} // namespace dynd::nd
+} // namespace dynd
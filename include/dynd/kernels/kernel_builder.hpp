@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include <dynd/callables/call.hpp>
 #include <dynd/storagebuf.hpp>
 
@@ -13,6 +15,14 @@ namespace nd {
 
   struct kernel_prefix;
 
+  /**
+   * Whether kernels of this type keep nothing from one call to the next, so a
+   * ckernel made only of such kernels may be kept and reused by later calls.
+   * Kernel types opt in by specializing this.
+   */
+  template <typename KernelType>
+  struct is_stateless_kernel : std::false_type {};
+
   /**
    * Function pointers + data for a hierarchical
    * kernel which operates on type/arrmeta in
@@ -24,9 +34,10 @@ namespace nd {
    */
   class kernel_builder : public storagebuf<kernel_prefix, kernel_builder> {
     call_node *m_call;
+    bool m_stateless;
 
   public:
-    kernel_builder(call_node *call = nullptr) : m_call(call) {}
+    kernel_builder(call_node *call = nullptr) : m_call(call), m_stateless(true) {}
 
     DYND_API void destroy();
 
@@ -35,11 +46,20 @@ namespace nd {
     template <typename KernelType, typename... ArgTypes>
     void emplace_back(ArgTypes &&... args) {
       storagebuf<kernel_prefix, kernel_builder>::emplace_back<KernelType>(std::forward<ArgTypes>(args)...);
+      m_stateless = m_stateless && is_stateless_kernel<KernelType>::value;
 
       m_call = reinterpret_cast<call_node *>(reinterpret_cast<char *>(m_call) + m_call->data_size);
     }
 
-    void emplace_back(size_t size) { storagebuf<kernel_prefix, kernel_builder>::emplace_back(size); }
+    void emplace_back(size_t size) {
+      storagebuf<kernel_prefix, kernel_builder>::emplace_back(size);
+      m_stateless = false;
+    }
+
+    /**
+     * Returns true if every kernel emplaced so far is known to be stateless.
+     */
+    bool is_stateless() const { return m_stateless; }
 
     void pass() { m_call = reinterpret_cast<call_node *>(reinterpret_cast<char *>(m_call) + m_call->data_size); }
 
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <dynd/kernels/base_strided_kernel.hpp>
+#include <dynd/kernels/contiguous_loop.hpp>
 
 namespace dynd {
 namespace nd {
@@ -18,6 +19,16 @@ namespace nd {
       *reinterpret_cast<bool1 *>(dst) = static_cast<common_type>(*reinterpret_cast<Arg0Type *>(src[0])) <
                                         static_cast<common_type>(*reinterpret_cast<Arg1Type *>(src[1]));
     }
+
+    void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+      if (!strided_contiguous<bool1, Arg0Type, Arg1Type>(
+              [](const Arg0Type &x, const Arg1Type &y) {
+                return static_cast<common_type>(x) < static_cast<common_type>(y);
+              },
+              dst, dst_stride, src, src_stride, count)) {
+        base_strided_kernel<less_kernel, 2>::strided(dst, dst_stride, src, src_stride, count);
+      }
+    }
   };
 
   template <typename Arg0Type>
@@ -25,6 +36,13 @@ namespace nd {
     void single(char *dst, char *const *src) {
       *reinterpret_cast<bool1 *>(dst) = *reinterpret_cast<Arg0Type *>(src[0]) < *reinterpret_cast<Arg0Type *>(src[1]);
     }
+
+    void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+      if (!strided_contiguous<bool1, Arg0Type, Arg0Type>([](const Arg0Type &x, const Arg0Type &y) { return x < y; },
+                                                         dst, dst_stride, src, src_stride, count)) {
+        base_strided_kernel<less_kernel, 2>::strided(dst, dst_stride, src, src_stride, count);
+      }
+    }
   };
 
 } // namespace dynd::nd
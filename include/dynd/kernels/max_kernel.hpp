@@ -7,6 +7,7 @@
 
 #include <dynd/kernels/base_kernel.hpp>
 #include <dynd/kernels/base_strided_kernel.hpp>
+#include <dynd/kernels/contiguous_loop.hpp>
 #include <dynd/types/callable_type.hpp>
 
 namespace dynd {
@@ -23,6 +24,14 @@ namespace nd {
     }
 
     void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+      if (dst_stride == 0) {
+        // Accumulating along the reduced dimension, in a register rather than through dst
+        *reinterpret_cast<dst_type *>(dst) = strided_accumulate<Arg0Type>(
+            [](Arg0Type acc, Arg0Type val) { return (val > acc) ? val : acc; }, *reinterpret_cast<dst_type *>(dst),
+            src[0], src_stride[0], count);
+        return;
+      }
+
       char *src0 = src[0];
       intptr_t src0_stride = src_stride[0];
       for (size_t i = 0; i < count; ++i) {
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <dynd/kernels/base_kernel.hpp>
+#include <dynd/kernels/contiguous_loop.hpp>
 #include <dynd/types/callable_type.hpp>
 
 namespace dynd {
@@ -22,6 +23,13 @@ namespace nd {
     }
 
     void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+      if (dst_stride == 0) {
+        // Accumulating along the reduced dimension, in a register rather than through dst
+        *reinterpret_cast<dst_type *>(dst) = strided_accumulate<Arg0Type>(
+            [](Arg0Type acc, Arg0Type val) { return (val < acc) ? val : acc; }, *reinterpret_cast<dst_type *>(dst),
+            src[0], src_stride[0], count);
+        return;
+      }
 
       char *src0 = src[0];
       intptr_t src0_stride = src_stride[0];
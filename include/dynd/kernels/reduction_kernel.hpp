@@ -5,12 +5,17 @@
 
 #pragma once
 
+#include <algorithm>
+#include <memory>
+
 #include <dynd/assignment.hpp>
 #include <dynd/callable.hpp>
+#include <dynd/eval/eval_context.hpp>
 #include <dynd/functional.hpp>
 #include <dynd/kernels/base_kernel.hpp>
 #include <dynd/kernels/constant_kernel.hpp>
 #include <dynd/kernels/reduction_kernel_prefix.hpp>
+#include <dynd/thread_pool.hpp>
 
 namespace dynd {
 namespace nd {
@@ -219,6 +224,10 @@ namespace nd {
      *  - The child destination initialization kernel must be *single*.
      *  - The child reduction kernel must be *strided*.
      *
+     * When ``partial_size`` is nonzero, the reduction is associative with an
+     * identity as its initialization and a destination of the same type as its
+     * source, of that size. Long dimensions are then split into chunks that are
+     * reduced concurrently into partial results, which are combined in order.
      */
     template <size_t NArg>
     struct reduction_kernel<ndt::fixed_dim_type, false, true, NArg>
@@ -229,12 +238,48 @@ namespace nd {
       intptr_t _size;
       intptr_t src_stride[NArg];
       size_t init_offset;
+      size_t partial_size;
 
       ~reduction_kernel() {
         this->get_child()->destroy();
         this->get_child(init_offset)->destroy();
       }
 
+      void reduce(char *dst, char *const *src, size_t count) {
+        kernel_prefix *reduction_child = this->get_child();
+
+        const eval::eval_context &ectx = eval::default_eval_context;
+        if (partial_size == 0 || ectx.nthreads <= 1 || in_parallel_region() || count < 2 * ectx.grain_size) {
+          reduction_child->strided(dst, 0, src, src_stride, count);
+          return;
+        }
+
+        // A few chunks per thread, so that threads which finish early can take over the remainder
+        size_t nchunks = std::min(count / ectx.grain_size, 4 * ectx.nthreads);
+        intptr_t partial_stride = static_cast<intptr_t>((partial_size + 15) / 16 * 16);
+        std::unique_ptr<char[]> partials(new char[nchunks * partial_stride]);
+
+        kernel_prefix *init_child = this->get_child(init_offset);
+        parallel_for(ectx.nthreads, nchunks, 1, [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i) {
+            size_t chunk_begin = count * i / nchunks;
+            size_t chunk_end = count * (i + 1) / nchunks;
+
+            char *partial = partials.get() + i * partial_stride;
+            char *chunk_src[NArg];
+            for (size_t j = 0; j < NArg; ++j) {
+              chunk_src[j] = src[j] + static_cast<intptr_t>(chunk_begin) * src_stride[j];
+            }
+
+            init_child->single(partial, chunk_src);
+            reduction_child->strided(partial, 0, chunk_src, src_stride, chunk_end - chunk_begin);
+          }
+        });
+
+        char *partial_src = partials.get();
+        reduction_child->strided(dst, 0, &partial_src, &partial_stride, nchunks);
+      }
+
       void single_first(char *dst, char *const *src) {
         char *child_src[NArg];
         for (size_t i = 0; i < NArg; ++i) {
@@ -248,12 +293,11 @@ namespace nd {
         }
 
         // Do the reduction
-        this->get_child()->strided(dst, 0, child_src, src_stride, size_first);
+        reduce(dst, child_src, size_first);
       }
 
       void strided_first(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
         kernel_prefix *init_child = this->get_child(init_offset);
-        kernel_prefix *reduction_child = this->get_child();
 
         char *child_src[NArg];
         for (size_t j = 0; j < NArg; ++j) {
@@ -268,10 +312,10 @@ namespace nd {
             child_src[j] += src_stride_first[j];
           }
 
-          reduction_child->strided(dst, 0, child_src, this->src_stride, size_first);
+          reduce(dst, child_src, size_first);
 
           for (std::size_t i = 1; i != count; ++i) {
-            reduction_child->strided(dst, 0, child_src, this->src_stride, size_first);
+            reduce(dst, child_src, size_first);
 
             dst += dst_stride;
             for (size_t j = 0; j < NArg; ++j) {
@@ -288,7 +332,7 @@ namespace nd {
             for (size_t j = 0; j < NArg; ++j) {
               inner_child_src[j] = child_src[j] + src_stride_first[j];
             }
-            reduction_child->strided(dst, 0, inner_child_src, this->src_stride, size_first);
+            reduce(dst, inner_child_src, size_first);
 
             dst += dst_stride;
             for (size_t j = 0; j < NArg; ++j) {
@@ -300,8 +344,6 @@ namespace nd {
 
       void strided_followup(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride,
                             size_t count) {
-        kernel_prefix *reduce_child = this->get_child();
-
         // No initialization, all reduction
         char *child_src[NArg];
         for (size_t j = 0; j < NArg; ++j) {
@@ -309,7 +351,7 @@ namespace nd {
         }
 
         for (size_t i = 0; i != count; ++i) {
-          reduce_child->strided(dst, 0, child_src, this->src_stride, _size);
+          reduce(dst, child_src, _size);
 
           dst += dst_stride;
           for (size_t j = 0; j < NArg; ++j) {
@@ -0,0 +1,98 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * Memory for the temporary buffers of ckernels, handed out and given back in
+   * stack order. The blocks it allocates are kept for reuse, so a kernel that
+   * buffers every chunk touches the heap only the first few times it is called.
+   *
+   * Each thread has its own arena (see ``get_scratch_arena()``), which makes it
+   * safe for several threads to run the same kernel at once.
+   */
+  class DYND_API scratch_arena {
+    struct block {
+      std::unique_ptr<char[]> data;
+      size_t size;
+    };
+
+    std::vector<block> m_blocks;
+    // The block allocations come from, and the bytes of it already handed out
+    size_t m_block;
+    size_t m_offset;
+
+  public:
+    /** A position in the arena, for giving back everything allocated after it */
+    struct mark {
+      size_t block;
+      size_t offset;
+    };
+
+    scratch_arena() : m_block(0), m_offset(0) {}
+
+    scratch_arena(const scratch_arena &) = delete;
+
+    scratch_arena &operator=(const scratch_arena &) = delete;
+
+    mark get_mark() const { return mark{m_block, m_offset}; }
+
+    /** Gives back everything allocated since ``m`` was taken */
+    void release(const mark &m) {
+      m_block = m.block;
+      m_offset = m.offset;
+    }
+
+    /** Allocates ``size`` bytes, aligned to 16 bytes */
+    char *allocate(size_t size);
+  };
+
+  /**
+   * Returns how many elements of ``data_size`` bytes to buffer at a time. This is
+   * ``DYND_BUFFER_CHUNK_SIZE``, or fewer if that many would take more than
+   * ``DYND_BUFFER_CHUNK_BYTES``.
+   */
+  inline size_t get_buffer_chunk_size(size_t data_size) {
+    if (data_size * DYND_BUFFER_CHUNK_SIZE <= DYND_BUFFER_CHUNK_BYTES) {
+      return DYND_BUFFER_CHUNK_SIZE;
+    }
+
+    return std::max(DYND_BUFFER_CHUNK_BYTES / data_size, static_cast<size_t>(1));
+  }
+
+  /** Returns the scratch arena of the calling thread */
+  DYND_API scratch_arena &get_scratch_arena();
+
+  /**
+   * Allocates from the calling thread's scratch arena, giving everything back on
+   * destruction.
+   */
+  class scratch_frame {
+    scratch_arena &m_arena;
+    scratch_arena::mark m_mark;
+
+  public:
+    scratch_frame() : m_arena(get_scratch_arena()), m_mark(m_arena.get_mark()) {}
+
+    scratch_frame(const scratch_frame &) = delete;
+
+    scratch_frame &operator=(const scratch_frame &) = delete;
+
+    ~scratch_frame() { m_arena.release(m_mark); }
+
+    char *allocate(size_t size) { return m_arena.allocate(size); }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
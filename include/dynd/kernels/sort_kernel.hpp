@@ -5,8 +5,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
 #include <dynd/bytes.hpp>
+#include <dynd/eval/eval_context.hpp>
 #include <dynd/kernels/base_strided_kernel.hpp>
+#include <dynd/thread_pool.hpp>
 
 namespace dynd {
 namespace nd {
@@ -37,5 +43,189 @@ namespace nd {
     }
   };
 
+  namespace detail {
+
+    /**
+     * Maps a value to an unsigned key whose natural order is the order of the
+     * values. For floating point types, negative NaNs sort first and positive
+     * NaNs last.
+     */
+    template <typename T, typename Enable = void>
+    struct radix_traits;
+
+    template <typename T>
+    struct radix_traits<T, std::enable_if_t<std::is_integral<T>::value && std::is_unsigned<T>::value>> {
+      typedef T key_type;
+
+      static key_type key(T value) { return value; }
+    };
+
+    template <typename T>
+    struct radix_traits<T, std::enable_if_t<std::is_integral<T>::value && std::is_signed<T>::value>> {
+      typedef std::make_unsigned_t<T> key_type;
+
+      static key_type key(T value)
+      {
+        return static_cast<key_type>(static_cast<key_type>(value) ^ (key_type(1) << (8 * sizeof(T) - 1)));
+      }
+    };
+
+    template <typename T>
+    struct radix_traits<T, std::enable_if_t<std::is_floating_point<T>::value>> {
+      typedef std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t> key_type;
+
+      static key_type key(T value)
+      {
+        key_type bits;
+        memcpy(&bits, &value, sizeof(T));
+        const key_type sign = key_type(1) << (8 * sizeof(T) - 1);
+        return (bits & sign) ? ~bits : (bits | sign);
+      }
+    };
+
+    template <>
+    struct radix_traits<bool1> {
+      typedef uint8_t key_type;
+
+      static key_type key(bool1 value) { return static_cast<bool>(value); }
+    };
+
+    template <typename T>
+    struct radix_less {
+      bool operator()(T lhs, T rhs) const { return radix_traits<T>::key(lhs) < radix_traits<T>::key(rhs); }
+    };
+
+    // Shorter runs are sorted by comparison, which beats the fixed cost of the radix passes
+    const size_t radix_sort_threshold = 256;
+
+    /**
+     * Sorts ``data`` with a least significant digit radix sort, one byte per pass,
+     * using ``buf`` of the same size as scratch. Passes on a byte that is the same
+     * for every value are skipped.
+     */
+    template <typename T>
+    void radix_sort(T *data, T *buf, size_t size)
+    {
+      typedef radix_traits<T> traits;
+
+      if (size < radix_sort_threshold) {
+        std::sort(data, data + size, radix_less<T>());
+        return;
+      }
+
+      size_t counts[sizeof(T)][256] = {};
+      for (size_t i = 0; i < size; ++i) {
+        typename traits::key_type key = traits::key(data[i]);
+        for (size_t p = 0; p < sizeof(T); ++p) {
+          ++counts[p][(key >> (8 * p)) & 0xff];
+        }
+      }
+
+      T *from = data, *to = buf;
+      for (size_t p = 0; p < sizeof(T); ++p) {
+        if (counts[p][(traits::key(from[0]) >> (8 * p)) & 0xff] == size) {
+          continue;
+        }
+
+        size_t offsets[256];
+        size_t offset = 0;
+        for (size_t d = 0; d < 256; ++d) {
+          offsets[d] = offset;
+          offset += counts[p][d];
+        }
+
+        for (size_t i = 0; i < size; ++i) {
+          to[offsets[(traits::key(from[i]) >> (8 * p)) & 0xff]++] = from[i];
+        }
+        std::swap(from, to);
+      }
+
+      if (from != data) {
+        memcpy(data, from, size * sizeof(T));
+      }
+    }
+
+    /**
+     * Sorts ``data`` using up to ``nthreads`` threads, by radix sorting one run per
+     * thread and then merging pairs of runs until one is left.
+     */
+    template <typename T>
+    void parallel_radix_sort(size_t nthreads, T *data, T *buf, size_t size)
+    {
+      size_t nruns = nthreads;
+      parallel_for(nthreads, nruns, 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          size_t run_begin = size * i / nruns, run_end = size * (i + 1) / nruns;
+          radix_sort(data + run_begin, buf + run_begin, run_end - run_begin);
+        }
+      });
+
+      T *from = data, *to = buf;
+      for (size_t width = 1; width < nruns; width *= 2) {
+        size_t npairs = (nruns + 2 * width - 1) / (2 * width);
+        parallel_for(nthreads, npairs, 1, [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i) {
+            size_t first = size * std::min(2 * i * width, nruns) / nruns;
+            size_t middle = size * std::min((2 * i + 1) * width, nruns) / nruns;
+            size_t last = size * std::min((2 * i + 2) * width, nruns) / nruns;
+            std::merge(from + first, from + middle, from + middle, from + last, to + first, radix_less<T>());
+          }
+        });
+        std::swap(from, to);
+      }
+
+      if (from != data) {
+        memcpy(data, from, size * sizeof(T));
+      }
+    }
+
+  } // namespace dynd::nd::detail
+
+  /**
+   * Sorts a fixed dimension of builtin integer, floating point or boolean values
+   * directly, without calling a comparison kernel. Long dimensions are radix
+   * sorted, in parallel when the default eval context allows more than one thread.
+   */
+  template <typename Arg0Type>
+  struct typed_sort_kernel : base_strided_kernel<typed_sort_kernel<Arg0Type>, 1> {
+    const intptr_t src0_size;
+    const intptr_t src0_stride;
+
+    typed_sort_kernel(intptr_t src0_size, intptr_t src0_stride) : src0_size(src0_size), src0_stride(src0_stride) {}
+
+    void single(char *DYND_UNUSED(dst), char *const *src)
+    {
+      size_t size = static_cast<size_t>(src0_size);
+      bool contiguous = src0_stride == static_cast<intptr_t>(sizeof(Arg0Type));
+      if (size < detail::radix_sort_threshold && contiguous) {
+        Arg0Type *data = reinterpret_cast<Arg0Type *>(src[0]);
+        std::sort(data, data + size, detail::radix_less<Arg0Type>());
+        return;
+      }
+
+      // A strided dimension is gathered into the back half of the buffer, and scattered back once sorted
+      std::unique_ptr<Arg0Type[]> buf(new Arg0Type[contiguous ? size : 2 * size]);
+      Arg0Type *data = contiguous ? reinterpret_cast<Arg0Type *>(src[0]) : buf.get() + size;
+      if (!contiguous) {
+        for (size_t i = 0; i < size; ++i) {
+          data[i] = *reinterpret_cast<Arg0Type *>(src[0] + i * src0_stride);
+        }
+      }
+
+      const eval::eval_context &ectx = eval::default_eval_context;
+      if (ectx.nthreads > 1 && !in_parallel_region() && size >= 2 * ectx.grain_size) {
+        detail::parallel_radix_sort(std::min(ectx.nthreads, size / ectx.grain_size), data, buf.get(), size);
+      } else {
+        detail::radix_sort(data, buf.get(), size);
+      }
+
+      if (!contiguous) {
+        for (size_t i = 0; i < size; ++i) {
+          *reinterpret_cast<Arg0Type *>(src[0] + i * src0_stride) = data[i];
+        }
+      }
+    }
+  };
+
 } // namespace dynd::nd
 } // namespace dynd
@@ -0,0 +1,37 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+// String contains_any kernel
+
+#pragma once
+
+#include <memory>
+
+#include <dynd/string.hpp>
+#include <dynd/types/string_view_type.hpp>
+
+namespace dynd {
+namespace nd {
+
+  template <typename Arg0Type>
+  struct string_contains_any_kernel : base_strided_kernel<string_contains_any_kernel<Arg0Type>, 1> {
+    // Built once when the call is resolved and only read afterwards, so threads
+    // running copies of this kernel can share it
+    std::shared_ptr<const dynd::detail::aho_corasick> m_matcher;
+
+    string_contains_any_kernel(const std::shared_ptr<const dynd::detail::aho_corasick> &matcher)
+        : m_matcher(matcher) {}
+
+    void single(char *dst, char *const *src)
+    {
+      bool1 *d = reinterpret_cast<bool1 *>(dst);
+      string_view s0 = *reinterpret_cast<const Arg0Type *>(src[0]);
+
+      *d = (bool1)m_matcher->contains_any(s0.begin(), s0.end());
+    }
+  };
+
+} // namespace nd
+} // namespace dynd
@@ -8,17 +8,20 @@
 #pragma once
 
 #include <dynd/string.hpp>
+#include <dynd/types/string_view_type.hpp>
 
 namespace dynd {
 namespace nd {
 
-  struct string_rfind_kernel : base_strided_kernel<string_rfind_kernel, 2> {
+  template <typename Arg0Type, typename Arg1Type>
+  struct string_rfind_kernel : base_strided_kernel<string_rfind_kernel<Arg0Type, Arg1Type>, 2> {
     void single(char *dst, char *const *src)
     {
       intptr_t *d = reinterpret_cast<intptr_t *>(dst);
-      const string *const *s = reinterpret_cast<const string *const *>(src);
+      string_view s0 = *reinterpret_cast<const Arg0Type *>(src[0]);
+      string_view s1 = *reinterpret_cast<const Arg1Type *>(src[1]);
 
-      *d = dynd::string_rfind(*(s[0]), *(s[1]));
+      *d = dynd::string_rfind(s0, s1);
     }
   };
 
@@ -9,40 +9,117 @@
 
 #include <dynd/string.hpp>
 #include <dynd/string_search.hpp>
+#include <dynd/types/string_view_type.hpp>
 #include <dynd/types/var_dim_type.hpp>
 
 namespace dynd {
 namespace nd {
+  namespace detail {
 
-  struct string_split_kernel : base_strided_kernel<string_split_kernel, 2> {
+    /**
+     * Appends elements of type ``T`` to a var dim, growing its allocation from the memory
+     * block geometrically so a split needs no count of the pieces beforehand.
+     */
+    template <typename T>
+    class var_dim_appender {
+      ndt::var_dim_type::data_type *m_dst;
+      const memory_block &m_memblock;
+      size_t m_capacity;
+
+    public:
+      var_dim_appender(ndt::var_dim_type::data_type *dst, const memory_block &memblock)
+          : m_dst(dst), m_memblock(memblock), m_capacity(8) {
+        m_dst->begin = m_memblock->alloc(m_capacity);
+        m_dst->size = 0;
+      }
+
+      T &push_back() {
+        if (m_dst->size == m_capacity) {
+          m_capacity *= 2;
+          m_dst->begin = m_memblock->resize(m_dst->begin, m_capacity);
+        }
+
+        return reinterpret_cast<T *>(m_dst->begin)[m_dst->size++];
+      }
+
+      /** Gives the unused capacity back to the memory block */
+      void finish() { m_dst->begin = m_memblock->resize(m_dst->begin, m_dst->size); }
+    };
+
+  } // namespace dynd::nd::detail
+
+  template <typename Arg0Type, typename Arg1Type>
+  struct string_split_kernel : base_strided_kernel<string_split_kernel<Arg0Type, Arg1Type>, 2> {
+    memory_block m_dst_memblock;
+    // The pieces are freed with the memory block holding them, all at once
+    base_memory_block *m_dst_string_arena;
+
+    string_split_kernel(const memory_block &dst_memblock)
+        : m_dst_memblock(dst_memblock), m_dst_string_arena(dst_memblock->get_string_arena()) {}
+
+    void single(char *dst, char *const *src) {
+      string_view haystack = *reinterpret_cast<const Arg0Type *>(src[0]);
+      string_view needle = *reinterpret_cast<const Arg1Type *>(src[1]);
+
+      detail::var_dim_appender<string> pieces(reinterpret_cast<ndt::var_dim_type::data_type *>(dst), m_dst_memblock);
+      auto assign_piece = [&](size_t begin, size_t end) {
+        pieces.push_back().assign(haystack.data() + begin, end - begin, *m_dst_string_arena);
+      };
+      dynd::detail::string_split(haystack, needle, assign_piece);
+      pieces.finish();
+    }
+  };
+
+  /**
+   * Splits a view into views of its pieces. The destination's arrmeta refers to
+   * the memory block holding the bytes of the source, so nothing is copied.
+   */
+  template <typename Arg1Type>
+  struct string_split_kernel<string_view, Arg1Type>
+      : base_strided_kernel<string_split_kernel<string_view, Arg1Type>, 2> {
     memory_block m_dst_memblock;
 
     string_split_kernel(const memory_block &dst_memblock) : m_dst_memblock(dst_memblock) {}
 
     void single(char *dst, char *const *src) {
-      ndt::var_dim_type::data_type *dst_v = reinterpret_cast<ndt::var_dim_type::data_type *>(dst);
+      const string_view &haystack = *reinterpret_cast<const string_view *>(src[0]);
+      string_view needle = *reinterpret_cast<const Arg1Type *>(src[1]);
 
-      const string *const *s = reinterpret_cast<const string *const *>(src);
-      const string &haystack = *(s[0]);
-      const string &needle = *(s[1]);
+      detail::var_dim_appender<string_view> pieces(reinterpret_cast<ndt::var_dim_type::data_type *>(dst),
+                                                   m_dst_memblock);
+      auto view_piece = [&](size_t begin, size_t end) {
+        pieces.push_back() = string_view(haystack.data() + begin, end - begin);
+      };
+      dynd::detail::string_split(haystack, needle, view_piece);
+      pieces.finish();
+    }
+  };
 
-      intptr_t count = dynd::string_count(haystack, needle);
+  /**
+   * Splits a string into the byte offsets ``[begin, end)`` of its pieces, leaving
+   * the bytes where they are.
+   */
+  template <typename Arg0Type, typename Arg1Type>
+  struct string_split_offsets_kernel : base_strided_kernel<string_split_offsets_kernel<Arg0Type, Arg1Type>, 2> {
+    typedef intptr_t offsets_type[2];
 
-      if (count == 0) {
-        dst_v->begin = m_dst_memblock->alloc(1);
-        dst_v->size = 1;
-        string *dst_str = reinterpret_cast<string *>(dst_v->begin);
-        dst_str[0] = haystack;
-        return;
-      }
+    memory_block m_dst_memblock;
 
-      dst_v->begin = m_dst_memblock->alloc(count + 1);
-      dst_v->size = count + 1;
-      string *dst_str = reinterpret_cast<string *>(dst_v->begin);
+    string_split_offsets_kernel(const memory_block &dst_memblock) : m_dst_memblock(dst_memblock) {}
+
+    void single(char *dst, char *const *src) {
+      string_view haystack = *reinterpret_cast<const Arg0Type *>(src[0]);
+      string_view needle = *reinterpret_cast<const Arg1Type *>(src[1]);
 
-      dynd::detail::string_splitter<string> f(dst_str, haystack, needle);
-      dynd::detail::string_search(haystack, needle, f);
-      f.finish();
+      detail::var_dim_appender<offsets_type> pieces(reinterpret_cast<ndt::var_dim_type::data_type *>(dst),
+                                                    m_dst_memblock);
+      auto record_piece = [&](size_t begin, size_t end) {
+        offsets_type &offsets = pieces.push_back();
+        offsets[0] = begin;
+        offsets[1] = end;
+      };
+      dynd::detail::string_split(haystack, needle, record_piece);
+      pieces.finish();
     }
   };
 
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <dynd/kernels/base_strided_kernel.hpp>
+#include <dynd/kernels/contiguous_loop.hpp>
 
 namespace dynd {
 namespace nd {
@@ -19,6 +20,13 @@ namespace nd {
     }
 
     void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+      if (dst_stride == 0 && count != 0) {
+        // Accumulating along the reduced dimension, which is summed pairwise to bound the rounding error
+        *reinterpret_cast<dst_type *>(dst) =
+            *reinterpret_cast<dst_type *>(dst) + pairwise_sum<Arg0Type>(src[0], src_stride[0], count);
+        return;
+      }
+
       char *src0 = src[0];
       intptr_t src0_stride = src_stride[0];
       for (size_t i = 0; i < count; ++i) {
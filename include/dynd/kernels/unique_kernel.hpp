@@ -5,39 +5,247 @@
 
 #pragma once
 
-#include <dynd/bytes.hpp>
-#include <dynd/kernels/base_kernel.hpp>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <dynd/kernels/base_strided_kernel.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+#include <dynd/types/string_type.hpp>
+#include <dynd/types/struct_type.hpp>
+#include <dynd/types/var_dim_type.hpp>
 
 namespace dynd {
 namespace nd {
+  namespace detail {
+
+    inline uint64_t hash_mix(uint64_t x) {
+      x ^= x >> 33;
+      x *= UINT64_C(0xFF51AFD7ED558CCD);
+      x ^= x >> 33;
+      x *= UINT64_C(0xC4CEB9FE1A85EC53);
+      x ^= x >> 33;
+      return x;
+    }
+
+    /**
+     * How nd::unique hashes and compares values. Floating point values are compared
+     * with ``==``, except that all NaNs are considered equal to each other.
+     */
+    template <typename T, typename Enable = void>
+    struct unique_traits;
+
+    template <typename T>
+    struct unique_traits<T, std::enable_if_t<std::is_integral<T>::value>> {
+      static size_t hash(T value) { return static_cast<size_t>(hash_mix(static_cast<uint64_t>(value))); }
+
+      static bool equal(T lhs, T rhs) { return lhs == rhs; }
+    };
+
+    template <>
+    struct unique_traits<bool1> {
+      static size_t hash(bool1 value) { return static_cast<bool>(value); }
+
+      static bool equal(bool1 lhs, bool1 rhs) { return static_cast<bool>(lhs) == static_cast<bool>(rhs); }
+    };
+
+    template <typename T>
+    struct unique_traits<T, std::enable_if_t<std::is_floating_point<T>::value>> {
+      static size_t hash(T value) {
+        if (std::isnan(value)) {
+          return 0;
+        }
+
+        // Adding zero turns -0.0 into 0.0, which compares equal to it
+        double canonical = static_cast<double>(value) + 0.0;
+        uint64_t bits;
+        memcpy(&bits, &canonical, sizeof(bits));
+        return static_cast<size_t>(hash_mix(bits));
+      }
+
+      static bool equal(T lhs, T rhs) { return lhs == rhs || (std::isnan(lhs) && std::isnan(rhs)); }
+    };
+
+    template <>
+    struct unique_traits<string> {
+      static size_t hash(const string &value) {
+        const char *begin = value.begin();
+        size_t size = value.size();
+
+        uint64_t h = hash_mix(size);
+        for (; size >= sizeof(uint64_t); begin += sizeof(uint64_t), size -= sizeof(uint64_t)) {
+          uint64_t word;
+          memcpy(&word, begin, sizeof(word));
+          h = hash_mix(h ^ word);
+        }
+        uint64_t tail = 0;
+        memcpy(&tail, begin, size);
+        return static_cast<size_t>(hash_mix(h ^ tail));
+      }
+
+      static bool equal(const string &lhs, const string &rhs) { return lhs == rhs; }
+    };
+
+    /**
+     * An open addressing hash table that numbers the distinct values of a strided
+     * array in order of first appearance. Only the position of each first
+     * appearance is stored, so values are never copied.
+     */
+    template <typename T>
+    class unique_index {
+      typedef unique_traits<T> traits;
+
+      struct slot {
+        size_t hash;
+        size_t group; // The group number plus one, with zero marking an empty slot
+      };
+
+      const char *m_data;
+      intptr_t m_stride;
+      std::vector<slot> m_slots;
+      std::vector<size_t> m_first;
+
+      const T &at(size_t i) const { return *reinterpret_cast<const T *>(m_data + i * m_stride); }
 
-  struct unique_kernel : base_kernel<unique_kernel> {
-    const intptr_t src0_size;
+      void grow() {
+        std::vector<slot> slots(2 * m_slots.size(), slot{0, 0});
+        size_t mask = slots.size() - 1;
+        for (const slot &s : m_slots) {
+          if (s.group != 0) {
+            size_t j = s.hash & mask;
+            while (slots[j].group != 0) {
+              j = (j + 1) & mask;
+            }
+            slots[j] = s;
+          }
+        }
+
+        m_slots.swap(slots);
+      }
+
+    public:
+      unique_index(const char *data, intptr_t stride) : m_data(data), m_stride(stride), m_slots(16, slot{0, 0}) {}
+
+      /**
+       * Returns the group number of the value at position ``i``, which is the number
+       * of distinct values seen before it if it is new.
+       */
+      size_t insert(size_t i) {
+        const T &value = at(i);
+        size_t hash = traits::hash(value);
+
+        size_t mask = m_slots.size() - 1;
+        size_t j = hash & mask;
+        for (; m_slots[j].group != 0; j = (j + 1) & mask) {
+          if (m_slots[j].hash == hash && traits::equal(at(m_first[m_slots[j].group - 1]), value)) {
+            return m_slots[j].group - 1;
+          }
+        }
+
+        m_first.push_back(i);
+        m_slots[j] = slot{hash, m_first.size()};
+        if (2 * m_first.size() > m_slots.size()) {
+          grow();
+        }
+
+        return m_first.size() - 1;
+      }
+
+      /**
+       * The position of the first appearance of each distinct value.
+       */
+      const std::vector<size_t> &first() const { return m_first; }
+    };
+
+  } // namespace dynd::nd::detail
+
+  /**
+   * Finds the distinct values of a fixed dimension in order of first appearance,
+   * using a hash table. The result is either ``var * T`` of the values, or a struct
+   * with those ``values`` and, as requested, the ``counts`` of each value and the
+   * ``inverse`` group number of each element.
+   */
+  template <typename Arg0Type>
+  struct unique_kernel : base_strided_kernel<unique_kernel<Arg0Type>, 1> {
+    const size_t src0_size;
     const intptr_t src0_stride;
-    const intptr_t src0_element_data_size;
-
-    unique_kernel(intptr_t src0_size, intptr_t src0_stride, size_t src0_element_data_size)
-        : src0_size(src0_size), src0_stride(src0_stride), src0_element_data_size(src0_element_data_size) {}
-
-    ~unique_kernel() { get_child()->destroy(); }
-
-    void call(array *DYND_UNUSED(dst), const array *src) {
-      kernel_prefix *child = get_child();
-      size_t new_size =
-          (std::unique(strided_iterator(src[0].data(), src0_element_data_size, src0_stride),
-                       strided_iterator(src[0].data() + src0_size * src0_stride, src0_element_data_size, src0_stride),
-                       [child](char *lhs, char *rhs) {
-                         bool1 dst;
-                         char *src[2] = {lhs, rhs};
-                         child->single(reinterpret_cast<char *>(&dst), src);
-                         return dst;
-                       }) -
-           src[0].data()) /
-          src0_stride;
-
-//      src[0]->set_type(
-  //        ndt::make_fixed_dim(new_size, src[0]->get_type().extended<ndt::fixed_dim_type>()->get_element_type()));
-      reinterpret_cast<size_stride_t *>(src[0]->metadata())->dim_size = new_size;
+    intptr_t values_offset;
+    memory_block values_memblock;
+    intptr_t values_stride;
+    intptr_t counts_offset;
+    memory_block counts_memblock;
+    intptr_t counts_stride;
+    intptr_t inverse_offset;
+    intptr_t inverse_stride;
+
+    unique_kernel(size_t src0_size, intptr_t src0_stride, const ndt::type &dst_tp, const char *dst_arrmeta)
+        : src0_size(src0_size), src0_stride(src0_stride), values_offset(0), values_stride(0), counts_offset(-1),
+          counts_stride(0), inverse_offset(-1), inverse_stride(0) {
+      if (dst_tp.get_id() != struct_id) {
+        set_values(dst_arrmeta);
+        return;
+      }
+
+      // A struct's arrmeta starts with the data offsets of its fields
+      const ndt::struct_type *dst_sd = dst_tp.extended<ndt::struct_type>();
+      const uintptr_t *data_offsets = reinterpret_cast<const uintptr_t *>(dst_arrmeta);
+      for (intptr_t i = 0; i < dst_sd->get_field_count(); ++i) {
+        const char *field_arrmeta = dst_arrmeta + dst_sd->get_arrmeta_offsets_raw()[i];
+        const std::string &name = dst_sd->get_field_name(i);
+        if (name == "values") {
+          values_offset = data_offsets[i];
+          set_values(field_arrmeta);
+        } else if (name == "counts") {
+          counts_offset = data_offsets[i];
+          counts_memblock = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(field_arrmeta)->blockref;
+          counts_stride = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(field_arrmeta)->stride;
+        } else if (name == "inverse") {
+          inverse_offset = data_offsets[i];
+          inverse_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(field_arrmeta)->stride;
+        }
+      }
+    }
+
+    void set_values(const char *values_arrmeta) {
+      values_memblock = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(values_arrmeta)->blockref;
+      values_stride = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(values_arrmeta)->stride;
+    }
+
+    void single(char *dst, char *const *src) {
+      detail::unique_index<Arg0Type> index(src[0], src0_stride);
+      std::vector<int64_t> counts;
+      char *inverse = (inverse_offset >= 0) ? dst + inverse_offset : nullptr;
+      for (size_t i = 0; i < src0_size; ++i) {
+        size_t group = index.insert(i);
+        if (counts_offset >= 0) {
+          if (group == counts.size()) {
+            counts.push_back(0);
+          }
+          ++counts[group];
+        }
+        if (inverse != nullptr) {
+          *reinterpret_cast<int64_t *>(inverse + i * inverse_stride) = static_cast<int64_t>(group);
+        }
+      }
+
+      const std::vector<size_t> &first = index.first();
+      ndt::var_dim_type::data_type *values = reinterpret_cast<ndt::var_dim_type::data_type *>(dst + values_offset);
+      values->begin = values_memblock->alloc(first.size());
+      values->size = first.size();
+      for (size_t group = 0; group < first.size(); ++group) {
+        *reinterpret_cast<Arg0Type *>(values->begin + group * values_stride) =
+            *reinterpret_cast<const Arg0Type *>(src[0] + first[group] * src0_stride);
+      }
+
+      if (counts_offset >= 0) {
+        ndt::var_dim_type::data_type *dst_counts =
+            reinterpret_cast<ndt::var_dim_type::data_type *>(dst + counts_offset);
+        dst_counts->begin = counts_memblock->alloc(counts.size());
+        dst_counts->size = counts.size();
+        for (size_t group = 0; group < counts.size(); ++group) {
+          *reinterpret_cast<int64_t *>(dst_counts->begin + group * counts_stride) = counts[group];
+        }
+      }
     }
   };
 
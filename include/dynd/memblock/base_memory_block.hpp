@@ -58,6 +58,31 @@ namespace nd {
      */
     virtual void reset() { throw std::runtime_error("reset is not implemented"); }
 
+    /**
+     * Takes over the memory allocated from ``other``, which must be a memory
+     * block of the same kind. What was allocated from ``other`` stays valid
+     * for as long as this memory block lives, and ``other`` is left empty.
+     */
+    virtual void absorb(base_memory_block &DYND_UNUSED(other)) {
+      throw std::runtime_error("absorb is not implemented");
+    }
+
+    /**
+     * Keeps ``other`` alive for as long as this memory block lives, for data
+     * referenced by this memory block's arrmeta that points into ``other``.
+     */
+    virtual void add_reference(base_memory_block *DYND_UNUSED(other)) {
+      throw std::runtime_error("add_reference is not implemented");
+    }
+
+    /**
+     * Returns the memory block that strings stored in this memory block's data
+     * may take their heap buffers from, so they are freed together with it, or
+     * NULL if there is none. It is created on first use, so calling this isn't
+     * thread-safe, nor is allocating from the result.
+     */
+    virtual base_memory_block *get_string_arena() { return NULL; }
+
     /**
      * Does a debug dump of the memory block.
      */
@@ -8,6 +8,7 @@
 #include <iostream>
 #include <string>
 
+#include <dynd/memblock/pod_memory_block.hpp>
 #include <dynd/memory_block.hpp>
 #include <dynd/type.hpp>
 #include <dynd/types/base_memory_type.hpp>
@@ -40,6 +41,7 @@ namespace nd {
     char *m_data;
     memory_block m_owner;
     uint64_t m_flags;
+    memory_block m_string_arena;
 
   public:
     buffer_memory_block(const ndt::type &tp, size_t data_offset, size_t data_size, uint64_t flags)
@@ -92,6 +94,17 @@ namespace nd {
       }
     }
 
+    base_memory_block *get_string_arena() {
+      if (m_owner) {
+        return m_owner->get_string_arena();
+      }
+
+      if (!m_string_arena) {
+        m_string_arena = make_string_arena();
+      }
+      return m_string_arena.get();
+    }
+
     /** Return a pointer to the arrmeta, immediately after the preamble */
     char *metadata() const { return const_cast<char *>(reinterpret_cast<const char *>(this + 1)); }
 
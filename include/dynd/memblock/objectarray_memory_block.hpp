@@ -8,7 +8,7 @@
 #include <iostream>
 #include <string>
 
-#include <dynd/memblock/base_memory_block.hpp>
+#include <dynd/memblock/pod_memory_block.hpp>
 #include <dynd/type.hpp>
 
 namespace dynd {
@@ -41,6 +41,8 @@ namespace nd {
     bool m_finalized;
     /** The malloc'd memory */
     std::vector<memory_chunk> m_memory_handles;
+    /** Where strings in the objects take their memory from, released after they are destructed */
+    memory_block m_string_arena;
 
   public:
     objectarray_memory_block(const ndt::type &dt, size_t arrmeta_size, const char *arrmeta, intptr_t stride,
@@ -113,12 +115,14 @@ namespace nd {
 
       if (mc->capacity_count - previous_index < count) {
         append_memory(std::max(m_total_allocated_count, count));
+        // Appending may have moved the chunks
+        mc = &m_memory_handles[m_memory_handles.size() - 2];
         memory_chunk *new_mc = &m_memory_handles.back();
         // Move the old memory to the newly allocated block
         if (previous_count > 0) {
           // Subtract the previously used memory from the old chunk's count
           mc->used_count -= previous_count;
-          memcpy(new_mc->memory, previous_allocated, previous_count);
+          memcpy(new_mc->memory, previous_allocated, m_stride * previous_count);
           // If the old memory only had the memory being resized,
           // free it completely.
           if (previous_allocated == mc->memory) {
@@ -146,7 +150,7 @@ namespace nd {
         // Zero-init the new memory
         intptr_t new_count = count - (intptr_t)previous_count;
         if (new_count > 0) {
-          memset(mc->memory + m_stride * previous_count, 0, m_stride * new_count);
+          memset(result + m_stride * previous_count, 0, m_stride * new_count);
         }
       } else {
         // TODO: Add a default data constructor to base_type
@@ -160,6 +164,13 @@ namespace nd {
 
     void finalize() { m_finalized = true; }
 
+    base_memory_block *get_string_arena() {
+      if (!m_string_arena) {
+        m_string_arena = make_string_arena();
+      }
+      return m_string_arena.get();
+    }
+
     void reset() {
       if (m_memory_handles.size() > 1) {
         // If there are more than one allocated memory chunks,
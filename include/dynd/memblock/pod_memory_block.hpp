@@ -9,6 +9,7 @@
 #include <string>
 
 #include <dynd/memblock/base_memory_block.hpp>
+#include <dynd/memory_block.hpp>
 #include <dynd/type.hpp>
 
 namespace dynd {
@@ -23,6 +24,8 @@ namespace nd {
     std::vector<char *> m_memory_handles;
     /** The current malloc'd memory being doled out */
     char *m_memory_begin, *m_memory_current, *m_memory_end;
+    /** Other memory blocks that data this one stands for points into */
+    std::vector<memory_block> m_references;
 
     pod_memory_block(size_t data_size, intptr_t data_alignment, intptr_t initial_capacity_bytes = 2048)
         : data_size(data_size), data_alignment(data_alignment), m_total_allocated_capacity(0), m_memory_handles() {
@@ -140,6 +143,30 @@ namespace nd {
       m_total_allocated_capacity = m_memory_end - m_memory_begin;
     }
 
+    void absorb(base_memory_block &other) {
+      pod_memory_block &rhs = dynamic_cast<pod_memory_block &>(other);
+
+      // The last handle is the chunk being doled out, so it stays last
+      std::vector<char *>::iterator pos = m_memory_handles.end();
+      if (!m_memory_handles.empty()) {
+        --pos;
+      }
+      m_memory_handles.insert(pos, rhs.m_memory_handles.begin(), rhs.m_memory_handles.end());
+      m_total_allocated_capacity += rhs.m_total_allocated_capacity;
+
+      rhs.m_memory_handles.clear();
+      rhs.m_total_allocated_capacity = 0;
+      rhs.m_memory_begin = NULL;
+      rhs.m_memory_current = NULL;
+      rhs.m_memory_end = NULL;
+    }
+
+    void add_reference(base_memory_block *other) {
+      if (other != this && (m_references.empty() || m_references.back().get() != other)) {
+        m_references.push_back(memory_block(other));
+      }
+    }
+
     void debug_print(std::ostream &o, const std::string &indent) {
       o << indent << "------ memory_block at " << static_cast<const void *>(this) << "\n";
       o << indent << " reference count: " << static_cast<long>(m_use_count) << "\n";
@@ -152,5 +179,11 @@ namespace nd {
     }
   };
 
+  /**
+   * Makes a memory block that hands out string buffers from slabs which double
+   * in size, for use as the string arena of another memory block.
+   */
+  inline memory_block make_string_arena() { return make_memory_block<pod_memory_block>(1, sizeof(size_t), 4096); }
+
 } // namespace dynd::nd
 } // namespace dynd
@@ -0,0 +1,41 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/config.hpp>
+#include <dynd/float16.hpp>
+
+namespace dynd {
+
+/**
+ * The most characters any of the ``format_*`` functions below writes.
+ */
+const size_t number_format_max_size = 32;
+
+/**
+ * Writes the decimal digits of an integer to ``out``, two digits at a time from
+ * a table, and returns one past the last character written.
+ */
+DYND_API char *format_int(char *out, int64_t value);
+DYND_API char *format_uint(char *out, uint64_t value);
+
+/**
+ * Writes the shortest decimal representation of a floating point value that
+ * parses back to the same value, using the Grisu2 algorithm, and returns one past
+ * the last character written. Grisu2 always round trips, but for under 1% of
+ * values it produces one digit more than the shortest form. That rate depends on
+ * the inputs, e.g. it's about 0.1% of doubles and 0.2% of floats drawn from
+ * random bit patterns.
+ *
+ * Values are laid out like JavaScript numbers, e.g. ``1``, ``0.1``, ``1.5e-7``
+ * and ``1e+21``, except that negative zero is ``-0``. Infinities and NaN, which
+ * JSON has no representation for, are written as ``inf``, ``-inf`` and ``nan``.
+ */
+DYND_API char *format_double(char *out, double value);
+DYND_API char *format_float(char *out, float value);
+DYND_API char *format_float16(char *out, float16 value);
+
+} // namespace dynd
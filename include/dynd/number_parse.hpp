@@ -0,0 +1,105 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <cstring>
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+namespace detail {
+
+  /**
+   * Loads eight characters as a little endian word, so the first character is in
+   * the lowest byte.
+   */
+  inline uint64_t load_eight_chars(const char *p) {
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+#ifdef DYND_BIG_ENDIAN
+    value = ((value & UINT64_C(0x00000000FFFFFFFF)) << 32) | ((value & UINT64_C(0xFFFFFFFF00000000)) >> 32);
+    value = ((value & UINT64_C(0x0000FFFF0000FFFF)) << 16) | ((value & UINT64_C(0xFFFF0000FFFF0000)) >> 16);
+    value = ((value & UINT64_C(0x00FF00FF00FF00FF)) << 8) | ((value & UINT64_C(0xFF00FF00FF00FF00)) >> 8);
+#endif
+    return value;
+  }
+
+  /**
+   * Returns true if all eight characters of a word from ``load_eight_chars`` are
+   * decimal digits. Adding 6 carries out of the low nibble of any byte above '9'.
+   */
+  inline bool is_eight_digits(uint64_t chars) {
+    return ((chars & UINT64_C(0xF0F0F0F0F0F0F0F0)) |
+            (((chars + UINT64_C(0x0606060606060606)) & UINT64_C(0xF0F0F0F0F0F0F0F0)) >> 4)) ==
+           UINT64_C(0x3333333333333333);
+  }
+
+  /**
+   * Returns the value of eight decimal digits from ``load_eight_chars``, combining
+   * pairs of digits, then pairs of pairs, then pairs of those, with multiplies.
+   */
+  inline uint32_t parse_eight_digits(uint64_t chars) {
+    chars -= UINT64_C(0x3030303030303030);
+    chars = (chars * 10) + (chars >> 8);
+    chars = (((chars & UINT64_C(0x000000FF000000FF)) * UINT64_C(0x000F424000000064)) +
+             (((chars >> 16) & UINT64_C(0x000000FF000000FF)) * UINT64_C(0x0000271000000001))) >>
+            32;
+    return static_cast<uint32_t>(chars);
+  }
+
+} // namespace dynd::detail
+
+/**
+ * If ``[begin, end)`` is one to nineteen decimal digits, which always fit in a
+ * uint64, sets ``out`` to their value and returns true. The digits are consumed
+ * eight at a time.
+ */
+inline bool parse_uint64_digits(const char *begin, const char *end, uint64_t &out) {
+  if (begin == end || end - begin > 19) {
+    return false;
+  }
+
+  uint64_t value = 0;
+  for (; end - begin >= 8; begin += 8) {
+    uint64_t chars = detail::load_eight_chars(begin);
+    if (!detail::is_eight_digits(chars)) {
+      return false;
+    }
+    value = value * 100000000 + detail::parse_eight_digits(chars);
+  }
+  for (; begin != end; ++begin) {
+    unsigned int digit = static_cast<unsigned char>(*begin) - '0';
+    if (digit > 9) {
+      return false;
+    }
+    value = value * 10 + digit;
+  }
+
+  out = value;
+  return true;
+}
+
+/**
+ * If ``[begin, end)`` is a decimal number with an optional sign, fraction and
+ * exponent, sets ``out`` to the nearest floating point value and returns true.
+ * Returns false for anything else, such as hexadecimal or named values.
+ *
+ * The value is computed with the Eisel-Lemire algorithm, which multiplies the
+ * first nineteen significant digits by a 128-bit approximation of a power of ten.
+ * In the rare cases where that can't decide the rounding, ``strtod`` is used.
+ */
+DYNDT_API bool parse_decimal_number(const char *begin, const char *end, double &out);
+DYNDT_API bool parse_decimal_number(const char *begin, const char *end, float &out);
+
+/**
+ * Other floating point types, such as float16 and float128, aren't handled.
+ */
+template <typename T>
+bool parse_decimal_number(const char *DYND_UNUSED(begin), const char *DYND_UNUSED(end), T &DYND_UNUSED(out)) {
+  return false;
+}
+
+} // namespace dynd
@@ -9,6 +9,7 @@
 #include <string>
 
 #include <dynd/config.hpp>
+#include <dynd/number_parse.hpp>
 #include <dynd/string_encodings.hpp>
 #include <dynd/type.hpp>
 #include <dynd/types/option_type.hpp>
@@ -746,6 +747,11 @@ std::enable_if_t<is_boolean<T>::value, T> parse(const char *begin, const char *e
 template <typename T>
 std::enable_if_t<is_unsigned<T>::value && is_integral<T>::value && !is_boolean<T>::value, T>
 parse(const char *begin, const char *end, nocheck_t DYND_UNUSED(nocheck)) {
+  uint64_t digits;
+  if (parse_uint64_digits(begin, end, digits)) {
+    return static_cast<T>(digits);
+  }
+
   T result = 0;
   while (begin < end) {
     char c = *begin;
@@ -856,7 +862,11 @@ std::enable_if_t<is_floating_point<T>::value, T> parse(const char *begin, const
     }
   }
 
-  // TODO: use http://www.netlib.org/fp/dtoa.c
+  T value;
+  if (parse_decimal_number(begin, end, value)) {
+    return value;
+  }
+
   char *end_ptr;
   std::string s(begin, end);
   return strtod(s.c_str(), &end_ptr);
@@ -928,6 +938,19 @@ std::enable_if_t<is_unsigned<T>::value && is_integral<T>::value && !is_boolean<T
   if (begin == end) {
     raise_string_cast_error(ndt::make_type<T>(), begin, end);
   }
+
+  // Plain digits that fit in a uint64 only need a range check
+  uint64_t digits;
+  if (parse_uint64_digits(begin, end, digits)) {
+    if (is_overflow<T>(digits)) {
+      std::stringstream ss;
+      ss << "overflow converting string ";
+      ss.write(begin, end - begin);
+      ss << " to " << ndt::make_type<T>();
+      throw std::out_of_range(ss.str());
+    }
+    return static_cast<T>(digits);
+  }
   while (begin < end) {
     char c = *begin;
     if ('0' <= c && c <= '9') {
@@ -1069,9 +1092,13 @@ std::enable_if_t<is_floating_point<T>::value, T> parse(const char *begin, const
     }
   }
 
-  // TODO: use http://www.netlib.org/fp/dtoa.c
+  T value;
+  if (parse_decimal_number(begin, end, value)) {
+    return value;
+  }
+
   char *end_ptr;
-  T value = strto<T>(begin, &end_ptr);
+  value = strto<T>(begin, &end_ptr);
   if (end_ptr - begin != end - begin) {
     std::stringstream ss;
     ss << "parse error converting string ";
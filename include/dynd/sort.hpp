@@ -11,6 +11,16 @@ namespace dynd {
 namespace nd {
 
   extern DYND_API callable sort;
+
+  /**
+   * Returns the distinct values of a fixed dimension as a new ``var`` dimension,
+   * in the order they first appear. The argument is left unchanged, so to
+   * replace an array by its distinct values, assign the result back to it.
+   *
+   * With ``counts: true`` and/or ``inverse: true``, the result is a struct of
+   * ``values`` and the occurrence count of each value and/or the index into
+   * ``values`` of each element of the argument.
+   */
   extern DYND_API callable unique;
 
 } // namespace dynd::nd
@@ -169,9 +169,22 @@ namespace nd {
   extern DYND_API callable string_rfind;
   extern DYND_API callable string_replace;
   extern DYND_API callable string_split;
+
+  /**
+   * Splits strings like ``string_split``, but returns the byte offsets ``[begin, end)``
+   * of each piece as a ``var * 2 * intptr`` array instead of copying the pieces.
+   */
+  extern DYND_API callable string_split_offsets;
   extern DYND_API callable string_startswith;
   extern DYND_API callable string_endswith;
   extern DYND_API callable string_contains;
 
+  /**
+   * Returns whether each string contains any of the strings in the ``patterns``
+   * keyword argument, matching all of them in a single pass. Empty patterns never
+   * match.
+   */
+  extern DYND_API callable string_contains_any;
+
 } // namespace dynd::nd
 } // namespace dynd
@@ -98,6 +98,27 @@ get_next_unicode_codepoint_function(string_encoding_t encoding, assign_error_mod
 DYNDT_API append_unicode_codepoint_t
 get_append_unicode_codepoint_function(string_encoding_t encoding, assign_error_mode errmode);
 
+/**
+ * Typedef for copying the leading run of ASCII characters, other than NUL, from a
+ * string of one encoding to a string of another, as many as fit. These characters
+ * have the same code unit values in every encoding, so many of them are converted
+ * per step without decoding.
+ *
+ * On exit, 'dst' and 'src' are updated in-place to be after the copied characters,
+ * at the first character the per-codepoint functions have to handle.
+ */
+typedef void (*transcode_ascii_t)(char *&dst, char *dst_end, const char *&src, const char *src_end);
+
+DYNDT_API transcode_ascii_t get_transcode_ascii_function(string_encoding_t dst_encoding,
+                                                         string_encoding_t src_encoding);
+
+/**
+ * Checks that the bytes are valid UTF-8, raising the same errors as the checked
+ * UTF-8 ``next_unicode_codepoint_t`` would. Runs of ASCII are checked 16 or 32 bytes
+ * at a time.
+ */
+DYNDT_API void validate_utf8_string(const char *begin, const char *end);
+
 /**
  * Converts a string buffer provided as a range of bytes into a std::string as UTF8.
  */
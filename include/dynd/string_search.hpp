@@ -5,12 +5,62 @@
 
 #pragma once
 
+#include <utility>
+#include <vector>
+
+#include <dynd/config.hpp>
+
 ////////////////////////////////////////////////////////////
 // String algorithms
 
 namespace dynd {
 namespace detail {
 
+  /**
+   * Needles up to this many bytes are searched for by ``string_find_short``, longer
+   * ones with the skip table of ``string_search``.
+   */
+  const size_t string_search_short_needle_size = 32;
+
+  /**
+   * Returns the byte index of the first occurrence of a needle of at least two
+   * bytes in the haystack, or -1 if there is none.
+   *
+   * Candidate positions are those where both the first and the last byte of the
+   * needle match, found 32 positions at a time with AVX2 where the processor
+   * supports it, 16 at a time with SSE2 otherwise, and with ``memchr`` on other
+   * architectures. Only at candidates is the rest of the needle compared.
+   */
+  DYND_API intptr_t string_find_short(const char *haystack, size_t n, const char *needle, size_t m);
+
+  /**
+   * An Aho-Corasick automaton, which finds whether any of a set of patterns occurs
+   * in a string in one pass over it, one table lookup per byte.
+   *
+   * The bytes of the alphabet are first mapped to classes, with all bytes that
+   * don't appear in a pattern sharing one, which keeps the table of transitions
+   * small enough for hundreds of patterns. Empty patterns never match, as with
+   * ``string_contains``.
+   */
+  class DYND_API aho_corasick {
+    uint16_t m_classes[256];
+    size_t m_nclasses;
+    // The next state for each state and class, with the root as state 0
+    std::vector<uint32_t> m_transitions;
+    // Whether reaching each state means a pattern has been matched
+    std::vector<char> m_accepting;
+
+  public:
+    aho_corasick() : m_nclasses(0) {}
+
+    /**
+     * Builds the automaton for the patterns, given as pointers and sizes.
+     */
+    void assign(const std::vector<std::pair<const char *, size_t>> &patterns);
+
+    bool contains_any(const char *begin, const char *end) const;
+  };
+
   class bloom_filter_t {
     uint64_t m_mask;
 
@@ -43,7 +93,7 @@ namespace detail {
     else {
       const char *s = haystack;
       while (s < haystack + n) {
-        void *candidate = memchr((void *)s, needle, n);
+        void *candidate = memchr((void *)s, needle, haystack + n - s);
         if (candidate == NULL) {
           return;
         }
@@ -108,6 +158,17 @@ namespace detail {
       return;
     }
 
+    if (m <= string_search_short_needle_size) {
+      // Matches don't overlap, so the search resumes after each one
+      for (size_t pos = 0;;) {
+        intptr_t match = string_find_short(s + pos, n - pos, p, m);
+        if (match < 0 || handle_match(pos + match)) {
+          return;
+        }
+        pos += match + m;
+      }
+    }
+
     intptr_t mlast = m - 1;
     intptr_t skip = mlast - 1;
 
@@ -146,7 +207,9 @@ namespace detail {
           if (handle_match(i)) {
             return;
           }
+          // Resume right after the match, as the next one may start there
           i = i + mlast;
+          continue;
         }
         /* miss: check if next character is part of pattern */
         if (i < w && !bloom.has_char(ss[i + 1])) {
@@ -331,39 +394,46 @@ namespace detail {
     void finish() { DYND_MEMCPY(m_dst, m_src + m_last_src_start, m_src_size - m_last_src_start); }
   };
 
-  template <class StringType>
+  /**
+   * Passes the byte offsets ``(begin, end)`` of each piece of a string between
+   * matches of a separator to ``handle_piece``, in order, as ``string_search``
+   * finds the matches.
+   */
+  template <class PieceHandler>
   struct string_splitter {
-    StringType *m_dst;
-    const char *m_src;
+    PieceHandler &m_handle_piece;
     size_t m_src_size;
-    size_t m_i;
-    size_t m_last_src_start;
     size_t m_split_size;
+    size_t m_last_src_start;
 
-    string_splitter(StringType *dst, const StringType &src, const StringType &split)
-        : m_dst(dst), m_src(src.begin()), m_src_size(src.size()), m_i(0), m_last_src_start(0),
-          m_split_size(split.size())
+    string_splitter(PieceHandler &handle_piece, size_t src_size, size_t split_size)
+        : m_handle_piece(handle_piece), m_src_size(src_size), m_split_size(split_size), m_last_src_start(0)
     {
     }
 
     bool operator()(const size_t match)
     {
-      size_t new_size = match - m_last_src_start;
-
-      m_dst[m_i].assign(m_src + m_last_src_start, new_size);
-      m_last_src_start += new_size + m_split_size;
-      m_i++;
+      m_handle_piece(m_last_src_start, match);
+      m_last_src_start = match + m_split_size;
 
       return false;
     }
 
-    void finish()
-    {
-      size_t new_size = m_src_size - m_last_src_start;
-
-      m_dst[m_i].assign(m_src + m_last_src_start, new_size);
-    }
+    void finish() { m_handle_piece(m_last_src_start, m_src_size); }
   };
 
+  /**
+   * Splits ``src`` on ``split`` in a single pass, calling ``handle_piece(begin, end)``
+   * for every piece. A string without matches is a single piece.
+   */
+  template <class StringType, class PieceHandler>
+  void string_split(const StringType &src, const StringType &split, PieceHandler &handle_piece)
+  {
+    string_splitter<PieceHandler> f(handle_piece, src.size(), split.size());
+
+    string_search(src, split, f);
+    f.finish();
+  }
+
 } // namespace detail
 } // namespace nd
@@ -0,0 +1,33 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <functional>
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+
+/**
+ * Evaluates ``func(begin, end)`` over disjoint subranges that together cover
+ * [0, size), using up to ``nthreads`` threads including the calling one. Each
+ * thread starts with an equal share of the range and takes chunks of at least
+ * ``grain`` from it, stealing half of another thread's remaining work once its
+ * own is exhausted. The worker threads are kept in a process wide pool.
+ *
+ * If ``func`` throws, the remaining chunks are abandoned and the first exception
+ * is rethrown in the calling thread. Calls made from within ``func``, or while
+ * another thread is using the pool, run serially in the calling thread.
+ */
+DYND_API void parallel_for(size_t nthreads, size_t size, size_t grain,
+                           const std::function<void(size_t, size_t)> &func);
+
+/**
+ * Returns true if the calling thread is evaluating the body of a parallel_for.
+ */
+DYND_API bool in_parallel_region();
+
+} // namespace dynd
@@ -7,7 +7,10 @@
 
 #pragma once
 
+#include <vector>
+
 #include <dynd/array.hpp>
+#include <dynd/eval/eval_context.hpp>
 #include <dynd/type.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
 
@@ -31,6 +34,12 @@ namespace ndt {
     nd::array m_category_index_to_value;
     // mapping from values to category indices
     nd::array m_value_to_category_index;
+    // open addressing table of category index plus one by the hash of the category's bytes, with zero marking an
+    // empty slot, or empty if the category type can't be hashed that way
+    std::vector<intptr_t> m_category_table;
+
+    void build_category_table();
+    intptr_t find_category_index(const char *category_arrmeta, const char *category_data) const;
 
   public:
     categorical_type(type_id_t new_id, const nd::array &categories, bool presorted = false);
@@ -59,6 +68,22 @@ namespace ndt {
     uint32_t get_value_from_category(const char *category_arrmeta, const char *category_data) const;
     uint32_t get_value_from_category(const nd::array &category) const;
 
+    /**
+     * Encodes ``count`` values of the category type, strided by ``src_stride``, as
+     * values of this type strided by ``dst_stride``. String, fixed string/bytes,
+     * boolean and integer categories are looked up by hash, using up to
+     * ``ectx->nthreads`` threads for long runs. Other categories are looked up
+     * serially. Raises std::runtime_error for an unrecognized value.
+     */
+    void encode(size_t count, char *dst, intptr_t dst_stride, const char *src_arrmeta, const char *src,
+                intptr_t src_stride, const eval::eval_context *ectx = &eval::default_eval_context) const;
+
+    /**
+     * Encodes a one-dimensional array of values as a ``N * categorical`` array,
+     * converting them to the category type first if needed.
+     */
+    nd::array encode(const nd::array &values, const eval::eval_context *ectx = &eval::default_eval_context) const;
+
     const char *get_category_data_from_value(uint32_t value) const {
       if (value >= get_category_count()) {
         throw std::runtime_error("category value is out of bounds");
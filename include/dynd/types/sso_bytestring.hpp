@@ -16,6 +16,10 @@ namespace dynd {
  * The overall strategy of the implementation is to provide an internal `is_sso()` function to identify whether storage
  * is using SSO, then have code paths that use the `sso_*` and `heap_*` functions to do their things with no additional
  * checking for whether SSO is active.
+ *
+ * A heap buffer may also come from an arena, such as the string arena of the memory block holding an array of strings.
+ * Such buffers are flagged in their stored capacity and are never freed by the bytestring, the arena frees them all at
+ * once. A bytestring using one must not outlive the arena, so moving from it makes a copy and empties it.
  */
 template <size_t NulPadding>
 class sso_bytestring {
@@ -47,8 +51,16 @@ protected:
   /** When SSO is not used, the data pointer after a size_t in the data buffer */
   char *heap_data() { return heap_buffer() + sizeof(size_t); }
   const char *heap_data() const { return heap_buffer() + sizeof(size_t); }
-  /** When SSO is not used, the capacity is stored at the start of the data buffer */
-  size_t heap_capacity() const { return *reinterpret_cast<const size_t *>(heap_buffer()); }
+  /** When SSO is not used, the capacity is stored at the start of the data buffer, with the top bit flagging an arena */
+  static constexpr size_t arena_flag = ~(~static_cast<size_t>(0) >> 1);
+  size_t heap_capacity() const { return *reinterpret_cast<const size_t *>(heap_buffer()) & ~arena_flag; }
+  bool is_arena() const { return !is_sso() && (*reinterpret_cast<const size_t *>(heap_buffer()) & arena_flag) != 0; }
+  /** Frees the heap buffer, unless it belongs to an arena */
+  void heap_free() {
+    if (!is_sso() && !is_arena()) {
+      delete[] heap_buffer();
+    }
+  }
   /**
    * When the object has no memory allocated straight heap assignment overwriting existing data.
    * NOTE: If it throws (memory allocation failure), it hasn't written into `this`.
@@ -77,6 +89,16 @@ public:
   }
 
   sso_bytestring(sso_bytestring &&rhs) {
+    if (rhs.is_arena()) {
+      if (rhs.size() <= sso_capacity()) {
+        sso_assign(rhs.data(), rhs.size());
+      } else {
+        heap_assign(rhs.data(), rhs.size());
+      }
+      rhs.m_pointer = 0;
+      rhs.m_size = 0;
+      return;
+    }
     m_pointer = rhs.m_pointer;
     m_size = rhs.m_size;
     rhs.m_pointer = 0;
@@ -91,11 +113,7 @@ public:
     }
   }
 
-  ~sso_bytestring() {
-    if (!is_sso()) {
-      delete[] heap_buffer();
-    }
-  }
+  ~sso_bytestring() { heap_free(); }
 
   /** The size of the string in bytes */
   size_t size() const { return is_sso() ? sso_size() : heap_size(); }
@@ -123,9 +141,34 @@ public:
       m_size = ~static_cast<int64_t>(size);
     } else {
       char *buffer = heap_buffer();
+      bool arena = is_arena();
       heap_assign(bytestr, size);
-      delete[] buffer;
+      if (!arena) {
+        delete[] buffer;
+      }
+    }
+  }
+
+  /**
+   * Assigns the provided byte string by value, taking a heap buffer if one is needed from ``arena.alloc(count)``,
+   * which must return ``count`` bytes aligned for a size_t that stay valid for as long as this bytestring does.
+   */
+  template <typename Arena>
+  void assign(const char *bytestr, size_t size, Arena &arena) {
+    if (size <= capacity()) {
+      assign(bytestr, size);
+      return;
+    }
+
+    char *buffer = arena.alloc(size + sizeof(size_t) + NulPadding);
+    *reinterpret_cast<size_t *>(buffer) = size | arena_flag;
+    DYND_MEMCPY(buffer + sizeof(size_t), bytestr, size);
+    if (NulPadding) {
+      buffer[sizeof(size_t) + size] = 0;
     }
+    heap_free();
+    m_pointer = reinterpret_cast<intptr_t>(buffer);
+    m_size = ~static_cast<int64_t>(size);
   }
 
   sso_bytestring &operator=(const sso_bytestring &rhs) {
@@ -134,9 +177,13 @@ public:
   }
 
   sso_bytestring &operator=(sso_bytestring &&rhs) {
-    if (!is_sso()) {
-      delete[] heap_buffer();
+    if (rhs.is_arena()) {
+      assign(rhs.data(), rhs.size());
+      rhs.m_pointer = 0;
+      rhs.m_size = 0;
+      return *this;
     }
+    heap_free();
     m_pointer = rhs.m_pointer;
     m_size = rhs.m_size;
     rhs.m_pointer = 0;
@@ -151,9 +198,7 @@ public:
   }
 
   void clear() {
-    if (!is_sso()) {
-      delete[] heap_buffer();
-    }
+    heap_free();
     m_pointer = 0;
     m_size = 0;
   }
@@ -165,9 +210,7 @@ public:
       char *new_data = new char[new_capacity + sizeof(size_t) + NulPadding];
       *reinterpret_cast<size_t *>(new_data) = new_capacity;
       DYND_MEMCPY(new_data + sizeof(size_t), data(), current_size + NulPadding);
-      if (!is_sso()) {
-        delete[] heap_buffer();
-      }
+      heap_free();
       m_size = ~static_cast<int64_t>(current_size);
       m_pointer = reinterpret_cast<intptr_t>(new_data);
     }
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <dynd/bytes.hpp>
+#include <dynd/memblock/base_memory_block.hpp>
 #include <dynd/string_encodings.hpp>
 #include <dynd/type.hpp>
 #include <dynd/types/sso_bytestring.hpp>
@@ -93,6 +94,13 @@ namespace ndt {
     void get_string_range(const char **out_begin, const char **out_end, const char *arrmeta, const char *data) const;
     void set_from_utf8_string(const char *arrmeta, char *dst, const char *utf8_begin, const char *utf8_end,
                               const eval::eval_context *ectx) const;
+    /**
+     * Like ``set_from_utf8_string``, but any heap buffer the string needs comes
+     * from ``string_arena`` if it isn't NULL, and with error checking on, valid
+     * input is copied without a temporary.
+     */
+    void set_from_utf8_string(const char *arrmeta, char *dst, const char *utf8_begin, const char *utf8_end,
+                              nd::base_memory_block *string_arena, const eval::eval_context *ectx) const;
 
     void print_data(std::ostream &o, const char *arrmeta, const char *data) const;
 
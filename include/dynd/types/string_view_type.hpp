@@ -0,0 +1,148 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+// The string_view type points at UTF-8 bytes held by another memory block
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+
+#include <dynd/memory_block.hpp>
+#include <dynd/types/string_type.hpp>
+
+namespace dynd {
+
+/**
+ * A string that refers to bytes it doesn't own, as a pointer and a size. This is the
+ * layout of a ``string_view`` element, whose bytes are kept alive by the memory
+ * block referenced from its arrmeta.
+ */
+class string_view {
+  const char *m_begin;
+  size_t m_size;
+
+public:
+  /** Default-constructs to an empty view */
+  string_view() : m_begin(NULL), m_size(0) {}
+
+  string_view(const char *data, size_t size) : m_begin(data), m_size(size) {}
+
+  /** Views the bytes of a string, for as long as the string is unchanged */
+  string_view(const string &other) : m_begin(other.data()), m_size(other.size()) {}
+
+  const char *data() const { return m_begin; }
+  size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  const char *begin() const { return m_begin; }
+  const char *end() const { return m_begin + m_size; }
+
+  /** Copies the viewed bytes into a string */
+  explicit operator string() const { return string(m_begin, m_size); }
+
+  bool operator==(const string_view &rhs) const {
+    return m_size == rhs.m_size && (m_size == 0 || memcmp(m_begin, rhs.m_begin, m_size) == 0);
+  }
+
+  bool operator!=(const string_view &rhs) const { return !operator==(rhs); }
+
+  bool operator<(const string_view &rhs) const {
+    return std::lexicographical_compare(begin(), end(), rhs.begin(), rhs.end());
+  }
+
+  bool operator<=(const string_view &rhs) const {
+    return !std::lexicographical_compare(rhs.begin(), rhs.end(), begin(), end());
+  }
+
+  bool operator>=(const string_view &rhs) const {
+    return !std::lexicographical_compare(begin(), end(), rhs.begin(), rhs.end());
+  }
+
+  bool operator>(const string_view &rhs) const {
+    return std::lexicographical_compare(rhs.begin(), rhs.end(), begin(), end());
+  }
+};
+
+struct DYNDT_API string_view_type_arrmeta {
+  /**
+   * A reference to the memory block which holds the viewed bytes.
+   */
+  nd::memory_block blockref;
+};
+
+namespace ndt {
+
+  /**
+   * A UTF-8 string stored as a pointer and size into the bytes of another memory
+   * block, such as the input a JSON document was parsed from or the string a
+   * ``string_split`` result was split from, so that making one doesn't copy them.
+   *
+   * Assigning a ``string`` or a view of another memory block copies the bytes into
+   * the memory block of the destination's arrmeta.
+   */
+  class DYNDT_API string_view_type : public base_string_type {
+  private:
+    const string_encoding_t m_encoding{string_encoding_utf_8};
+    const std::string m_encoding_repr{encoding_as_string(string_encoding_utf_8)};
+
+  public:
+    typedef string_view data_type;
+    typedef string_view_type_arrmeta metadata_type;
+
+    string_view_type(type_id_t id)
+        : base_string_type(id, sizeof(string_view), alignof(string_view), type_flag_zeroinit | type_flag_blockref,
+                           sizeof(string_view_type_arrmeta)) {}
+
+    string_encoding_t get_encoding() const { return m_encoding; }
+
+    void get_string_range(const char **out_begin, const char **out_end, const char *arrmeta, const char *data) const;
+    /**
+     * Copies the string into the memory block of the arrmeta and views the copy.
+     * The views sharing that block each cost a bump allocation, not a heap one.
+     */
+    void set_from_utf8_string(const char *arrmeta, char *dst, const char *utf8_begin, const char *utf8_end,
+                              const eval::eval_context *ectx) const;
+
+    void print_data(std::ostream &o, const char *arrmeta, const char *data) const;
+
+    void print_type(std::ostream &o) const;
+
+    bool is_unique_data_owner(const char *arrmeta) const;
+    type get_canonical_type() const;
+
+    void get_shape(intptr_t ndim, intptr_t i, intptr_t *out_shape, const char *arrmeta, const char *data) const;
+
+    std::map<std::string, std::pair<ndt::type, const char *>> get_dynamic_type_properties() const;
+
+    bool is_lossless_assignment(const type &dst_tp, const type &src_tp) const;
+
+    bool operator==(const base_type &rhs) const;
+
+    void arrmeta_default_construct(char *arrmeta, bool blockref_alloc) const;
+    void arrmeta_copy_construct(char *dst_arrmeta, const char *src_arrmeta,
+                                const nd::memory_block &embedded_reference) const;
+    void arrmeta_reset_buffers(char *arrmeta) const;
+    void arrmeta_destruct(char *arrmeta) const;
+    void arrmeta_debug_print(const char *arrmeta, std::ostream &o, const std::string &indent) const;
+  };
+
+  template <>
+  struct id_of<string_view> : std::integral_constant<type_id_t, string_view_id> {};
+
+  template <>
+  struct id_of<string_view_type> : std::integral_constant<type_id_t, string_view_id> {};
+
+  template <>
+  struct traits<string_view> {
+    static const size_t ndim = 0;
+
+    static const bool is_same_layout = true;
+
+    static type equivalent() { return make_type<string_view_type>(); }
+  };
+
+} // namespace dynd::ndt
+} // namespace dynd
@@ -45,9 +45,13 @@ namespace ndt {
     std::vector<std::pair<type, std::string>> m_field_tp;
     std::vector<type> m_field_types;
     std::vector<uintptr_t> m_arrmeta_offsets;
+    // An open addressing table of field index plus one by name hash, with zero marking an empty slot
+    std::vector<intptr_t> m_field_name_table;
 
     bool m_variadic;
 
+    void build_field_name_table();
+
   public:
     struct_type(type_id_t id, const std::vector<std::string> &field_names, const std::vector<type> &field_types,
                 bool variadic = false)
@@ -90,6 +94,8 @@ namespace ndt {
       for (intptr_t i = 0; i < m_field_count; ++i) {
         m_field_tp.emplace_back(field_types[i], field_names[i]);
       }
+
+      build_field_name_table();
     }
 
     struct_type(type_id_t id, const std::vector<std::pair<type, std::string>> &fields, bool variadic = false)
@@ -123,7 +129,16 @@ namespace ndt {
      * \returns  The field index, or -1 if there is no field
      *           of the given name.
      */
-    intptr_t get_field_index(const std::string &field_name) const;
+    intptr_t get_field_index(const std::string &field_name) const {
+      return get_field_index(field_name.data(), field_name.data() + field_name.size());
+    }
+
+    /**
+     * Gets the field index for the name in the UTF-8 range ``[name_begin, name_end)``
+     * using a hash table built with the type, without allocating. Returns -1 if
+     * the struct doesn't have a field of the given name.
+     */
+    intptr_t get_field_index(const char *name_begin, const char *name_end) const;
 
     /**
      * Gets the field type for the given name. Raises std::invalid_argument if
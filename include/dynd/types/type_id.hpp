@@ -68,6 +68,7 @@ enum type_id_t {
   fixed_string_id, // A NULL-terminated string buffer of a fixed size
   char_id,         // A single string character
   string_id,       // A variable-sized string type
+  string_view_id,  // A string referring to bytes in another memory block
 
   // A tuple type with variable layout
   tuple_id,
@@ -16,8 +16,9 @@ using namespace dynd;
 
 namespace {
 
-static std::vector<ndt::type> func_ptr(const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *src_tp) {
-  return {dst_tp, src_tp[0]};
+static void func_ptr(const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *src_tp, ndt::type *res_tp) {
+  res_tp[0] = dst_tp;
+  res_tp[1] = src_tp[0];
 }
 
 template <typename VariadicType, template <typename, typename, VariadicType...> class T>
@@ -39,6 +40,9 @@ nd::callable make_assign() {
       nd::callable::make_all<helper_bind<assign_error_mode, nd::assign_callable>::type, numeric_types, numeric_types>(
           func_ptr);
   dispatcher.insert(nd::make_callable<nd::assign_callable<dynd::string, dynd::string>>());
+  dispatcher.insert(nd::make_callable<nd::assign_callable<dynd::string, dynd::string_view>>());
+  dispatcher.insert(nd::make_callable<nd::assign_callable<dynd::string_view, dynd::string>>());
+  dispatcher.insert(nd::make_callable<nd::assign_callable<dynd::string_view, dynd::string_view>>());
   dispatcher.insert(nd::make_callable<nd::assign_callable<dynd::bytes, dynd::bytes>>());
   dispatcher.insert(nd::make_callable<nd::assign_callable<ndt::fixed_bytes_type, ndt::fixed_bytes_type>>());
   dispatcher.insert(nd::make_callable<nd::assign_callable<ndt::fixed_string_type, ndt::fixed_string_type>>());
@@ -3,17 +3,181 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <algorithm>
+
 #include <dynd/callables/base_callable.hpp>
 #include <dynd/callables/call_graph.hpp>
+#include <dynd/shortvector.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
 
 using namespace std;
 using namespace dynd;
 
+namespace {
+
+// Bounds on what a single callable keeps around
+const size_t max_cached_resolutions = 16;
+const size_t max_cached_kernels = 4;
+
+std::atomic<size_t> &call_cache_generation() {
+  static std::atomic<size_t> generation(0);
+  return generation;
+}
+
+/**
+ * Returns true if the arrmeta of ``tp`` holds only plain values, which is the
+ * case for builtin types nested in any number of fixed dimensions. Arrmeta with
+ * memory block references (var dims, pointers, ...) can't be compared or copied
+ * bytewise.
+ */
+bool has_pod_arrmeta(const ndt::type &tp) {
+  const ndt::type *el_tp = &tp;
+  while (el_tp->get_id() == fixed_dim_id) {
+    el_tp = &el_tp->extended<ndt::fixed_dim_type>()->get_element_type();
+  }
+
+  return el_tp->is_builtin();
+}
+
+} // anonymous namespace
+
 nd::base_callable::~base_callable() {}
 
+void nd::base_callable::invalidate_call_caches() { ++call_cache_generation(); }
+
+std::shared_ptr<nd::base_callable::cached_resolution>
+nd::base_callable::find_or_resolve(const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp,
+                                   const std::map<std::string, ndt::type> &tp_vars) {
+  size_t generation = call_cache_generation();
+
+  {
+    std::lock_guard<std::mutex> lock(m_cache_mutex);
+    if (m_cache_generation != generation) {
+      m_cache.clear();
+      m_cache_generation = generation;
+    }
+
+    for (auto it = m_cache.rbegin(); it != m_cache.rend(); ++it) {
+      const cached_resolution &res = **it;
+      if (res.src_tp.size() == nsrc && res.dst_tp == dst_tp &&
+          std::equal(res.src_tp.begin(), res.src_tp.end(), src_tp) && res.tp_vars == tp_vars) {
+        return *it;
+      }
+    }
+  }
+
+  // Resolve outside of the lock, as resolution may recursively call into other callables
+  std::shared_ptr<cached_resolution> res = std::make_shared<cached_resolution>();
+  res->dst_tp = dst_tp;
+  res->src_tp.assign(src_tp, src_tp + nsrc);
+  res->tp_vars = tp_vars;
+  res->res_tp = resolve(nullptr, nullptr, res->cg, dst_tp, nsrc, src_tp, 0, nullptr, tp_vars);
+  res->pod_arrmeta = has_pod_arrmeta(res->res_tp) && std::all_of(src_tp, src_tp + nsrc, has_pod_arrmeta);
+
+  std::lock_guard<std::mutex> lock(m_cache_mutex);
+  if (m_cache_generation == generation) {
+    if (m_cache.size() == max_cached_resolutions) {
+      m_cache.erase(m_cache.begin());
+    }
+    m_cache.push_back(res);
+  }
+
+  return res;
+}
+
+nd::base_callable::cached_kernel nd::base_callable::acquire_kernel(cached_resolution &res, kernel_request_t kernreq,
+                                                                   const ndt::type &dst_tp, const char *dst_arrmeta,
+                                                                   size_t nsrc, const ndt::type *src_tp,
+                                                                   const char *const *src_arrmeta) {
+  cached_kernel ck;
+  ck.kernreq = kernreq;
+  ck.pooled = res.pod_arrmeta && !res.cg.is_stateful() && has_pod_arrmeta(dst_tp);
+
+  if (!ck.pooled) {
+    // The arrmeta references memory blocks, or the kernel would carry state
+    // over from this call, so build a one-off kernel
+    ck.kb.reset(new kernel_builder(res.cg.get()));
+    (*ck.kb)(kernreq, nullptr, dst_arrmeta, nsrc, src_arrmeta);
+    return ck;
+  }
+
+  // Gather the dst and src arrmeta into one contiguous key
+  size_t dst_arrmeta_size = aligned_size(dst_tp.get_arrmeta_size());
+  size_t arrmeta_size = dst_arrmeta_size;
+  shortvector<size_t> src_arrmeta_offset(nsrc);
+  for (size_t i = 0; i < nsrc; ++i) {
+    src_arrmeta_offset[i] = arrmeta_size;
+    arrmeta_size += aligned_size(src_tp[i].get_arrmeta_size());
+  }
+
+  ck.arrmeta.resize(arrmeta_size);
+  if (dst_arrmeta_size != 0) {
+    memcpy(ck.arrmeta.data(), dst_arrmeta, dst_tp.get_arrmeta_size());
+  }
+  for (size_t i = 0; i < nsrc; ++i) {
+    if (src_tp[i].get_arrmeta_size() != 0) {
+      memcpy(ck.arrmeta.data() + src_arrmeta_offset[i], src_arrmeta[i], src_tp[i].get_arrmeta_size());
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_cache_mutex);
+    for (auto it = res.kernels.begin(); it != res.kernels.end(); ++it) {
+      if (it->kernreq == kernreq && it->arrmeta == ck.arrmeta) {
+        ck = std::move(*it);
+        res.kernels.erase(it);
+        return ck;
+      }
+    }
+  }
+
+  // Instantiate against our own copy of the arrmeta, which lives as long as the kernel
+  shortvector<const char *> child_src_arrmeta(nsrc);
+  for (size_t i = 0; i < nsrc; ++i) {
+    child_src_arrmeta[i] = ck.arrmeta.data() + src_arrmeta_offset[i];
+  }
+
+  ck.kb.reset(new kernel_builder(res.cg.get()));
+  (*ck.kb)(kernreq, nullptr, ck.arrmeta.data(), nsrc, child_src_arrmeta.get());
+
+  // A kernel that may keep anything from this call is used once, and never returned to the pool
+  ck.pooled = ck.kb->is_stateless();
+
+  return ck;
+}
+
+void nd::base_callable::release_kernel(cached_resolution &res, cached_kernel &&ck) {
+  if (!ck.pooled) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_cache_mutex);
+  if (res.kernels.size() == max_cached_kernels) {
+    res.kernels.erase(res.kernels.begin());
+  }
+  res.kernels.push_back(std::move(ck));
+}
+
 nd::array nd::base_callable::call(ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp,
                                   const char *const *src_arrmeta, char *const *src_data, size_t nkwd, const array *kwds,
                                   const std::map<std::string, ndt::type> &tp_vars) {
+  if (nkwd == 0) {
+    // Without keywords, the call graph depends only on the types, so it can be reused
+    std::shared_ptr<cached_resolution> res = find_or_resolve(dst_tp, nsrc, src_tp, tp_vars);
+    dst_tp = res->res_tp;
+
+    // Allocate the destination array
+    array dst = alloc(&dst_tp);
+
+    // Get a ckernel for this arrmeta and evaluate it
+    cached_kernel ck = acquire_kernel(*res, kernel_request_single, dst_tp, dst->metadata(), nsrc, src_tp, src_arrmeta);
+    kernel_single_t fn = ck.kb->get()->get_function<kernel_single_t>();
+    fn(ck.kb->get(), dst.data(), src_data);
+    release_kernel(*res, std::move(ck));
+
+    return dst;
+  }
+
   call_graph cg;
   dst_tp = resolve(nullptr, nullptr, cg, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
 
@@ -33,6 +197,22 @@ nd::array nd::base_callable::call(ndt::type &dst_tp, size_t nsrc, const ndt::typ
 nd::array nd::base_callable::call(ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp,
                                   const char *const *src_arrmeta, const array *src_data, size_t nkwd, const array *kwds,
                                   const std::map<std::string, ndt::type> &tp_vars) {
+  if (nkwd == 0) {
+    std::shared_ptr<cached_resolution> res = find_or_resolve(dst_tp, nsrc, src_tp, tp_vars);
+    dst_tp = res->res_tp;
+
+    // Allocate the destination array
+    array dst = empty(dst_tp);
+
+    // Get a kernel for this arrmeta and evaluate it
+    cached_kernel ck = acquire_kernel(*res, kernel_request_call, dst_tp, dst->metadata(), nsrc, src_tp, src_arrmeta);
+    kernel_call_t fn = ck.kb->get()->get_function<kernel_call_t>();
+    fn(ck.kb->get(), &dst, src_data);
+    release_kernel(*res, std::move(ck));
+
+    return dst;
+  }
+
   call_graph cg;
   dst_tp = resolve(nullptr, nullptr, cg, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
 
@@ -52,6 +232,18 @@ nd::array nd::base_callable::call(ndt::type &dst_tp, size_t nsrc, const ndt::typ
 void nd::base_callable::call(const ndt::type &dst_tp, const char *dst_arrmeta, char *dst_data, size_t nsrc,
                              const ndt::type *src_tp, const char *const *src_arrmeta, char *const *src_data,
                              size_t nkwd, const array *kwds, const std::map<std::string, ndt::type> &tp_vars) {
+  if (nkwd == 0) {
+    std::shared_ptr<cached_resolution> res = find_or_resolve(dst_tp, nsrc, src_tp, tp_vars);
+
+    // Get a ckernel for this arrmeta and evaluate it
+    cached_kernel ck = acquire_kernel(*res, kernel_request_single, dst_tp, dst_arrmeta, nsrc, src_tp, src_arrmeta);
+    kernel_single_t fn = ck.kb->get()->get_function<kernel_single_t>();
+    fn(ck.kb->get(), dst_data, src_data);
+    release_kernel(*res, std::move(ck));
+
+    return;
+  }
+
   call_graph cg;
   resolve(nullptr, nullptr, cg, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
 
@@ -66,6 +258,18 @@ void nd::base_callable::call(const ndt::type &dst_tp, const char *dst_arrmeta, c
 void nd::base_callable::call(const ndt::type &dst_tp, const char *dst_arrmeta, array *dst, size_t nsrc,
                              const ndt::type *src_tp, const char *const *src_arrmeta, const array *src, size_t nkwd,
                              const array *kwds, const std::map<std::string, ndt::type> &tp_vars) {
+  if (nkwd == 0) {
+    std::shared_ptr<cached_resolution> res = find_or_resolve(dst_tp, nsrc, src_tp, tp_vars);
+
+    // Get a ckernel for this arrmeta and evaluate it
+    cached_kernel ck = acquire_kernel(*res, kernel_request_call, dst_tp, dst_arrmeta, nsrc, src_tp, src_arrmeta);
+    kernel_call_t fn = ck.kb->get()->get_function<kernel_call_t>();
+    fn(ck.kb->get(), dst, src);
+    release_kernel(*res, std::move(ck));
+
+    return;
+  }
+
   call_graph cg;
   resolve(nullptr, nullptr, cg, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
 
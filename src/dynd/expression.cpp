@@ -0,0 +1,220 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <dynd/arithmetic.hpp>
+#include <dynd/callables/fused_callable.hpp>
+#include <dynd/expression.hpp>
+#include <dynd/functional.hpp>
+
+using namespace std;
+using namespace dynd;
+
+/**
+ * A node of an expression DAG, which is either a leaf holding an array or the
+ * application of a callable to other nodes.
+ */
+struct nd::expression::node {
+  array value;
+  callable f;
+  std::vector<std::shared_ptr<const node>> args;
+  // The type of the elements of the result, or null when that isn't known
+  // without evaluating the arguments
+  ndt::type dtype;
+  std::map<std::string, ndt::type> tp_vars;
+
+  bool is_leaf() const { return !f; }
+};
+
+namespace {
+
+typedef nd::expression::node node;
+
+/**
+ * The nodes of an expression in an order where every node comes after its
+ * arguments, visiting shared subexpressions and repeated arrays only once.
+ */
+struct linearized_expression {
+  std::vector<nd::array> leaves;
+  std::vector<const node *> ops;
+  std::map<const node *, size_t> index;
+  std::map<const void *, size_t> leaf_index;
+
+  void visit(const node *n) {
+    if (index.find(n) != index.end()) {
+      return;
+    }
+
+    if (n->is_leaf()) {
+      auto it = leaf_index.find(n->value.get());
+      if (it == leaf_index.end()) {
+        it = leaf_index.insert(std::make_pair(static_cast<const void *>(n->value.get()), leaves.size())).first;
+        leaves.push_back(n->value);
+      }
+      index[n] = it->second;
+      return;
+    }
+
+    for (const auto &arg : n->args) {
+      visit(arg.get());
+    }
+    index[n] = ops.size();
+    ops.push_back(n);
+  }
+
+  /** The argument number of a node in a fused program */
+  size_t get_arg(const node *n) const {
+    size_t i = index.find(n)->second;
+    return n->is_leaf() ? i : leaves.size() + i;
+  }
+};
+
+/**
+ * Builds the fused program for an expression, or returns null if it can't be fused.
+ */
+std::shared_ptr<const nd::functional::fused_program> make_fused_program(const linearized_expression &expr) {
+  if (expr.ops.empty() || expr.leaves.size() > nd::functional::max_fused_args) {
+    return nullptr;
+  }
+  for (const nd::array &leaf : expr.leaves) {
+    if (!leaf.get_dtype().is_builtin()) {
+      return nullptr;
+    }
+  }
+
+  std::vector<nd::functional::fused_step> steps;
+  for (const node *n : expr.ops) {
+    if (n->dtype.is_null() || n->args.size() > nd::functional::max_fused_args) {
+      return nullptr;
+    }
+
+    nd::functional::fused_step step;
+    step.f = n->f;
+    step.dst_tp = n->dtype;
+    step.tp_vars = n->tp_vars;
+    for (const auto &arg : n->args) {
+      step.src_tp.push_back(arg->dtype);
+      step.args.push_back(expr.get_arg(arg.get()));
+    }
+    steps.push_back(step);
+  }
+
+  std::shared_ptr<const nd::functional::fused_program> program =
+      std::make_shared<nd::functional::fused_program>(expr.leaves.size(), steps);
+  if (program->chunk_size == 0) {
+    return nullptr;
+  }
+
+  return program;
+}
+
+nd::array eval_node(const node *n, std::map<const node *, nd::array> &values) {
+  if (n->is_leaf()) {
+    return n->value;
+  }
+
+  auto it = values.find(n);
+  if (it != values.end()) {
+    return it->second;
+  }
+
+  std::vector<nd::array> args;
+  for (const auto &arg : n->args) {
+    args.push_back(eval_node(arg.get(), values));
+  }
+
+  nd::array value = n->f.call(args.size(), args.data(), 0, nullptr);
+  values[n] = value;
+  return value;
+}
+
+} // anonymous namespace
+
+nd::expression::expression(const array &value) {
+  std::shared_ptr<node> n = std::make_shared<node>();
+  n->value = value;
+  n->dtype = value.get_dtype();
+  m_node = n;
+}
+
+nd::expression::expression(const callable &f, std::initializer_list<expression> args) {
+  std::shared_ptr<node> n = std::make_shared<node>();
+  n->f = f;
+  for (const expression &arg : args) {
+    n->args.push_back(arg.m_node);
+  }
+
+  // Work out the result dtype from those of the arguments, which is possible for
+  // callables applied to builtin scalars
+  bool scalar = f->get_nkwd() == 0 && !f->is_arg_variadic() && f->get_narg() == n->args.size();
+  std::vector<ndt::type> arg_tp;
+  for (size_t i = 0; scalar && i < n->args.size(); ++i) {
+    const ndt::type &tp = n->args[i]->dtype;
+    scalar = !tp.is_null() && tp.is_builtin() && f->get_arg_types()[i].match(tp, n->tp_vars);
+    arg_tp.push_back(tp);
+  }
+
+  if (scalar) {
+    call_graph cg;
+    ndt::type dtype = f->resolve(nullptr, nullptr, cg, f->get_ret_type(), arg_tp.size(), arg_tp.data(), 0, nullptr,
+                                 n->tp_vars);
+    if (dtype.is_builtin()) {
+      n->dtype = dtype;
+    }
+  }
+
+  m_node = n;
+}
+
+const ndt::type &nd::expression::get_dtype() const { return m_node->dtype; }
+
+bool nd::expression::is_fusable() const {
+  linearized_expression expr;
+  expr.visit(m_node.get());
+
+  return make_fused_program(expr) != nullptr;
+}
+
+nd::array nd::expression::eval() const {
+  if (m_node->is_leaf()) {
+    return m_node->value;
+  }
+
+  linearized_expression expr;
+  expr.visit(m_node.get());
+
+  std::shared_ptr<const functional::fused_program> program = make_fused_program(expr);
+  if (program == nullptr) {
+    // Evaluate one callable at a time
+    std::map<const node *, array> values;
+    return eval_node(m_node.get(), values);
+  }
+
+  std::vector<ndt::type> src_tp;
+  for (const array &leaf : expr.leaves) {
+    src_tp.push_back(leaf.get_dtype());
+  }
+
+  callable fused = functional::elwise(make_callable<functional::fused_callable>(
+      ndt::make_type<ndt::callable_type>(m_node->dtype, src_tp), program));
+  return fused.call(expr.leaves.size(), expr.leaves.data(), 0, nullptr);
+}
+
+nd::expression nd::lazy(const array &a) { return expression(a); }
+
+nd::expression nd::operator+(const expression &a0) { return expression(plus, {a0}); }
+
+nd::expression nd::operator-(const expression &a0) { return expression(minus, {a0}); }
+
+nd::expression nd::operator+(const expression &op0, const expression &op1) { return expression(add, {op0, op1}); }
+
+nd::expression nd::operator-(const expression &op0, const expression &op1) {
+  return expression(subtract, {op0, op1});
+}
+
+nd::expression nd::operator*(const expression &op0, const expression &op1) {
+  return expression(multiply, {op0, op1});
+}
+
+nd::expression nd::operator/(const expression &op0, const expression &op1) { return expression(divide, {op0, op1}); }
@@ -0,0 +1,399 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Target/TargetMachine.h>
+
+#include <dynd/arithmetic.hpp>
+#include <dynd/jit.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+enum jit_op { jit_plus, jit_minus, jit_add, jit_subtract, jit_multiply, jit_divide };
+
+/** Returns the operation ``f`` computes, or false if the JIT doesn't know it */
+bool get_jit_op(const nd::callable &f, jit_op &op) {
+  static const pair<const nd::callable *, jit_op> ops[] = {
+      {&nd::plus, jit_plus},         {&nd::minus, jit_minus},       {&nd::add, jit_add},
+      {&nd::subtract, jit_subtract}, {&nd::multiply, jit_multiply}, {&nd::divide, jit_divide}};
+
+  for (const auto &p : ops) {
+    if (f.get() == p.first->get()) {
+      op = p.second;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool is_jit_type(const ndt::type &tp) {
+  switch (tp.get_id()) {
+  case int8_id:
+  case int16_id:
+  case int32_id:
+  case int64_id:
+  case uint8_id:
+  case uint16_id:
+  case uint32_id:
+  case uint64_id:
+  case float32_id:
+  case float64_id:
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool is_signed(const ndt::type &tp) {
+  switch (tp.get_id()) {
+  case int8_id:
+  case int16_id:
+  case int32_id:
+  case int64_id:
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool is_float(const ndt::type &tp) { return tp.get_id() == float32_id || tp.get_id() == float64_id; }
+
+llvm::Type *get_llvm_type(llvm::LLVMContext &context, const ndt::type &tp) {
+  switch (tp.get_id()) {
+  case float32_id:
+    return llvm::Type::getFloatTy(context);
+  case float64_id:
+    return llvm::Type::getDoubleTy(context);
+  default:
+    return llvm::IntegerType::get(context, 8 * tp.get_data_size());
+  }
+}
+
+/**
+ * Checks that the JIT can generate code for every step of ``program``, returning
+ * a string which identifies the code, or an empty string if it can't.
+ */
+std::string get_signature(const nd::functional::fused_program &program, vector<ndt::type> &src_tp) {
+  std::string signature = to_string(program.nsrc);
+  src_tp.assign(program.nsrc, ndt::type());
+  for (const nd::functional::fused_step &step : program.steps) {
+    jit_op op;
+    if (!get_jit_op(step.f, op) || !is_jit_type(step.dst_tp) || step.args.size() != step.src_tp.size() ||
+        step.args.size() != ((op == jit_plus || op == jit_minus) ? 1u : 2u)) {
+      return std::string();
+    }
+    // Integer division raises an exception on zero
+    if (op == jit_divide && !is_float(step.dst_tp)) {
+      return std::string();
+    }
+
+    signature += ";" + to_string(op) + ":" + to_string(step.dst_tp.get_id());
+    for (size_t i = 0; i < step.args.size(); ++i) {
+      if (!is_jit_type(step.src_tp[i])) {
+        return std::string();
+      }
+      // A float converted to an integer is something the arithmetic doesn't do
+      if (is_float(step.src_tp[i]) && !is_float(step.dst_tp)) {
+        return std::string();
+      }
+      if (step.args[i] < program.nsrc) {
+        src_tp[step.args[i]] = step.src_tp[i];
+      }
+      signature += "," + to_string(step.args[i]) + ":" + to_string(step.src_tp[i].get_id());
+    }
+  }
+
+  for (const ndt::type &tp : src_tp) {
+    if (tp.is_null()) {
+      return std::string();
+    }
+  }
+
+  return signature;
+}
+
+/**
+ * Generates the IR of a fused program, as a function which checks whether all
+ * arguments are contiguous and runs one of two loops. The contiguous one is what
+ * the loop vectorizer turns into SIMD code.
+ */
+class fused_codegen {
+  const nd::functional::fused_program &m_program;
+  const vector<ndt::type> &m_src_tp;
+  llvm::LLVMContext &m_context;
+  llvm::IRBuilder<> m_builder;
+
+  llvm::Value *convert(llvm::Value *value, const ndt::type &src_tp, const ndt::type &dst_tp) {
+    llvm::Type *dst_type = get_llvm_type(m_context, dst_tp);
+    if (is_float(dst_tp)) {
+      if (is_float(src_tp)) {
+        return m_builder.CreateFPCast(value, dst_type);
+      }
+      return is_signed(src_tp) ? m_builder.CreateSIToFP(value, dst_type) : m_builder.CreateUIToFP(value, dst_type);
+    }
+
+    return m_builder.CreateIntCast(value, dst_type, is_signed(src_tp));
+  }
+
+  llvm::Value *apply(const nd::functional::fused_step &step, const vector<llvm::Value *> &args) {
+    jit_op op;
+    get_jit_op(step.f, op);
+
+    vector<llvm::Value *> src;
+    for (size_t i = 0; i < args.size(); ++i) {
+      src.push_back(convert(args[i], step.src_tp[i], step.dst_tp));
+    }
+
+    bool fp = is_float(step.dst_tp);
+    switch (op) {
+    case jit_plus:
+      return src[0];
+    case jit_minus:
+      return fp ? m_builder.CreateFNeg(src[0]) : m_builder.CreateNeg(src[0]);
+    case jit_add:
+      return fp ? m_builder.CreateFAdd(src[0], src[1]) : m_builder.CreateAdd(src[0], src[1]);
+    case jit_subtract:
+      return fp ? m_builder.CreateFSub(src[0], src[1]) : m_builder.CreateSub(src[0], src[1]);
+    case jit_multiply:
+      return fp ? m_builder.CreateFMul(src[0], src[1]) : m_builder.CreateMul(src[0], src[1]);
+    case jit_divide:
+      return m_builder.CreateFDiv(src[0], src[1]);
+    }
+
+    return nullptr;
+  }
+
+  /** Returns the address of element ``i`` of an argument */
+  llvm::Value *get_element_ptr(llvm::Value *data, llvm::Value *stride, llvm::Type *type, llvm::Value *i,
+                               bool contiguous) {
+    if (contiguous) {
+      return m_builder.CreateInBoundsGEP(type, m_builder.CreateBitCast(data, type->getPointerTo()), i);
+    }
+
+    llvm::Value *ptr = m_builder.CreateGEP(m_builder.getInt8Ty(), data, m_builder.CreateMul(i, stride));
+    return m_builder.CreateBitCast(ptr, type->getPointerTo());
+  }
+
+  void emit_loop(llvm::Function *f, llvm::BasicBlock *exit, llvm::Value *dst, llvm::Value *dst_stride,
+                 const vector<llvm::Value *> &src, const vector<llvm::Value *> &src_stride, llvm::Value *count,
+                 bool contiguous) {
+    llvm::BasicBlock *preheader = m_builder.GetInsertBlock();
+    llvm::BasicBlock *loop = llvm::BasicBlock::Create(m_context, contiguous ? "contiguous" : "strided", f);
+    m_builder.CreateBr(loop);
+    m_builder.SetInsertPoint(loop);
+
+    llvm::PHINode *i = m_builder.CreatePHI(m_builder.getInt64Ty(), 2);
+    i->addIncoming(m_builder.getInt64(0), preheader);
+
+    vector<llvm::Value *> values;
+    for (size_t j = 0; j < m_program.nsrc; ++j) {
+      llvm::Type *type = get_llvm_type(m_context, m_src_tp[j]);
+      values.push_back(m_builder.CreateAlignedLoad(
+          type, get_element_ptr(src[j], src_stride[j], type, i, contiguous), llvm::MaybeAlign(1)));
+    }
+    for (const nd::functional::fused_step &step : m_program.steps) {
+      vector<llvm::Value *> args;
+      for (size_t arg : step.args) {
+        args.push_back(values[arg]);
+      }
+      values.push_back(apply(step, args));
+    }
+
+    llvm::Type *dst_type = get_llvm_type(m_context, m_program.steps.back().dst_tp);
+    m_builder.CreateAlignedStore(values.back(), get_element_ptr(dst, dst_stride, dst_type, i, contiguous),
+                                 llvm::MaybeAlign(1));
+
+    llvm::Value *next = m_builder.CreateAdd(i, m_builder.getInt64(1));
+    i->addIncoming(next, m_builder.GetInsertBlock());
+    m_builder.CreateCondBr(m_builder.CreateICmpULT(next, count), loop, exit);
+  }
+
+public:
+  fused_codegen(const nd::functional::fused_program &program, const vector<ndt::type> &src_tp,
+                llvm::LLVMContext &context)
+      : m_program(program), m_src_tp(src_tp), m_context(context), m_builder(context) {}
+
+  llvm::Function *emit(llvm::Module &module, const std::string &name) {
+    llvm::Type *i8_ptr = m_builder.getInt8PtrTy();
+    llvm::Type *i64 = m_builder.getInt64Ty();
+    llvm::FunctionType *tp = llvm::FunctionType::get(
+        m_builder.getVoidTy(), {i8_ptr, i64, i8_ptr->getPointerTo(), i64->getPointerTo(), i64}, false);
+    llvm::Function *f = llvm::Function::Create(tp, llvm::Function::ExternalLinkage, name, module);
+    f->addFnAttr(llvm::Attribute::NoUnwind);
+
+    llvm::Function::arg_iterator it = f->arg_begin();
+    llvm::Value *dst = &*it++;
+    llvm::Value *dst_stride = &*it++;
+    llvm::Value *src_data = &*it++;
+    llvm::Value *src_stride_data = &*it++;
+    llvm::Value *count = &*it++;
+
+    llvm::BasicBlock *entry = llvm::BasicBlock::Create(m_context, "entry", f);
+    llvm::BasicBlock *body = llvm::BasicBlock::Create(m_context, "body", f);
+    llvm::BasicBlock *contiguous = llvm::BasicBlock::Create(m_context, "check_contiguous", f);
+    llvm::BasicBlock *strided = llvm::BasicBlock::Create(m_context, "check_strided", f);
+    llvm::BasicBlock *exit = llvm::BasicBlock::Create(m_context, "exit", f);
+
+    m_builder.SetInsertPoint(entry);
+    m_builder.CreateCondBr(m_builder.CreateICmpEQ(count, m_builder.getInt64(0)), exit, body);
+
+    m_builder.SetInsertPoint(body);
+    vector<llvm::Value *> src, src_stride;
+    llvm::Value *is_contiguous =
+        m_builder.CreateICmpEQ(dst_stride, m_builder.getInt64(m_program.steps.back().dst_tp.get_data_size()));
+    for (size_t j = 0; j < m_program.nsrc; ++j) {
+      src.push_back(
+          m_builder.CreateLoad(i8_ptr, m_builder.CreateConstInBoundsGEP1_64(i8_ptr, src_data, j)));
+      src_stride.push_back(m_builder.CreateLoad(i64, m_builder.CreateConstInBoundsGEP1_64(i64, src_stride_data, j)));
+      is_contiguous = m_builder.CreateAnd(
+          is_contiguous, m_builder.CreateICmpEQ(src_stride.back(), m_builder.getInt64(m_src_tp[j].get_data_size())));
+    }
+    m_builder.CreateCondBr(is_contiguous, contiguous, strided);
+
+    m_builder.SetInsertPoint(contiguous);
+    emit_loop(f, exit, dst, dst_stride, src, src_stride, count, true);
+    m_builder.SetInsertPoint(strided);
+    emit_loop(f, exit, dst, dst_stride, src, src_stride, count, false);
+
+    m_builder.SetInsertPoint(exit);
+    m_builder.CreateRetVoid();
+
+    return f;
+  }
+};
+
+/**
+ * Owns the LLVM JIT and the code it has generated, which is kept for the life of
+ * the process.
+ */
+class jit_compiler {
+  std::mutex m_mutex;
+  std::unique_ptr<llvm::TargetMachine> m_target_machine;
+  std::unique_ptr<llvm::orc::LLJIT> m_jit;
+  std::map<std::string, nd::jit::strided_function> m_functions;
+
+  void optimize(llvm::Module &module) {
+    llvm::LoopAnalysisManager lam;
+    llvm::FunctionAnalysisManager fam;
+    llvm::CGSCCAnalysisManager cgam;
+    llvm::ModuleAnalysisManager mam;
+
+    llvm::PassBuilder pb(m_target_machine.get());
+    pb.registerModuleAnalyses(mam);
+    pb.registerCGSCCAnalyses(cgam);
+    pb.registerFunctionAnalyses(fam);
+    pb.registerLoopAnalyses(lam);
+    pb.crossRegisterProxies(lam, fam, cgam, mam);
+
+    pb.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O3).run(module, mam);
+  }
+
+public:
+  jit_compiler() {
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+
+    // Generate code for the features of this CPU, which decides the width of vectors
+    auto jtmb = llvm::orc::JITTargetMachineBuilder::detectHost();
+    if (!jtmb) {
+      llvm::consumeError(jtmb.takeError());
+      return;
+    }
+    jtmb->setCodeGenOptLevel(llvm::CodeGenOpt::Aggressive);
+
+    auto target_machine = jtmb->createTargetMachine();
+    if (!target_machine) {
+      llvm::consumeError(target_machine.takeError());
+      return;
+    }
+
+    auto jit = llvm::orc::LLJITBuilder().setJITTargetMachineBuilder(std::move(*jtmb)).create();
+    if (!jit) {
+      llvm::consumeError(jit.takeError());
+      return;
+    }
+
+    // The optimizer may turn loops into calls to functions like memcpy
+    auto generator = llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+        (*jit)->getDataLayout().getGlobalPrefix());
+    if (!generator) {
+      llvm::consumeError(generator.takeError());
+      return;
+    }
+    (*jit)->getMainJITDylib().addGenerator(std::move(*generator));
+
+    m_target_machine = std::move(*target_machine);
+    m_jit = std::move(*jit);
+  }
+
+  nd::jit::strided_function compile(const nd::functional::fused_program &program) {
+    vector<ndt::type> src_tp;
+    std::string signature = get_signature(program, src_tp);
+    if (signature.empty()) {
+      return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_jit == nullptr) {
+      return nullptr;
+    }
+
+    auto it = m_functions.find(signature);
+    if (it != m_functions.end()) {
+      return it->second;
+    }
+
+    auto context = std::make_unique<llvm::LLVMContext>();
+    auto module = std::make_unique<llvm::Module>("dynd_jit", *context);
+    module->setDataLayout(m_jit->getDataLayout());
+    module->setTargetTriple(m_target_machine->getTargetTriple().str());
+
+    std::string name = "dynd_fused_" + to_string(m_functions.size());
+    llvm::Function *f = fused_codegen(program, src_tp, *context).emit(*module, name);
+    nd::jit::strided_function function = nullptr;
+    if (!llvm::verifyFunction(*f)) {
+      optimize(*module);
+      llvm::Error err = m_jit->addIRModule(llvm::orc::ThreadSafeModule(std::move(module), std::move(context)));
+      if (err) {
+        llvm::consumeError(std::move(err));
+      } else {
+        auto symbol = m_jit->lookup(name);
+        if (symbol) {
+          function = reinterpret_cast<nd::jit::strided_function>(static_cast<uintptr_t>(symbol->getAddress()));
+        } else {
+          llvm::consumeError(symbol.takeError());
+        }
+      }
+    }
+
+    // A program that failed to compile is remembered too, so it isn't tried again
+    m_functions[signature] = function;
+    return function;
+  }
+};
+
+} // anonymous namespace
+
+nd::jit::strided_function nd::jit::compile(const functional::fused_program &program) {
+  static jit_compiler compiler;
+  return compiler.compile(program);
+}
@@ -3,9 +3,25 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
 #include <dynd/json_formatter.hpp>
 #include <dynd/callable.hpp>
+#include <dynd/number_format.hpp>
 #include <dynd/option.hpp>
+#include <dynd/thread_pool.hpp>
 #include <dynd/types/string_type.hpp>
 #include <dynd/types/struct_type.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
@@ -19,8 +35,36 @@ struct output_data {
   dynd::string out_string;
   char *out_begin, *out_end, *out_capacity_end;
   bool struct_as_list;
+  // If set, the output is passed to the sink in pieces of at most chunk_size whenever the buffer fills up, instead
+  // of growing it
+  const json_sink_t *sink;
+  intptr_t chunk_size;
+
+  output_data(bool struct_as_list, size_t capacity, const json_sink_t *sink = NULL)
+      : struct_as_list(struct_as_list), sink(sink), chunk_size(capacity) {
+    out_string.resize(capacity);
+    out_begin = out_string.begin();
+    out_capacity_end = out_string.end();
+    out_end = out_begin;
+  }
+
+  void emit(const char *begin, const char *end) {
+    while (begin != end) {
+      const char *piece_end = begin + std::min(chunk_size, end - begin);
+      (*sink)(begin, piece_end);
+      begin = piece_end;
+    }
+  }
+
+  void flush() {
+    emit(out_begin, out_end);
+    out_end = out_begin;
+  }
 
   void ensure_capacity(intptr_t added_capacity) {
+    if (out_capacity_end - out_end < added_capacity && sink != NULL) {
+      flush();
+    }
     // If there's not enough space, double the capacity
     if (out_capacity_end - out_end < added_capacity) {
       intptr_t current_size = out_end - out_begin;
@@ -62,6 +106,26 @@ struct output_data {
     memcpy(out_end, begin, end - begin);
     out_end += (end - begin);
   }
+
+  // Write a string-range that may be longer than a chunk, passing whole chunks of it straight to the sink
+  void write_chunked(const char *begin, const char *end) {
+    if (out_end - out_begin >= chunk_size) {
+      flush();
+    }
+    intptr_t used = out_end - out_begin;
+    if (used + (end - begin) <= chunk_size) {
+      write(begin, end);
+      return;
+    }
+
+    write(begin, begin + (chunk_size - used));
+    begin += chunk_size - used;
+    flush();
+    for (; end - begin >= chunk_size; begin += chunk_size) {
+      (*sink)(begin, begin + chunk_size);
+    }
+    write(begin, end);
+  }
 };
 
 static void format_json(output_data &out, const ndt::type &dt, const char *arrmeta, const char *data);
@@ -81,10 +145,76 @@ static void format_json_bool(output_data &out, const ndt::type &dt, const char *
   }
 }
 
+template <typename T>
+static T load_number(const char *data) {
+  T value;
+  memcpy(&value, data, sizeof(T));
+  return value;
+}
+
 static void format_json_number(output_data &out, const ndt::type &dt, const char *arrmeta, const char *data) {
-  stringstream ss;
-  dt.print_data(ss, arrmeta, data);
-  out.write(ss.str());
+  // Numbers are written straight into the output, with room for both parts of a complex value
+  out.ensure_capacity(2 * number_format_max_size + 6);
+  switch (dt.get_id()) {
+  case int8_id:
+    out.out_end = format_int(out.out_end, load_number<int8_t>(data));
+    break;
+  case int16_id:
+    out.out_end = format_int(out.out_end, load_number<int16_t>(data));
+    break;
+  case int32_id:
+    out.out_end = format_int(out.out_end, load_number<int32_t>(data));
+    break;
+  case int64_id:
+    out.out_end = format_int(out.out_end, load_number<int64_t>(data));
+    break;
+  case uint8_id:
+    out.out_end = format_uint(out.out_end, load_number<uint8_t>(data));
+    break;
+  case uint16_id:
+    out.out_end = format_uint(out.out_end, load_number<uint16_t>(data));
+    break;
+  case uint32_id:
+    out.out_end = format_uint(out.out_end, load_number<uint32_t>(data));
+    break;
+  case uint64_id:
+    out.out_end = format_uint(out.out_end, load_number<uint64_t>(data));
+    break;
+  case float16_id:
+    out.out_end = format_float16(out.out_end, load_number<float16>(data));
+    break;
+  case float32_id:
+    out.out_end = format_float(out.out_end, load_number<float>(data));
+    break;
+  case float64_id:
+    out.out_end = format_double(out.out_end, load_number<double>(data));
+    break;
+  case complex_float32_id: {
+    dynd::complex<float> value = load_number<dynd::complex<float>>(data);
+    out.write('(');
+    out.out_end = format_float(out.out_end, value.real());
+    out.write(" + ");
+    out.out_end = format_float(out.out_end, value.imag());
+    out.write("j)");
+    break;
+  }
+  case complex_float64_id: {
+    dynd::complex<double> value = load_number<dynd::complex<double>>(data);
+    out.write('(');
+    out.out_end = format_double(out.out_end, value.real());
+    out.write(" + ");
+    out.out_end = format_double(out.out_end, value.imag());
+    out.write("j)");
+    break;
+  }
+  default: {
+    // The 128-bit types are rare enough to go through the generic printing
+    stringstream ss;
+    dt.print_data(ss, arrmeta, data);
+    out.write(ss.str());
+    break;
+  }
+  }
 }
 
 static void print_escaped_unicode_codepoint(output_data &out, uint32_t cp, append_unicode_codepoint_t append_fn) {
@@ -291,6 +421,7 @@ static void format_json(output_data &out, const ndt::type &dt, const char *arrme
     break;
   case fixed_string_id:
   case string_id:
+  case string_view_id:
     format_json_string(out, dt, arrmeta, data);
     break;
   case type_id:
@@ -319,12 +450,7 @@ nd::array dynd::format_json(const nd::array &n, bool struct_as_list) {
   nd::array result = nd::empty(ndt::make_type<ndt::string_type>());
 
   // Initialize the output with some memory
-  output_data out;
-  out.out_string.resize(1024);
-  out.out_begin = out.out_string.begin();
-  out.out_capacity_end = out.out_string.end();
-  out.out_end = out.out_begin;
-  out.struct_as_list = struct_as_list;
+  output_data out(struct_as_list, 1024);
 
   if (!n.get_type().is_expression()) {
     ::format_json(out, n.get_type(), n.get()->metadata(), n.cdata());
@@ -342,3 +468,135 @@ nd::array dynd::format_json(const nd::array &n, bool struct_as_list) {
 
   return result;
 }
+
+namespace {
+
+/**
+ * The elements of the leading fixed or var dimension of an array.
+ */
+struct leading_dim {
+  intptr_t size;
+  intptr_t stride;
+  const char *data;
+  ndt::type element_tp;
+  const char *element_arrmeta;
+
+  leading_dim(const ndt::type &tp, const char *arrmeta, const char *data) : data(data) {
+    if (tp.get_id() == fixed_dim_id) {
+      const fixed_dim_type_arrmeta *md = reinterpret_cast<const fixed_dim_type_arrmeta *>(arrmeta);
+      size = md->dim_size;
+      stride = md->stride;
+      element_arrmeta = arrmeta + sizeof(fixed_dim_type_arrmeta);
+    } else {
+      const ndt::var_dim_type::metadata_type *md = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(arrmeta);
+      const ndt::var_dim_type::data_type *d = reinterpret_cast<const ndt::var_dim_type::data_type *>(data);
+      size = d->size;
+      stride = md->stride;
+      this->data = d->begin + md->offset;
+      element_arrmeta = arrmeta + sizeof(ndt::var_dim_type::metadata_type);
+    }
+    element_tp = tp.extended<ndt::base_dim_type>()->get_element_type();
+  }
+};
+
+} // anonymous namespace
+
+static void format_json_elements(output_data &out, const leading_dim &dim, intptr_t begin, intptr_t end,
+                                 bool ndjson) {
+  for (intptr_t i = begin; i < end; ++i) {
+    if (!ndjson && i != 0) {
+      out.write(',');
+    }
+    ::format_json(out, dim.element_tp, dim.element_arrmeta, dim.data + i * dim.stride);
+    if (ndjson) {
+      out.write('\n');
+    }
+  }
+}
+
+void dynd::write_json(const nd::array &a, const json_sink_t &sink, bool struct_as_list, bool ndjson,
+                      size_t chunk_size, const eval::eval_context *ectx) {
+  // The chunk size is used as a signed byte count, and a zero size would never make progress
+  if (chunk_size == 0 || chunk_size > static_cast<size_t>(std::numeric_limits<intptr_t>::max())) {
+    stringstream ss;
+    ss << "Invalid JSON output chunk size " << chunk_size;
+    throw invalid_argument(ss.str());
+  }
+
+  nd::array n = a.get_type().is_expression() ? a.eval() : a;
+  const ndt::type &tp = n.get_type();
+
+  output_data out(struct_as_list, chunk_size, &sink);
+  if (tp.get_id() != fixed_dim_id && tp.get_id() != var_dim_id) {
+    if (ndjson) {
+      stringstream ss;
+      ss << "Formatting dynd type " << tp << " as NDJSON requires a leading fixed or var dimension";
+      throw invalid_argument(ss.str());
+    }
+    ::format_json(out, tp, n.get()->metadata(), n.cdata());
+    out.flush();
+    return;
+  }
+
+  leading_dim dim(tp, n.get()->metadata(), n.cdata());
+  if (!ndjson) {
+    out.write('[');
+  }
+
+  size_t size = dim.size, nthreads = ectx->nthreads, grain = ectx->grain_size;
+  if (nthreads > 1 && !in_parallel_region() && size >= 2 * grain) {
+    // A window of one slice of ``grain`` elements per thread is formatted at a time, which bounds the memory used
+    std::vector<std::unique_ptr<output_data>> slices(nthreads);
+    for (auto &slice : slices) {
+      slice.reset(new output_data(struct_as_list, chunk_size));
+    }
+    for (size_t window_begin = 0; window_begin < size; window_begin += nthreads * grain) {
+      size_t nslices = std::min(nthreads, (size - window_begin + grain - 1) / grain);
+      parallel_for(nthreads, nslices, 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          size_t slice_begin = window_begin + i * grain;
+          slices[i]->out_end = slices[i]->out_begin;
+          format_json_elements(*slices[i], dim, slice_begin, std::min(slice_begin + grain, size), ndjson);
+        }
+      });
+      for (size_t i = 0; i < nslices; ++i) {
+        out.write_chunked(slices[i]->out_begin, slices[i]->out_end);
+      }
+    }
+  } else {
+    format_json_elements(out, dim, 0, size, ndjson);
+  }
+
+  if (!ndjson) {
+    out.write(']');
+  }
+  out.flush();
+}
+
+void dynd::write_json(const nd::array &a, std::ostream &o, bool struct_as_list, bool ndjson,
+                      const eval::eval_context *ectx) {
+  write_json(a, [&o](const char *begin, const char *end) { o.write(begin, end - begin); }, struct_as_list, ndjson,
+             1 << 16, ectx);
+}
+
+void dynd::write_json_fd(const nd::array &a, int fd, bool struct_as_list, bool ndjson,
+                         const eval::eval_context *ectx) {
+  write_json(a,
+             [fd](const char *begin, const char *end) {
+               while (begin < end) {
+#ifdef _WIN32
+                 int written = _write(fd, begin, static_cast<unsigned int>(end - begin));
+#else
+                 ssize_t written = ::write(fd, begin, end - begin);
+                 if (written < 0 && errno == EINTR) {
+                   continue;
+                 }
+#endif
+                 if (written < 0) {
+                   throw runtime_error(std::string("error writing JSON to a file descriptor: ") + strerror(errno));
+                 }
+                 begin += written;
+               }
+             },
+             struct_as_list, ndjson, 1 << 16, ectx);
+}
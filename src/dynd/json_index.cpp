@@ -0,0 +1,209 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include <dynd/json_index.hpp>
+#include <dynd/kernels/contiguous_loop.hpp>
+
+#ifdef DYND_TARGET_AVX2
+#include <immintrin.h>
+#endif
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+// The input is classified in blocks of 64 bytes, one bit per byte
+const size_t block_size = 64;
+
+struct block_masks {
+  uint64_t quote;
+  uint64_t backslash;
+  uint64_t bracket; // '{', '}', '[' and ']'
+};
+
+void classify_default(const char *block, block_masks &masks) {
+  masks.quote = 0;
+  masks.backslash = 0;
+  masks.bracket = 0;
+  for (size_t i = 0; i < block_size; ++i) {
+    // '{' and '}' are '[' and ']' with the 0x20 bit set
+    char c = block[i];
+    masks.quote |= static_cast<uint64_t>(c == '"') << i;
+    masks.backslash |= static_cast<uint64_t>(c == '\\') << i;
+    masks.bracket |= static_cast<uint64_t>((c | 0x20) == '{' || (c | 0x20) == '}') << i;
+  }
+}
+
+#ifdef DYND_TARGET_AVX2
+DYND_TARGET_AVX2 uint64_t movemask_eq(__m256i lo, __m256i hi, char c) {
+  __m256i v = _mm256_set1_epi8(c);
+  uint32_t lo_mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, v)));
+  uint32_t hi_mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, v)));
+  return (static_cast<uint64_t>(hi_mask) << 32) | lo_mask;
+}
+
+DYND_TARGET_AVX2 void classify_avx2(const char *block, block_masks &masks) {
+  __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+  __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32));
+  masks.quote = movemask_eq(lo, hi, '"');
+  masks.backslash = movemask_eq(lo, hi, '\\');
+
+  // '{' and '}' are '[' and ']' with the 0x20 bit set
+  __m256i case_bit = _mm256_set1_epi8(0x20);
+  __m256i lo_folded = _mm256_or_si256(lo, case_bit), hi_folded = _mm256_or_si256(hi, case_bit);
+  masks.bracket = movemask_eq(lo_folded, hi_folded, '{') | movemask_eq(lo_folded, hi_folded, '}');
+}
+#endif
+
+/**
+ * Returns a mask with each bit set to the parity of the bits at or below it,
+ * which for a mask of quotes marks the opening quote and contents of each string.
+ */
+inline uint64_t prefix_xor(uint64_t x) {
+  x ^= x << 1;
+  x ^= x << 2;
+  x ^= x << 4;
+  x ^= x << 8;
+  x ^= x << 16;
+  x ^= x << 32;
+  return x;
+}
+
+/**
+ * Returns the mask of characters escaped by a backslash. Escapes are rare, so
+ * this loops over the backslashes instead of computing runs of them with
+ * carries. ``carry`` is whether the first character of the block is escaped.
+ */
+inline uint64_t escaped_mask(uint64_t backslash, uint64_t &carry) {
+  uint64_t escaped = carry;
+  backslash &= ~carry;
+  carry = 0;
+  while (backslash != 0) {
+    size_t i = nd::detail::count_trailing_zeros(backslash);
+    if (i == block_size - 1) {
+      carry = 1;
+      break;
+    }
+    escaped |= static_cast<uint64_t>(1) << (i + 1);
+    // An escaped backslash doesn't escape what follows it
+    backslash &= ~(static_cast<uint64_t>(3) << i);
+  }
+
+  return escaped;
+}
+
+} // anonymous namespace
+
+void json_structural_index::build(const char *begin, const char *end) {
+  m_begin = begin;
+  m_positions.clear();
+  m_matches.clear();
+  m_cursor = 0;
+  m_valid = false;
+
+  size_t size = end - begin;
+  if (size > numeric_limits<uint32_t>::max()) {
+    return;
+  }
+
+  void (*classify)(const char *, block_masks &) = &classify_default;
+#ifdef DYND_TARGET_AVX2
+  if (nd::detail::get_simd_level() != nd::detail::simd_level_default) {
+    classify = &classify_avx2;
+  }
+#endif
+
+  // Stage one finds the structural characters
+  uint64_t escape_carry = 0, in_string_carry = 0;
+  char tail[block_size];
+  for (size_t offset = 0; offset < size; offset += block_size) {
+    const char *block = begin + offset;
+    if (size - offset < block_size) {
+      memset(tail, ' ', block_size);
+      memcpy(tail, block, size - offset);
+      block = tail;
+    }
+
+    block_masks masks;
+    classify(block, masks);
+
+    uint64_t quote = masks.quote;
+    if (masks.backslash != 0 || escape_carry != 0) {
+      quote &= ~escaped_mask(masks.backslash, escape_carry);
+    }
+    uint64_t in_string = prefix_xor(quote) ^ in_string_carry;
+    in_string_carry = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+
+    uint64_t structural = (masks.bracket & ~in_string) | quote;
+    while (structural != 0) {
+      m_positions.push_back(static_cast<uint32_t>(offset + nd::detail::count_trailing_zeros(structural)));
+      structural &= structural - 1;
+    }
+  }
+
+  // Then each opening character is matched with the one closing it
+  m_matches.resize(m_positions.size());
+  std::vector<uint32_t> open;
+  const uint32_t no_quote = numeric_limits<uint32_t>::max();
+  uint32_t open_quote = no_quote;
+  for (uint32_t i = 0; i < m_positions.size(); ++i) {
+    char c = begin[m_positions[i]];
+    if (c == '"') {
+      if (open_quote == no_quote) {
+        open_quote = i;
+      } else {
+        m_matches[open_quote] = i;
+        m_matches[i] = open_quote;
+        open_quote = no_quote;
+      }
+    } else if (c == '{' || c == '[') {
+      open.push_back(i);
+    } else {
+      // The closing character has to match the most recent unclosed one, e.g. ']' for '['
+      if (open.empty() || begin[m_positions[open.back()]] != c - 2) {
+        return;
+      }
+      m_matches[open.back()] = i;
+      m_matches[i] = open.back();
+      open.pop_back();
+    }
+  }
+
+  m_valid = open.empty() && open_quote == no_quote;
+}
+
+const char *json_structural_index::skip(const char *pos) {
+  if (!m_valid || pos < m_begin) {
+    return NULL;
+  }
+
+  uint32_t offset = static_cast<uint32_t>(pos - m_begin);
+  if (m_cursor < m_positions.size() && m_positions[m_cursor] <= offset) {
+    while (m_cursor < m_positions.size() && m_positions[m_cursor] < offset) {
+      ++m_cursor;
+    }
+  } else {
+    // The parser backtracked, which only happens over a few characters
+    m_cursor = std::lower_bound(m_positions.begin(), m_positions.end(), offset) - m_positions.begin();
+  }
+
+  if (m_cursor == m_positions.size() || m_positions[m_cursor] != offset) {
+    return NULL;
+  }
+
+  char c = m_begin[offset];
+  uint32_t match = m_matches[m_cursor];
+  if ((c != '"' && c != '{' && c != '[') || match < m_cursor) {
+    return NULL;
+  }
+
+  m_cursor = match + 1;
+  return m_begin + m_positions[match] + 1;
+}
@@ -3,10 +3,20 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include <dynd/callable.hpp>
+#include <dynd/json_index.hpp>
 #include <dynd/json_parser.hpp>
 #include <dynd/kernels/parse_kernel.hpp>
+#include <dynd/memblock/pod_memory_block.hpp>
 #include <dynd/parse.hpp>
+#include <dynd/thread_pool.hpp>
 #include <dynd/types/base_bytes_type.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
 #include <dynd/types/option_type.hpp>
@@ -75,7 +85,8 @@ nd::array dynd::parse_json(const ndt::type &tp, const nd::array &json, const eva
 }
 
 static void parse_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&json_begin,
-                       const char *json_end, const eval::eval_context *ectx);
+                       const char *json_end, json_structural_index &index,
+                       nd::base_memory_block *string_arena, const eval::eval_context *ectx);
 
 static void skip_json_value(const char *&begin, const char *end) {
   skip_whitespace(begin, end);
@@ -158,8 +169,132 @@ static void skip_json_value(const char *&begin, const char *end) {
   }
 }
 
+/**
+ * Skips a value, jumping straight past strings, arrays and objects that the
+ * structural index found the end of.
+ */
+static void skip_json_value(const char *&begin, const char *end, json_structural_index &index) {
+  skip_whitespace(begin, end);
+  const char *value_end = (begin != end) ? index.skip(begin) : NULL;
+  if (value_end != NULL) {
+    begin = value_end;
+  } else {
+    skip_json_value(begin, end);
+  }
+}
+
+/**
+ * Same as ``parse_doublequote_string_no_ws``, except that the closing quote of a
+ * string without escapes is found through the structural index.
+ */
+static bool parse_json_string_no_ws(const char *&begin, const char *end, json_structural_index &index,
+                                    const char *&out_strbegin, const char *&out_strend, bool &out_escaped) {
+  if (begin != end && *begin == '"') {
+    const char *string_end = index.skip(begin);
+    if (string_end != NULL && memchr(begin + 1, '\\', string_end - begin - 2) == NULL) {
+      out_strbegin = begin + 1;
+      out_strend = string_end - 1;
+      out_escaped = false;
+      begin = string_end;
+      return true;
+    }
+  }
+
+  return parse_doublequote_string_no_ws(begin, end, out_strbegin, out_strend, out_escaped);
+}
+
+/**
+ * Finds the bounds of each element of the JSON array at ``begin``, for parsing
+ * them in parallel. This is only attempted when the evaluation context allows
+ * more than one thread, and only succeeds when every element is a string, array
+ * or object, whose bounds are in the structural index, and there are enough of
+ * them to be worth it.
+ *
+ * Element types containing var dims are parsed serially, because those
+ * allocate from a memory block shared by all the elements.
+ */
+static bool find_json_array_elements(const ndt::type &el_tp, const char *begin, const char *end,
+                                     json_structural_index &index, const eval::eval_context *ectx,
+                                     std::vector<std::pair<const char *, const char *>> &elements,
+                                     const char *&array_end) {
+  if (ectx->nthreads <= 1 || in_parallel_region() || (el_tp.get_flags() & type_flag_blockref) != 0 ||
+      begin == end || *begin != '[') {
+    return false;
+  }
+
+  array_end = index.skip(begin);
+  if (array_end == NULL) {
+    return false;
+  }
+
+  const char *last = array_end - 1;
+  begin += 1;
+  skip_whitespace(begin, last);
+  while (begin != last) {
+    const char *element_end = index.skip(begin);
+    if (element_end == NULL) {
+      return false;
+    }
+    elements.emplace_back(begin, element_end);
+
+    begin = element_end;
+    skip_whitespace(begin, last);
+    if (begin != last && !parse_token(begin, last, ",")) {
+      return false;
+    }
+  }
+
+  return elements.size() >= 2 * ectx->grain_size;
+}
+
+/**
+ * Parses the elements found by ``find_json_array_elements`` into consecutive
+ * elements of ``out_data``. Each thread builds a structural index for its own
+ * range of the input. If ``string_arena`` isn't NULL, each thread also takes
+ * string buffers from an arena of its own, which ``string_arena`` then takes
+ * over, as a memory block can't be allocated from by several threads at once.
+ */
+static void parse_json_array_elements(const ndt::type &el_tp, const char *el_arrmeta, char *out_data, intptr_t stride,
+                                      const std::vector<std::pair<const char *, const char *>> &elements,
+                                      nd::base_memory_block *string_arena, const eval::eval_context *ectx) {
+  std::mutex thread_arenas_mutex;
+  std::vector<nd::memory_block> thread_arenas;
+  auto absorb_thread_arenas = [&] {
+    for (const nd::memory_block &thread_arena : thread_arenas) {
+      string_arena->absorb(*thread_arena);
+    }
+  };
+
+  try {
+    parallel_for(ectx->nthreads, elements.size(), ectx->grain_size, [&](size_t i_begin, size_t i_end) {
+      nd::base_memory_block *thread_arena = NULL;
+      if (string_arena != NULL) {
+        std::lock_guard<std::mutex> lock(thread_arenas_mutex);
+        thread_arenas.push_back(nd::make_string_arena());
+        thread_arena = thread_arenas.back().get();
+      }
+
+      json_structural_index index(elements[i_begin].first, elements[i_end - 1].second);
+      for (size_t i = i_begin; i < i_end; ++i) {
+        const char *begin = elements[i].first, *end = elements[i].second;
+        parse_json(el_tp, el_arrmeta, out_data + i * stride, begin, end, index, thread_arena, ectx);
+        skip_whitespace(begin, end);
+        if (begin != end) {
+          throw json_parse_error(begin, "unexpected trailing JSON text in array element", el_tp);
+        }
+      }
+    });
+  } catch (...) {
+    // The elements parsed before the error may hold strings from these arenas
+    absorb_thread_arenas();
+    throw;
+  }
+  absorb_thread_arenas();
+}
+
 static void parse_strided_dim_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin,
-                                   const char *end, const eval::eval_context *ectx) {
+                                   const char *end, json_structural_index &index,
+                                   nd::base_memory_block *string_arena, const eval::eval_context *ectx) {
   intptr_t dim_size, stride;
   ndt::type el_tp;
   const char *el_arrmeta;
@@ -167,11 +302,24 @@ static void parse_strided_dim_json(const ndt::type &tp, const char *arrmeta, cha
     throw json_parse_error(begin, "expected a strided dimension", tp);
   }
 
+  std::vector<std::pair<const char *, const char *>> elements;
+  const char *array_end;
+  if (find_json_array_elements(el_tp, begin, end, index, ectx, elements, array_end) &&
+      elements.size() == static_cast<size_t>(dim_size)) {
+    parse_json_array_elements(el_tp, el_arrmeta, out_data, stride, elements, string_arena, ectx);
+    begin = array_end;
+    return;
+  }
+
+  // Arrays nested in this one are parsed on this thread, rather than each being scanned for elements again
+  eval::eval_context serial_ectx = *ectx;
+  serial_ectx.nthreads = 1;
+
   if (!parse_token(begin, end, "[")) {
     throw json_parse_error(begin, "expected list starting with '['", tp);
   }
   for (intptr_t i = 0; i < dim_size; ++i) {
-    parse_json(el_tp, el_arrmeta, out_data + i * stride, begin, end, ectx);
+    parse_json(el_tp, el_arrmeta, out_data + i * stride, begin, end, index, string_arena, &serial_ectx);
     if (i < dim_size - 1 && !parse_token(begin, end, ",")) {
       throw json_parse_error(begin, "array is too short, expected ',' list item separator", tp);
     }
@@ -181,8 +329,14 @@ static void parse_strided_dim_json(const ndt::type &tp, const char *arrmeta, cha
   }
 }
 
+/**
+ * Parses a JSON array into a var dim. The elements live in the var dim's own
+ * memory block, so their strings come from that block's arena rather than the
+ * one given for the enclosing data.
+ */
 static void parse_var_dim_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin,
-                               const char *end, const eval::eval_context *ectx) {
+                               const char *end, json_structural_index &index,
+                               nd::base_memory_block *DYND_UNUSED(string_arena), const eval::eval_context *ectx) {
   const ndt::var_dim_type *vad = tp.extended<ndt::var_dim_type>();
   const ndt::var_dim_type::metadata_type *md = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(arrmeta);
   intptr_t stride = md->stride;
@@ -190,6 +344,24 @@ static void parse_var_dim_json(const ndt::type &tp, const char *arrmeta, char *o
 
   ndt::var_dim_type::data_type *out = reinterpret_cast<ndt::var_dim_type::data_type *>(out_data);
 
+  // Strings in the elements are freed with the memory block they are stored in
+  nd::base_memory_block *element_string_arena = md->blockref->get_string_arena();
+
+  std::vector<std::pair<const char *, const char *>> elements;
+  const char *array_end;
+  if (find_json_array_elements(element_tp, begin, end, index, ectx, elements, array_end)) {
+    out->begin = md->blockref->alloc(elements.size());
+    out->size = elements.size();
+    parse_json_array_elements(element_tp, arrmeta + sizeof(ndt::var_dim_type::metadata_type), out->begin, stride,
+                              elements, element_string_arena, ectx);
+    begin = array_end;
+    return;
+  }
+
+  // Arrays nested in this one are parsed on this thread, rather than each being scanned for elements again
+  eval::eval_context serial_ectx = *ectx;
+  serial_ectx.nthreads = 1;
+
   intptr_t size = 0, allocated_size = 8;
   out->begin = md->blockref->alloc(allocated_size);
 
@@ -207,7 +379,7 @@ static void parse_var_dim_json(const ndt::type &tp, const char *arrmeta, char *o
       ++size;
       out->size = size;
       parse_json(element_tp, arrmeta + sizeof(ndt::var_dim_type::metadata_type), out->begin + (size - 1) * stride,
-                 begin, end, ectx);
+                 begin, end, index, element_string_arena, &serial_ectx);
       if (!parse_token(begin, end, ",")) {
         break;
       }
@@ -223,7 +395,8 @@ static void parse_var_dim_json(const ndt::type &tp, const char *arrmeta, char *o
 }
 
 static bool parse_struct_json_from_object(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin,
-                                          const char *end, const eval::eval_context *ectx) {
+                                          const char *end, json_structural_index &index,
+                                          nd::base_memory_block *string_arena, const eval::eval_context *ectx) {
   const char *saved_begin = begin;
   if (!parse_token(begin, end, "{")) {
     return false;
@@ -240,31 +413,38 @@ static bool parse_struct_json_from_object(const ndt::type &tp, const char *arrme
 
   // If it's not an empty object, start the loop parsing the elements
   if (!parse_token(begin, end, "}")) {
+    intptr_t next_field = 0;
     for (;;) {
       const char *strbegin, *strend;
       bool escaped;
       skip_whitespace(begin, end);
-      if (!parse_doublequote_string_no_ws(begin, end, strbegin, strend, escaped)) {
+      if (!parse_json_string_no_ws(begin, end, index, strbegin, strend, escaped)) {
         throw json_parse_error(begin, "expected string for name in object dict", tp);
       }
       if (!parse_token(begin, end, ":")) {
         throw json_parse_error(begin, "expected ':' separating name from value in object dict", tp);
       }
+      // Keys usually arrive in the order the fields are declared, so check the next field before hashing
       intptr_t i;
       if (escaped) {
         std::string name;
         unescape_string(strbegin, strend, name);
         i = fsd->get_field_index(name);
+      } else if (next_field < field_count && fsd->get_field_name(next_field).size() == size_t(strend - strbegin) &&
+                 memcmp(fsd->get_field_name(next_field).data(), strbegin, strend - strbegin) == 0) {
+        i = next_field;
       } else {
-        i = fsd->get_field_index(std::string(strbegin, strend));
+        i = fsd->get_field_index(strbegin, strend);
       }
       if (i == -1) {
         // TODO: Add an error policy to this parser of whether to throw an error
         //       or not. For now, just throw away fields not in the destination.
-        skip_json_value(begin, end);
+        skip_json_value(begin, end, index);
       } else {
-        parse_json(fsd->get_field_type(i), arrmeta + arrmeta_offsets[i], out_data + data_offsets[i], begin, end, ectx);
+        parse_json(fsd->get_field_type(i), arrmeta + arrmeta_offsets[i], out_data + data_offsets[i], begin, end, index,
+                   string_arena, ectx);
         populated_fields[i] = true;
+        next_field = i + 1;
       }
       if (!parse_token(begin, end, ",")) {
         break;
@@ -296,7 +476,8 @@ static bool parse_struct_json_from_object(const ndt::type &tp, const char *arrme
 
 template <class Type>
 static bool parse_tuple_json_from_list(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin,
-                                       const char *end, const eval::eval_context *ectx) {
+                                       const char *end, json_structural_index &index,
+                                       nd::base_memory_block *string_arena, const eval::eval_context *ectx) {
   if (!parse_token(begin, end, "[")) {
     return false;
   }
@@ -309,7 +490,8 @@ static bool parse_tuple_json_from_list(const ndt::type &tp, const char *arrmeta,
   // Loop through all the fields
   for (intptr_t i = 0; i != field_count; ++i) {
     skip_whitespace(begin, end);
-    parse_json(fsd->get_field_type(i), arrmeta + arrmeta_offsets[i], out_data + data_offsets[i], begin, end, ectx);
+    parse_json(fsd->get_field_type(i), arrmeta + arrmeta_offsets[i], out_data + data_offsets[i], begin, end, index,
+               string_arena, ectx);
     if (i != field_count - 1 && !parse_token(begin, end, ",")) {
       throw json_parse_error(begin, "expected list item separator ','", tp);
     }
@@ -323,17 +505,20 @@ static bool parse_tuple_json_from_list(const ndt::type &tp, const char *arrmeta,
 }
 
 static void parse_struct_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin,
-                              const char *end, const eval::eval_context *ectx) {
-  if (parse_struct_json_from_object(tp, arrmeta, out_data, begin, end, ectx)) {
-  } else if (parse_tuple_json_from_list<ndt::struct_type>(tp, arrmeta, out_data, begin, end, ectx)) {
+                              const char *end, json_structural_index &index,
+                              nd::base_memory_block *string_arena, const eval::eval_context *ectx) {
+  if (parse_struct_json_from_object(tp, arrmeta, out_data, begin, end, index, string_arena, ectx)) {
+  } else if (parse_tuple_json_from_list<ndt::struct_type>(tp, arrmeta, out_data, begin, end, index, string_arena,
+                                                            ectx)) {
   } else {
     throw json_parse_error(begin, "expected object dict starting with '{' or list with '['", tp);
   }
 }
 
 static void parse_tuple_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin,
-                             const char *end, const eval::eval_context *ectx) {
-  if (parse_tuple_json_from_list<ndt::tuple_type>(tp, arrmeta, out_data, begin, end, ectx)) {
+                             const char *end, json_structural_index &index,
+                             nd::base_memory_block *string_arena, const eval::eval_context *ectx) {
+  if (parse_tuple_json_from_list<ndt::tuple_type>(tp, arrmeta, out_data, begin, end, index, string_arena, ectx)) {
   } else {
     throw json_parse_error(begin, "expected object dict starting with '{' or list with '['", tp);
   }
@@ -401,15 +586,26 @@ static void parse_bool_json(const ndt::type &tp, const char *DYND_UNUSED(arrmeta
 }
 
 static void parse_string_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&rbegin,
-                              const char *end, const eval::eval_context *ectx) {
+                              const char *end, json_structural_index &index, nd::base_memory_block *string_arena,
+                              const eval::eval_context *ectx) {
   const char *begin = rbegin;
   skip_whitespace(begin, end);
   const char *strbegin, *strend;
   bool escaped;
-  if (parse_doublequote_string_no_ws(begin, end, strbegin, strend, escaped)) {
+  if (parse_json_string_no_ws(begin, end, index, strbegin, strend, escaped)) {
     const ndt::base_string_type *bsd = tp.extended<ndt::base_string_type>();
     try {
-      if (!escaped) {
+      if (string_arena != NULL && tp.get_id() == string_id) {
+        if (!escaped) {
+          tp.extended<ndt::string_type>()->set_from_utf8_string(arrmeta, out_data, strbegin, strend, string_arena,
+                                                                 ectx);
+        } else {
+          std::string val;
+          unescape_string(strbegin, strend, val);
+          tp.extended<ndt::string_type>()->set_from_utf8_string(arrmeta, out_data, val.data(), val.data() + val.size(),
+                                                                 string_arena, ectx);
+        }
+      } else if (!escaped) {
         bsd->set_from_utf8_string(arrmeta, out_data, strbegin, strend, ectx);
       } else {
         std::string val;
@@ -469,13 +665,14 @@ static void parse_type(const ndt::type &tp, const char *DYND_UNUSED(arrmeta), ch
 }
 
 static void parse_dim_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin,
-                           const char *end, const eval::eval_context *ectx) {
+                           const char *end, json_structural_index &index,
+                           nd::base_memory_block *string_arena, const eval::eval_context *ectx) {
   switch (tp.get_id()) {
   case fixed_dim_id:
-    parse_strided_dim_json(tp, arrmeta, out_data, begin, end, ectx);
+    parse_strided_dim_json(tp, arrmeta, out_data, begin, end, index, string_arena, ectx);
     break;
   case var_dim_id:
-    parse_var_dim_json(tp, arrmeta, out_data, begin, end, ectx);
+    parse_var_dim_json(tp, arrmeta, out_data, begin, end, index, string_arena, ectx);
     break;
   default: {
     stringstream ss;
@@ -486,7 +683,7 @@ static void parse_dim_json(const ndt::type &tp, const char *arrmeta, char *out_d
 }
 
 static void parse_option_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin,
-                              const char *end, const eval::eval_context *ectx) {
+                              const char *end, json_structural_index &index, const eval::eval_context *ectx) {
   skip_whitespace(begin, end);
   const char *saved_begin = begin;
   if (tp.is_scalar()) {
@@ -497,7 +694,7 @@ static void parse_option_json(const ndt::type &tp, const char *arrmeta, char *ou
       const ndt::type &value_tp = tp.extended<ndt::option_type>()->get_value_type();
       const char *strbegin, *strend;
       bool escaped;
-      if (parse_doublequote_string_no_ws(begin, end, strbegin, strend, escaped)) {
+      if (parse_json_string_no_ws(begin, end, index, strbegin, strend, escaped)) {
         try {
           if (!escaped) {
             nd::set_option_from_utf8_string(tp, arrmeta, out_data, strbegin, strend, ectx);
@@ -549,18 +746,19 @@ static void parse_option_json(const ndt::type &tp, const char *arrmeta, char *ou
 }
 
 static void parse_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin, const char *end,
-                       const eval::eval_context *ectx) {
+                       json_structural_index &index,
+                       nd::base_memory_block *string_arena, const eval::eval_context *ectx) {
   skip_whitespace(begin, end);
   switch (tp.get_id()) {
   case fixed_dim_id:
   case var_dim_id:
-    parse_dim_json(tp, arrmeta, out_data, begin, end, ectx);
+    parse_dim_json(tp, arrmeta, out_data, begin, end, index, string_arena, ectx);
     return;
   case struct_id:
-    parse_struct_json(tp, arrmeta, out_data, begin, end, ectx);
+    parse_struct_json(tp, arrmeta, out_data, begin, end, index, string_arena, ectx);
     return;
   case tuple_id:
-    parse_tuple_json(tp, arrmeta, out_data, begin, end, ectx);
+    parse_tuple_json(tp, arrmeta, out_data, begin, end, index, string_arena, ectx);
     return;
   case bool_id:
     parse_bool_json(tp, arrmeta, out_data, begin, end, false, ectx);
@@ -585,13 +783,14 @@ static void parse_json(const ndt::type &tp, const char *arrmeta, char *out_data,
     return;
   case fixed_string_id:
   case string_id:
-    parse_string_json(tp, arrmeta, out_data, begin, end, ectx);
+  case string_view_id:
+    parse_string_json(tp, arrmeta, out_data, begin, end, index, string_arena, ectx);
     return;
   case type_id:
     parse_type(tp, arrmeta, out_data, begin, end, false, ectx);
     return;
   case option_id:
-    parse_option_json(tp, arrmeta, out_data, begin, end, ectx);
+    parse_option_json(tp, arrmeta, out_data, begin, end, index, ectx);
     return;
   default:
     break;
@@ -686,11 +885,19 @@ void dynd::validate_json(const char *json_begin, const char *json_end) {
   }
 }
 
-void dynd::parse_json(nd::array &out, const char *json_begin, const char *json_end, const eval::eval_context *ectx) {
+/**
+ * Parses a whole JSON document into ``out_data``, reporting errors with the line
+ * and column where they happened. Lines are numbered from ``first_line``, for
+ * documents that are part of a larger input. ``index`` is rebuilt for the
+ * document, so its memory can be reused across documents.
+ */
+static void parse_json_document(const ndt::type &tp, const char *arrmeta, char *out_data, const char *json_begin,
+                                const char *json_end, int first_line, json_structural_index &index,
+                                nd::base_memory_block *string_arena, const eval::eval_context *ectx) {
   try {
     const char *begin = json_begin, *end = json_end;
-    ndt::type tp = out.get_type();
-    ::parse_json(tp, out.get()->metadata(), out.data(), begin, end, ectx);
+    index.build(begin, end);
+    ::parse_json(tp, arrmeta, out_data, begin, end, index, string_arena, ectx);
     skip_whitespace(begin, end);
     if (begin != end) {
       throw json_parse_error(begin, "unexpected trailing JSON text", tp);
@@ -700,7 +907,7 @@ void dynd::parse_json(nd::array &out, const char *json_begin, const char *json_e
     std::string line_prev, line_cur;
     int line, column;
     get_error_line_column(json_begin, json_end, e.get_position(), line_prev, line_cur, line, column);
-    ss << "Error parsing JSON at line " << line << ", column " << column << "\n";
+    ss << "Error parsing JSON at line " << line + first_line - 1 << ", column " << column << "\n";
     ss << "DyND Type: " << e.get_type() << "\n";
     ss << "Message: " << e.what() << "\n";
     print_json_parse_error_marker(ss, line_prev, line_cur, line, column);
@@ -710,13 +917,19 @@ void dynd::parse_json(nd::array &out, const char *json_begin, const char *json_e
     std::string line_prev, line_cur;
     int line, column;
     get_error_line_column(json_begin, json_end, e.get_position(), line_prev, line_cur, line, column);
-    ss << "Error parsing JSON at line " << line << ", column " << column << "\n";
+    ss << "Error parsing JSON at line " << line + first_line - 1 << ", column " << column << "\n";
     ss << "Message: " << e.what() << "\n";
     print_json_parse_error_marker(ss, line_prev, line_cur, line, column);
     throw invalid_argument(ss.str());
   }
 }
 
+void dynd::parse_json(nd::array &out, const char *json_begin, const char *json_end, const eval::eval_context *ectx) {
+  json_structural_index index;
+  parse_json_document(out.get_type(), out.get()->metadata(), out.data(), json_begin, json_end, 1, index,
+                      out.get_data_memblock()->get_string_arena(), ectx);
+}
+
 nd::array dynd::parse_json(const ndt::type &tp, const char *json_begin, const char *json_end,
                            const eval::eval_context *ectx) {
   nd::array result;
@@ -728,6 +941,155 @@ nd::array dynd::parse_json(const ndt::type &tp, const char *json_begin, const ch
   return result;
 }
 
+dynd::ndjson_parser::ndjson_parser(const ndt::type &tp, const eval::eval_context *ectx)
+    : m_tp(tp), m_ectx(ectx), m_size(0), m_capacity(0), m_line(0) {
+  reset();
+}
+
+void dynd::ndjson_parser::reset() {
+  m_result = nd::empty(ndt::make_type<ndt::var_dim_type>(m_tp));
+  reinterpret_cast<ndt::var_dim_type::data_type *>(m_result.data())->begin = NULL;
+  m_size = 0;
+  m_capacity = 0;
+  m_line = 0;
+  m_partial.clear();
+  m_records.clear();
+}
+
+void dynd::ndjson_parser::add_line(const char *begin, const char *end) {
+  ++m_line;
+
+  // Blank lines, including the empty one after a trailing newline, don't hold a record
+  const char *nonblank = begin;
+  skip_whitespace(nonblank, end);
+  if (nonblank != end) {
+    m_records.push_back(record{begin, end, m_line});
+  }
+}
+
+void dynd::ndjson_parser::parse_records() {
+  if (m_records.empty()) {
+    return;
+  }
+
+  const char *arrmeta = m_result.get()->metadata();
+  const ndt::var_dim_type::metadata_type *md = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(arrmeta);
+  const char *el_arrmeta = arrmeta + sizeof(ndt::var_dim_type::metadata_type);
+  ndt::var_dim_type::data_type *out = reinterpret_cast<ndt::var_dim_type::data_type *>(m_result.data());
+
+  size_t size = m_size + m_records.size();
+  if (size > m_capacity) {
+    while (m_capacity < size) {
+      m_capacity = (m_capacity == 0) ? 64 : 2 * m_capacity;
+    }
+    out->begin = (out->begin == NULL) ? md->blockref->alloc(m_capacity) : md->blockref->resize(out->begin, m_capacity);
+  }
+
+  try {
+    // Records whose type has var dims allocate from the memory block shared by all of them, so can't be parallel
+    if (m_ectx->nthreads > 1 && !in_parallel_region() && m_records.size() >= 2 * m_ectx->grain_size &&
+        (m_tp.get_flags() & type_flag_blockref) == 0) {
+      parallel_for(m_ectx->nthreads, m_records.size(), m_ectx->grain_size, [&](size_t i_begin, size_t i_end) {
+        json_structural_index index;
+        for (size_t i = i_begin; i < i_end; ++i) {
+          const record &r = m_records[i];
+          parse_json_document(m_tp, el_arrmeta, out->begin + (m_size + i) * md->stride, r.begin, r.end,
+                              static_cast<int>(r.line), index, NULL, m_ectx);
+        }
+      });
+      m_size = size;
+    } else {
+      nd::base_memory_block *string_arena = md->blockref->get_string_arena();
+      for (const record &r : m_records) {
+        parse_json_document(m_tp, el_arrmeta, out->begin + m_size * md->stride, r.begin, r.end,
+                            static_cast<int>(r.line), m_index, string_arena, m_ectx);
+        out->size = ++m_size;
+      }
+    }
+  } catch (...) {
+    m_records.clear();
+    throw;
+  }
+
+  out->size = m_size;
+  m_records.clear();
+}
+
+void dynd::ndjson_parser::feed(const char *begin, const char *end) {
+  // Complete a record left over from the previous chunk
+  if (!m_partial.empty()) {
+    const char *newline = reinterpret_cast<const char *>(memchr(begin, '\n', end - begin));
+    if (newline == NULL) {
+      m_partial.append(begin, end);
+      return;
+    }
+
+    m_partial.append(begin, newline);
+    add_line(m_partial.data(), m_partial.data() + m_partial.size());
+    parse_records();
+    m_partial.clear();
+    begin = newline + 1;
+  }
+
+  // Records that lie entirely within the chunk are parsed in place
+  for (;;) {
+    const char *newline = reinterpret_cast<const char *>(memchr(begin, '\n', end - begin));
+    if (newline == NULL) {
+      break;
+    }
+
+    add_line(begin, newline);
+    begin = newline + 1;
+  }
+  parse_records();
+
+  m_partial.assign(begin, end);
+}
+
+nd::array dynd::ndjson_parser::finish() {
+  if (!m_partial.empty()) {
+    add_line(m_partial.data(), m_partial.data() + m_partial.size());
+    parse_records();
+  }
+
+  // Shrink-wrap the memory to just fit the records
+  const ndt::var_dim_type::metadata_type *md =
+      reinterpret_cast<const ndt::var_dim_type::metadata_type *>(m_result.get()->metadata());
+  ndt::var_dim_type::data_type *out = reinterpret_cast<ndt::var_dim_type::data_type *>(m_result.data());
+  if (out->begin != NULL) {
+    out->begin = md->blockref->resize(out->begin, m_size);
+  }
+  out->size = m_size;
+  m_result.get_type().extended()->arrmeta_finalize_buffers(m_result.get()->metadata());
+
+  nd::array result = m_result;
+  reset();
+
+  return result;
+}
+
+nd::array dynd::parse_ndjson(const ndt::type &tp, std::istream &in, size_t chunk_size,
+                             const eval::eval_context *ectx) {
+  // Reading zero bytes never reaches the end of the stream, and the read size is a signed streamsize
+  if (chunk_size == 0 || chunk_size > static_cast<size_t>(std::numeric_limits<std::streamsize>::max())) {
+    stringstream ss;
+    ss << "parse_ndjson: invalid chunk size " << chunk_size;
+    throw invalid_argument(ss.str());
+  }
+
+  ndjson_parser parser(tp, ectx);
+  std::unique_ptr<char[]> chunk(new char[chunk_size]);
+  while (in) {
+    in.read(chunk.get(), chunk_size);
+    parser.feed(chunk.get(), chunk.get() + in.gcount());
+  }
+  if (in.bad()) {
+    throw runtime_error("parse_ndjson: error reading the input stream");
+  }
+
+  return parser.finish();
+}
+
 /*
 static ndt::type discover_type(const char *&begin, const char *end)
 {
@@ -0,0 +1,56 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+
+#include <dynd/kernels/scratch_arena.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+// The smallest block the arena allocates, which holds the buffers of a few
+// nested kernels at the default chunk size
+const size_t min_scratch_block_size = 64 * 1024;
+
+} // anonymous namespace
+
+char *nd::scratch_arena::allocate(size_t size) {
+  size = (size + 15) & ~static_cast<size_t>(15);
+
+  // Find a block with room, starting from the current one. The memory of a block
+  // never moves, and is only replaced while nothing has been allocated from it.
+  for (;;) {
+    if (m_block == m_blocks.size()) {
+      block b;
+      b.size = std::max(size, min_scratch_block_size);
+      b.data.reset(new char[b.size]);
+      m_blocks.push_back(std::move(b));
+      break;
+    }
+    if (m_offset + size <= m_blocks[m_block].size) {
+      break;
+    }
+    if (m_offset == 0) {
+      // Nothing is in this block, so it can be replaced with a bigger one
+      m_blocks[m_block].data.reset(new char[size]);
+      m_blocks[m_block].size = size;
+      break;
+    }
+
+    ++m_block;
+    m_offset = 0;
+  }
+
+  char *result = m_blocks[m_block].data.get() + m_offset;
+  m_offset += size;
+  return result;
+}
+
+nd::scratch_arena &nd::get_scratch_arena() {
+  static thread_local scratch_arena arena;
+  return arena;
+}
@@ -10,4 +10,5 @@
 using namespace std;
 using namespace dynd;
 
-DYND_API nd::callable nd::all = nd::functional::reduction([] { return true; }, nd::make_callable<nd::all_callable>());
+DYND_API nd::callable nd::all =
+    nd::functional::reduction([] { return true; }, nd::make_callable<nd::all_callable>(), nd::associative);
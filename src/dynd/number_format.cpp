@@ -0,0 +1,331 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstring>
+
+#include <dynd/number_format.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+const char digit_pairs[] = "00010203040506070809"
+                           "10111213141516171819"
+                           "20212223242526272829"
+                           "30313233343536373839"
+                           "40414243444546474849"
+                           "50515253545556575859"
+                           "60616263646566676869"
+                           "70717273747576777879"
+                           "80818283848586878889"
+                           "90919293949596979899";
+
+/**
+ * A floating point value ``f * 2^e`` with a 64-bit significand and no implied bits.
+ */
+struct diy_fp {
+  uint64_t f;
+  int e;
+
+  diy_fp(uint64_t f, int e) : f(f), e(e) {}
+
+  diy_fp operator-(const diy_fp &rhs) const { return diy_fp(f - rhs.f, e); }
+
+  // The upper 64 bits of the product, rounded
+  diy_fp operator*(const diy_fp &rhs) const {
+    uint64_t a = f >> 32, b = f & 0xFFFFFFFFu, c = rhs.f >> 32, d = rhs.f & 0xFFFFFFFFu;
+    uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    uint64_t mid = (bd >> 32) + (ad & 0xFFFFFFFFu) + (bc & 0xFFFFFFFFu) + (UINT64_C(1) << 31);
+    return diy_fp(ac + (ad >> 32) + (bc >> 32) + (mid >> 32), e + rhs.e + 64);
+  }
+
+  diy_fp normalized() const {
+    diy_fp x = *this;
+    while ((x.f >> 63) == 0) {
+      x.f <<= 1;
+      --x.e;
+    }
+    return x;
+  }
+};
+
+struct cached_power {
+  uint64_t f;
+  int e;
+  int k;
+};
+
+// Normalized approximations of 10^k for k from -300 to 324 in steps of 8
+const cached_power cached_powers[] = {
+    {UINT64_C(0xAB70FE17C79AC6CA), -1060, -300}, {UINT64_C(0xFF77B1FCBEBCDC4F), -1034, -292},
+    {UINT64_C(0xBE5691EF416BD60C), -1007, -284}, {UINT64_C(0x8DD01FAD907FFC3C), -980, -276},
+    {UINT64_C(0xD3515C2831559A83), -954, -268}, {UINT64_C(0x9D71AC8FADA6C9B5), -927, -260},
+    {UINT64_C(0xEA9C227723EE8BCB), -901, -252}, {UINT64_C(0xAECC49914078536D), -874, -244},
+    {UINT64_C(0x823C12795DB6CE57), -847, -236}, {UINT64_C(0xC21094364DFB5637), -821, -228},
+    {UINT64_C(0x9096EA6F3848984F), -794, -220}, {UINT64_C(0xD77485CB25823AC7), -768, -212},
+    {UINT64_C(0xA086CFCD97BF97F4), -741, -204}, {UINT64_C(0xEF340A98172AACE5), -715, -196},
+    {UINT64_C(0xB23867FB2A35B28E), -688, -188}, {UINT64_C(0x84C8D4DFD2C63F3B), -661, -180},
+    {UINT64_C(0xC5DD44271AD3CDBA), -635, -172}, {UINT64_C(0x936B9FCEBB25C996), -608, -164},
+    {UINT64_C(0xDBAC6C247D62A584), -582, -156}, {UINT64_C(0xA3AB66580D5FDAF6), -555, -148},
+    {UINT64_C(0xF3E2F893DEC3F126), -529, -140}, {UINT64_C(0xB5B5ADA8AAFF80B8), -502, -132},
+    {UINT64_C(0x87625F056C7C4A8B), -475, -124}, {UINT64_C(0xC9BCFF6034C13053), -449, -116},
+    {UINT64_C(0x964E858C91BA2655), -422, -108}, {UINT64_C(0xDFF9772470297EBD), -396, -100},
+    {UINT64_C(0xA6DFBD9FB8E5B88F), -369, -92}, {UINT64_C(0xF8A95FCF88747D94), -343, -84},
+    {UINT64_C(0xB94470938FA89BCF), -316, -76}, {UINT64_C(0x8A08F0F8BF0F156B), -289, -68},
+    {UINT64_C(0xCDB02555653131B6), -263, -60}, {UINT64_C(0x993FE2C6D07B7FAC), -236, -52},
+    {UINT64_C(0xE45C10C42A2B3B06), -210, -44}, {UINT64_C(0xAA242499697392D3), -183, -36},
+    {UINT64_C(0xFD87B5F28300CA0E), -157, -28}, {UINT64_C(0xBCE5086492111AEB), -130, -20},
+    {UINT64_C(0x8CBCCC096F5088CC), -103, -12}, {UINT64_C(0xD1B71758E219652C), -77, -4},
+    {UINT64_C(0x9C40000000000000), -50, 4}, {UINT64_C(0xE8D4A51000000000), -24, 12},
+    {UINT64_C(0xAD78EBC5AC620000), 3, 20}, {UINT64_C(0x813F3978F8940984), 30, 28},
+    {UINT64_C(0xC097CE7BC90715B3), 56, 36}, {UINT64_C(0x8F7E32CE7BEA5C70), 83, 44},
+    {UINT64_C(0xD5D238A4ABE98068), 109, 52}, {UINT64_C(0x9F4F2726179A2245), 136, 60},
+    {UINT64_C(0xED63A231D4C4FB27), 162, 68}, {UINT64_C(0xB0DE65388CC8ADA8), 189, 76},
+    {UINT64_C(0x83C7088E1AAB65DB), 216, 84}, {UINT64_C(0xC45D1DF942711D9A), 242, 92},
+    {UINT64_C(0x924D692CA61BE758), 269, 100}, {UINT64_C(0xDA01EE641A708DEA), 295, 108},
+    {UINT64_C(0xA26DA3999AEF774A), 322, 116}, {UINT64_C(0xF209787BB47D6B85), 348, 124},
+    {UINT64_C(0xB454E4A179DD1877), 375, 132}, {UINT64_C(0x865B86925B9BC5C2), 402, 140},
+    {UINT64_C(0xC83553C5C8965D3D), 428, 148}, {UINT64_C(0x952AB45CFA97A0B3), 455, 156},
+    {UINT64_C(0xDE469FBD99A05FE3), 481, 164}, {UINT64_C(0xA59BC234DB398C25), 508, 172},
+    {UINT64_C(0xF6C69A72A3989F5C), 534, 180}, {UINT64_C(0xB7DCBF5354E9BECE), 561, 188},
+    {UINT64_C(0x88FCF317F22241E2), 588, 196}, {UINT64_C(0xCC20CE9BD35C78A5), 614, 204},
+    {UINT64_C(0x98165AF37B2153DF), 641, 212}, {UINT64_C(0xE2A0B5DC971F303A), 667, 220},
+    {UINT64_C(0xA8D9D1535CE3B396), 694, 228}, {UINT64_C(0xFB9B7CD9A4A7443C), 720, 236},
+    {UINT64_C(0xBB764C4CA7A44410), 747, 244}, {UINT64_C(0x8BAB8EEFB6409C1A), 774, 252},
+    {UINT64_C(0xD01FEF10A657842C), 800, 260}, {UINT64_C(0x9B10A4E5E9913129), 827, 268},
+    {UINT64_C(0xE7109BFBA19C0C9D), 853, 276}, {UINT64_C(0xAC2820D9623BF429), 880, 284},
+    {UINT64_C(0x80444B5E7AA7CF85), 907, 292}, {UINT64_C(0xBF21E44003ACDD2D), 933, 300},
+    {UINT64_C(0x8E679C2F5E44FF8F), 960, 308}, {UINT64_C(0xD433179D9C8CB841), 986, 316},
+    {UINT64_C(0x9E19DB92B4E31BA9), 1013, 324},
+};
+
+/**
+ * Returns a power of ten ``c = 10^-k`` such that a normalized value with binary
+ * exponent ``e`` multiplied by ``c`` has an exponent in [-60, -32], so that its
+ * integral part fits in 32 bits.
+ */
+cached_power get_cached_power(int e) {
+  const int alpha = -60, min_decimal_exponent = -300, decimal_step = 8;
+  int f = alpha - e - 1;
+  // 78913 / 2^18 approximates log10(2)
+  int k = (f * 78913) / (1 << 18) + (f > 0);
+  return cached_powers[(-min_decimal_exponent + k + (decimal_step - 1)) / decimal_step];
+}
+
+/**
+ * Returns the number of decimal digits of ``n``, and sets ``pow10`` to the power
+ * of ten of its leading digit.
+ */
+int find_largest_pow10(uint32_t n, uint32_t &pow10) {
+  int digits = 10;
+  for (pow10 = 1000000000; pow10 > n && digits > 1; pow10 /= 10) {
+    --digits;
+  }
+  return digits;
+}
+
+/**
+ * Moves the last digit down towards ``w`` while the result stays within the
+ * boundaries and gets closer to it.
+ */
+void round_weed(char *buffer, int length, uint64_t dist, uint64_t delta, uint64_t rest, uint64_t ten_k) {
+  while (rest < dist && delta - rest >= ten_k && (rest + ten_k < dist || dist - rest > rest + ten_k - dist)) {
+    --buffer[length - 1];
+    rest += ten_k;
+  }
+}
+
+/**
+ * Generates the shortest digits of a value in ``[m_minus, m_plus]`` closest to
+ * ``w``, all scaled to have an exponent in [-60, -32].
+ */
+void generate_digits(char *buffer, int &length, int &decimal_exponent, diy_fp m_minus, diy_fp w, diy_fp m_plus) {
+  uint64_t delta = (m_plus - m_minus).f;
+  uint64_t dist = (m_plus - w).f;
+
+  const diy_fp one(UINT64_C(1) << -m_plus.e, m_plus.e);
+  uint32_t p1 = static_cast<uint32_t>(m_plus.f >> -one.e);
+  uint64_t p2 = m_plus.f & (one.f - 1);
+
+  // The digits of the integral part
+  uint32_t pow10;
+  for (int n = find_largest_pow10(p1, pow10); n > 0;) {
+    buffer[length++] = static_cast<char>('0' + p1 / pow10);
+    p1 %= pow10;
+    --n;
+    uint64_t rest = (static_cast<uint64_t>(p1) << -one.e) + p2;
+    if (rest <= delta) {
+      decimal_exponent += n;
+      round_weed(buffer, length, dist, delta, rest, static_cast<uint64_t>(pow10) << -one.e);
+      return;
+    }
+    pow10 /= 10;
+  }
+
+  // The digits of the fractional part, which are needed when the interval is narrower than one
+  int m = 0;
+  for (;;) {
+    p2 *= 10;
+    buffer[length++] = static_cast<char>('0' + (p2 >> -one.e));
+    p2 &= one.f - 1;
+    ++m;
+    delta *= 10;
+    dist *= 10;
+    if (p2 <= delta) {
+      break;
+    }
+  }
+  decimal_exponent -= m;
+  round_weed(buffer, length, dist, delta, p2, one.f);
+}
+
+/**
+ * Generates the digits of the positive finite value with the given significand
+ * and biased exponent fields, such that the value is ``digits * 10^decimal_exponent``.
+ */
+void grisu2(char *buffer, int &length, int &decimal_exponent, uint64_t fraction, int exponent, int precision,
+            int bias) {
+  const uint64_t hidden_bit = UINT64_C(1) << (precision - 1);
+  diy_fp v = (exponent == 0) ? diy_fp(fraction, 1 - bias) : diy_fp(fraction + hidden_bit, exponent - bias);
+
+  // The boundaries halfway to the neighbouring values, with the lower one closer at a power of two
+  bool lower_boundary_is_closer = fraction == 0 && exponent > 1;
+  diy_fp m_plus = diy_fp(2 * v.f + 1, v.e - 1).normalized();
+  diy_fp m_minus = lower_boundary_is_closer ? diy_fp(4 * v.f - 1, v.e - 2) : diy_fp(2 * v.f - 1, v.e - 1);
+  m_minus = diy_fp(m_minus.f << (m_minus.e - m_plus.e), m_plus.e);
+  v = v.normalized();
+
+  cached_power cached = get_cached_power(m_plus.e);
+  diy_fp c(cached.f, cached.e);
+  diy_fp w = v * c, w_minus = m_minus * c, w_plus = m_plus * c;
+
+  // Shrink the interval by one unit to account for the error of the multiplications
+  length = 0;
+  decimal_exponent = -cached.k;
+  generate_digits(buffer, length, decimal_exponent, diy_fp(w_minus.f + 1, w_minus.e), w,
+                  diy_fp(w_plus.f - 1, w_plus.e));
+}
+
+/**
+ * Lays out the digits ``buffer * 10^decimal_exponent`` the way JavaScript does.
+ */
+char *format_digits(char *out, const char *buffer, int length, int decimal_exponent) {
+  // The position of the decimal point relative to the first digit
+  int n = length + decimal_exponent;
+
+  if (length <= n && n <= 21) {
+    memcpy(out, buffer, length);
+    memset(out + length, '0', n - length);
+    return out + n;
+  }
+
+  if (0 < n && n <= 21) {
+    memcpy(out, buffer, n);
+    out[n] = '.';
+    memcpy(out + n + 1, buffer + n, length - n);
+    return out + length + 1;
+  }
+
+  if (-6 < n && n <= 0) {
+    out[0] = '0';
+    out[1] = '.';
+    memset(out + 2, '0', -n);
+    memcpy(out + 2 - n, buffer, length);
+    return out + 2 - n + length;
+  }
+
+  *out++ = buffer[0];
+  if (length > 1) {
+    *out++ = '.';
+    memcpy(out, buffer + 1, length - 1);
+    out += length - 1;
+  }
+  *out++ = 'e';
+  *out++ = (n - 1 < 0) ? '-' : '+';
+  return format_uint(out, static_cast<uint64_t>(n - 1 < 0 ? 1 - n : n - 1));
+}
+
+/**
+ * Formats the binary floating point value with the given bits, where
+ * ``precision`` counts the implied leading bit of the significand.
+ */
+char *format_binary_float(char *out, uint64_t bits, int precision, int exponent_bits) {
+  uint64_t fraction = bits & ((UINT64_C(1) << (precision - 1)) - 1);
+  int exponent = static_cast<int>((bits >> (precision - 1)) & ((UINT64_C(1) << exponent_bits) - 1));
+  bool negative = ((bits >> (precision - 1 + exponent_bits)) & 1) != 0;
+
+  if (exponent == (1 << exponent_bits) - 1) {
+    if (fraction != 0) {
+      memcpy(out, "nan", 3);
+      return out + 3;
+    }
+    if (negative) {
+      *out++ = '-';
+    }
+    memcpy(out, "inf", 3);
+    return out + 3;
+  }
+
+  if (negative) {
+    *out++ = '-';
+  }
+  if (exponent == 0 && fraction == 0) {
+    *out++ = '0';
+    return out;
+  }
+
+  char buffer[20];
+  int length, decimal_exponent;
+  int bias = (1 << (exponent_bits - 1)) - 1 + (precision - 1);
+  grisu2(buffer, length, decimal_exponent, fraction, exponent, precision, bias);
+  return format_digits(out, buffer, length, decimal_exponent);
+}
+
+} // anonymous namespace
+
+char *dynd::format_uint(char *out, uint64_t value) {
+  // Write the digits backwards into a buffer, two at a time
+  char buffer[20];
+  char *end = buffer + sizeof(buffer), *begin = end;
+  while (value >= 100) {
+    begin -= 2;
+    memcpy(begin, digit_pairs + 2 * (value % 100), 2);
+    value /= 100;
+  }
+  if (value >= 10) {
+    begin -= 2;
+    memcpy(begin, digit_pairs + 2 * value, 2);
+  } else {
+    *--begin = static_cast<char>('0' + value);
+  }
+
+  memcpy(out, begin, end - begin);
+  return out + (end - begin);
+}
+
+char *dynd::format_int(char *out, int64_t value) {
+  if (value < 0) {
+    *out++ = '-';
+    // Negating in unsigned arithmetic handles the most negative value
+    return format_uint(out, 0 - static_cast<uint64_t>(value));
+  }
+
+  return format_uint(out, static_cast<uint64_t>(value));
+}
+
+char *dynd::format_double(char *out, double value) {
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return format_binary_float(out, bits, 53, 11);
+}
+
+char *dynd::format_float(char *out, float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return format_binary_float(out, bits, 24, 8);
+}
+
+char *dynd::format_float16(char *out, float16 value) { return format_binary_float(out, value.bits(), 11, 5); }
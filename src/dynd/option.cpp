@@ -14,14 +14,14 @@ using namespace dynd;
 
 namespace {
 
-static std::vector<ndt::type> assign_na_func_ptr(const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc),
-                                                 const ndt::type *DYND_UNUSED(src_tp)) {
-  return {dst_tp};
+static void assign_na_func_ptr(const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc),
+                               const ndt::type *DYND_UNUSED(src_tp), ndt::type *res_tp) {
+  res_tp[0] = dst_tp;
 }
 
-static std::vector<ndt::type> is_na_func_ptr(const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc),
-                                             const ndt::type *src_tp) {
-  return {src_tp[0]};
+static void is_na_func_ptr(const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+                           ndt::type *res_tp) {
+  res_tp[0] = src_tp[0];
 }
 
 nd::callable make_assign_na() {
@@ -19,14 +19,14 @@ using namespace dynd;
 
 namespace {
 
-static std::vector<ndt::type> func_ptr(const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc),
-                                       const ndt::type *src_tp) {
-  return {src_tp[0]};
+static void func_ptr(const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+                     ndt::type *res_tp) {
+  res_tp[0] = src_tp[0];
 }
 
-static std::vector<ndt::type> func_ptr_dst(const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc),
-                                           const ndt::type *DYND_UNUSED(src_tp)) {
-  return {dst_tp};
+static void func_ptr_dst(const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
+                         ndt::type *res_tp) {
+  res_tp[0] = dst_tp;
 }
 
 } // unnnamed namespace
@@ -40,7 +40,8 @@ DYND_API nd::callable nd::max = nd::functional::reduction(
     nd::make_callable<nd::multidispatch_callable<1>>(
         ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::scalar_kind_type>(),
                                            {ndt::make_type<ndt::scalar_kind_type>()}),
-        nd::callable::make_all<nd::max_callable, arithmetic_types>(func_ptr)));
+        nd::callable::make_all<nd::max_callable, arithmetic_types>(func_ptr)),
+    nd::associative);
 
 DYND_API nd::callable nd::mean = nd::make_callable<nd::mean_callable>(ndt::make_type<int64_t>());
 
@@ -53,4 +54,5 @@ DYND_API nd::callable nd::min = nd::functional::reduction(
     nd::make_callable<nd::multidispatch_callable<1>>(
         ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::scalar_kind_type>(),
                                            {ndt::make_type<ndt::scalar_kind_type>()}),
-        nd::callable::make_all<nd::min_callable, arithmetic_types>(func_ptr)));
+        nd::callable::make_all<nd::min_callable, arithmetic_types>(func_ptr)),
+    nd::associative);
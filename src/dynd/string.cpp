@@ -4,6 +4,7 @@
 //
 
 #include <dynd/functional.hpp>
+#include <dynd/callables/multidispatch_callable.hpp>
 #include <dynd/callables/string_concat_callable.hpp>
 #include <dynd/callables/string_count_callable.hpp>
 #include <dynd/callables/string_find_callable.hpp>
@@ -13,26 +14,64 @@
 #include <dynd/callables/string_startswith_callable.hpp>
 #include <dynd/callables/string_endswith_callable.hpp>
 #include <dynd/callables/string_contains_callable.hpp>
+#include <dynd/callables/string_contains_any_callable.hpp>
 #include <dynd/string.hpp>
+#include <dynd/types/string_kind_type.hpp>
 
 using namespace std;
 using namespace dynd;
 
+namespace {
+
+typedef type_sequence<dynd::string, dynd::string_view> string_types;
+
+/**
+ * Makes a callable that applies ``CallableType`` elementwise to any combination of
+ * ``string`` and ``string_view`` arguments.
+ */
+template <template <typename...> class CallableType>
+nd::callable make_string_callable(const ndt::type &ret_tp) {
+  return nd::functional::elwise(nd::make_callable<nd::multidispatch_callable<2>>(
+      ndt::make_type<ndt::callable_type>(ret_tp, {ndt::make_type<ndt::string_kind_type>(),
+                                                  ndt::make_type<ndt::string_kind_type>()}),
+      nd::callable::make_all<CallableType, string_types, string_types>(
+          [](const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+             ndt::type *res_tp) {
+            res_tp[0] = src_tp[0];
+            res_tp[1] = src_tp[1];
+          })));
+}
+
+} // anonymous namespace
+
 DYND_API nd::callable nd::string_concatenation =
     nd::functional::elwise(nd::make_callable<nd::string_concat_callable>());
 
-DYND_API nd::callable nd::string_count = nd::functional::elwise(nd::make_callable<nd::string_count_callable>());
+DYND_API nd::callable nd::string_count = make_string_callable<nd::string_count_callable>(ndt::make_type<intptr_t>());
 
-DYND_API nd::callable nd::string_find = nd::functional::elwise(nd::make_callable<nd::string_find_callable>());
+DYND_API nd::callable nd::string_find = make_string_callable<nd::string_find_callable>(ndt::make_type<intptr_t>());
 
-DYND_API nd::callable nd::string_rfind = nd::functional::elwise(nd::make_callable<nd::string_rfind_callable>());
+DYND_API nd::callable nd::string_rfind = make_string_callable<nd::string_rfind_callable>(ndt::make_type<intptr_t>());
 
 DYND_API nd::callable nd::string_replace = nd::functional::elwise(nd::make_callable<nd::string_replace_callable>());
 
-DYND_API nd::callable nd::string_split = nd::functional::elwise(nd::make_callable<nd::string_split_callable>());
+DYND_API nd::callable nd::string_split =
+    make_string_callable<nd::string_split_callable>(ndt::type("var * String"));
+
+DYND_API nd::callable nd::string_split_offsets =
+    make_string_callable<nd::string_split_offsets_callable>(ndt::type("var * 2 * intptr"));
+
+DYND_API nd::callable nd::string_startswith =
+    make_string_callable<nd::string_startswith_callable>(ndt::make_type<bool1>());
 
-DYND_API nd::callable nd::string_startswith = nd::functional::elwise(nd::make_callable<nd::string_startswith_callable>());
+DYND_API nd::callable nd::string_endswith = make_string_callable<nd::string_endswith_callable>(ndt::make_type<bool1>());
 
-DYND_API nd::callable nd::string_endswith = nd::functional::elwise(nd::make_callable<nd::string_endswith_callable>());
+DYND_API nd::callable nd::string_contains = make_string_callable<nd::string_contains_callable>(ndt::make_type<bool1>());
 
-DYND_API nd::callable nd::string_contains = nd::functional::elwise(nd::make_callable<nd::string_contains_callable>());
+DYND_API nd::callable nd::string_contains_any = nd::functional::elwise(nd::make_callable<nd::multidispatch_callable<1>>(
+    ndt::make_type<ndt::callable_type>(
+        ndt::make_type<bool1>(), {ndt::make_type<ndt::string_kind_type>()},
+        {{ndt::make_type<ndt::fixed_dim_kind_type>(ndt::make_type<ndt::string_kind_type>()), "patterns"}}),
+    nd::callable::make_all<nd::string_contains_any_callable, string_types>(
+        [](const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+           ndt::type *res_tp) { res_tp[0] = src_tp[0]; })));
@@ -3,15 +3,25 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <algorithm>
 #include <sstream>
 
 #include <dynd/string_encodings.hpp>
 #include <dynd/type.hpp>
+#include <dynd/kernels/contiguous_loop.hpp>
 #include <dynd/types/char_type.hpp>
 #include <dynd/types/fixed_bytes_type.hpp>
 
 #include <utf8.h>
 
+#ifdef DYND_TARGET_AVX2
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define DYND_STRING_ENCODINGS_SSE2
+#endif
+
 using namespace std;
 using namespace dynd;
 
@@ -323,6 +333,131 @@ void noerror_append_utf32(uint32_t cp, char *&it_raw, char *DYND_UNUSED(end_raw)
   *it = cp;
   ++it;
 }
+
+// The ascii_run_* functions return how many leading code units have values from
+// 1 to 0x7f. Those are the same characters in every encoding, so a run of them can
+// be copied without decoding. NUL is left to the per-character loops, which treat
+// it as the terminator of fixed-size strings.
+template <typename UnitType>
+inline bool is_ascii_unit(UnitType unit) {
+  return static_cast<UnitType>(unit - 1) < 0x7f;
+}
+
+template <typename UnitType>
+size_t ascii_run_default(const UnitType *src, size_t n) {
+  size_t i = 0;
+  // Test whole blocks first, which compilers turn into vector compares
+  for (; i + 16 <= n; i += 16) {
+    bool all_ascii = true;
+    for (size_t j = 0; j < 16; ++j) {
+      all_ascii &= is_ascii_unit(src[i + j]);
+    }
+    if (!all_ascii) {
+      break;
+    }
+  }
+  while (i < n && is_ascii_unit(src[i])) {
+    ++i;
+  }
+
+  return i;
+}
+
+#ifdef DYND_STRING_ENCODINGS_SSE2
+size_t ascii_run_sse2(const uint8_t *src, size_t n) {
+  const __m128i zero = _mm_setzero_si128();
+
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    // The high bit is set for bytes which are NUL or not ASCII
+    uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(block, _mm_cmpeq_epi8(block, zero))));
+    if (mask != 0) {
+      return i + nd::detail::count_trailing_zeros(mask);
+    }
+  }
+
+  return i + ascii_run_default(src + i, n - i);
+}
+#endif
+
+#ifdef DYND_TARGET_AVX2
+DYND_TARGET_AVX2 size_t ascii_run_avx2(const uint8_t *src, size_t n) {
+  const __m256i zero = _mm256_setzero_si256();
+
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    uint32_t mask =
+        static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(block, _mm256_cmpeq_epi8(block, zero))));
+    if (mask != 0) {
+      return i + nd::detail::count_trailing_zeros(mask);
+    }
+  }
+
+  return i + ascii_run_default(src + i, n - i);
+}
+#endif
+
+typedef size_t (*ascii_run_function_t)(const uint8_t *, size_t);
+
+ascii_run_function_t get_ascii_run_function() {
+#ifdef DYND_TARGET_AVX2
+  if (nd::detail::get_simd_level() != nd::detail::simd_level_default) {
+    return &ascii_run_avx2;
+  }
+#endif
+#ifdef DYND_STRING_ENCODINGS_SSE2
+  return &ascii_run_sse2;
+#else
+  return &ascii_run_default<uint8_t>;
+#endif
+}
+
+template <typename UnitType>
+size_t ascii_run(const UnitType *src, size_t n) {
+  return ascii_run_default(src, n);
+}
+
+template <>
+size_t ascii_run(const uint8_t *src, size_t n) {
+  static const ascii_run_function_t f = get_ascii_run_function();
+  return f(src, n);
+}
+
+template <typename DstUnitType, typename SrcUnitType>
+void transcode_ascii(char *&dst_raw, char *dst_end_raw, const char *&src_raw, const char *src_end_raw) {
+  DstUnitType *dst = reinterpret_cast<DstUnitType *>(dst_raw);
+  const SrcUnitType *src = reinterpret_cast<const SrcUnitType *>(src_raw);
+  size_t n = std::min(static_cast<size_t>(dst_end_raw - dst_raw) / sizeof(DstUnitType),
+                      static_cast<size_t>(src_end_raw - src_raw) / sizeof(SrcUnitType));
+
+  n = ascii_run(src, n);
+  if (sizeof(DstUnitType) == sizeof(SrcUnitType)) {
+    memcpy(dst, src, n * sizeof(DstUnitType));
+  } else {
+    for (size_t i = 0; i < n; ++i) {
+      dst[i] = static_cast<DstUnitType>(src[i]);
+    }
+  }
+
+  dst_raw += n * sizeof(DstUnitType);
+  src_raw += n * sizeof(SrcUnitType);
+}
+
+template <typename DstUnitType>
+transcode_ascii_t get_transcode_ascii_from(string_encoding_t src_encoding) {
+  switch (string_encoding_char_size_table[src_encoding]) {
+  case 1:
+    return &transcode_ascii<DstUnitType, uint8_t>;
+  case 2:
+    return &transcode_ascii<DstUnitType, uint16_t>;
+  case 4:
+    return &transcode_ascii<DstUnitType, uint32_t>;
+  default:
+    throw runtime_error("get_transcode_ascii_function: Unrecognized string encoding");
+  }
+}
 } // anonymous namespace
 
 next_unicode_codepoint_t dynd::get_next_unicode_codepoint_function(string_encoding_t encoding,
@@ -361,6 +496,28 @@ append_unicode_codepoint_t dynd::get_append_unicode_codepoint_function(string_en
   }
 }
 
+transcode_ascii_t dynd::get_transcode_ascii_function(string_encoding_t dst_encoding, string_encoding_t src_encoding) {
+  switch (string_encoding_char_size_table[dst_encoding]) {
+  case 1:
+    return get_transcode_ascii_from<uint8_t>(src_encoding);
+  case 2:
+    return get_transcode_ascii_from<uint16_t>(src_encoding);
+  case 4:
+    return get_transcode_ascii_from<uint32_t>(src_encoding);
+  default:
+    throw runtime_error("get_transcode_ascii_function: Unrecognized string encoding");
+  }
+}
+
+void dynd::validate_utf8_string(const char *begin, const char *end) {
+  while (begin < end) {
+    begin += ascii_run(reinterpret_cast<const uint8_t *>(begin), end - begin);
+    if (begin < end) {
+      next_utf8(begin, end);
+    }
+  }
+}
+
 template <next_unicode_codepoint_t next_fn>
 std::string string_range_as_utf8_string_templ(const char *begin, const char *end) {
   std::string result;
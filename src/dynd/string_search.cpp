@@ -0,0 +1,205 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+
+#include <dynd/string_search.hpp>
+#include <dynd/kernels/contiguous_loop.hpp>
+
+#ifdef DYND_TARGET_AVX2
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define DYND_STRING_SEARCH_SSE2
+#endif
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+/**
+ * Returns whether the needle is at ``candidate``, whose first and last bytes are
+ * already known to match.
+ */
+inline bool matches_inner(const char *candidate, const char *needle, size_t m) {
+  return m <= 2 || memcmp(candidate + 1, needle + 1, m - 2) == 0;
+}
+
+/**
+ * Finds candidates with ``memchr`` for the first byte, then checks the last byte
+ * before comparing the rest.
+ */
+intptr_t find_default(const char *haystack, size_t n, const char *needle, size_t m) {
+  const char *last = haystack + (n - m) + 1;
+  for (const char *c = haystack; c < last; ++c) {
+    c = reinterpret_cast<const char *>(memchr(c, needle[0], last - c));
+    if (c == NULL) {
+      return -1;
+    }
+    if (c[m - 1] == needle[m - 1] && matches_inner(c, needle, m)) {
+      return c - haystack;
+    }
+  }
+
+  return -1;
+}
+
+#ifdef DYND_STRING_SEARCH_SSE2
+/**
+ * Compares sixteen positions at a time against the first and last bytes of the
+ * needle, then compares the rest of the needle at the positions where both match.
+ */
+intptr_t find_sse2(const char *haystack, size_t n, const char *needle, size_t m) {
+  const __m128i first = _mm_set1_epi8(needle[0]);
+  const __m128i last = _mm_set1_epi8(needle[m - 1]);
+
+  size_t i = 0;
+  for (; i + m - 1 + 16 <= n; i += 16) {
+    __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(haystack + i));
+    __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i *>(haystack + i + m - 1));
+    uint32_t mask = static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last))));
+    while (mask != 0) {
+      size_t j = i + nd::detail::count_trailing_zeros(mask);
+      if (matches_inner(haystack + j, needle, m)) {
+        return j;
+      }
+      mask &= mask - 1;
+    }
+  }
+
+  intptr_t j = find_default(haystack + i, n - i, needle, m);
+  return j < 0 ? j : j + i;
+}
+#endif
+
+#ifdef DYND_TARGET_AVX2
+DYND_TARGET_AVX2 intptr_t find_avx2(const char *haystack, size_t n, const char *needle, size_t m) {
+  const __m256i first = _mm256_set1_epi8(needle[0]);
+  const __m256i last = _mm256_set1_epi8(needle[m - 1]);
+
+  size_t i = 0;
+  for (; i + m - 1 + 32 <= n; i += 32) {
+    __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(haystack + i));
+    __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(haystack + i + m - 1));
+    uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+        _mm256_and_si256(_mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(last, block_last))));
+    while (mask != 0) {
+      size_t j = i + nd::detail::count_trailing_zeros(mask);
+      if (matches_inner(haystack + j, needle, m)) {
+        return j;
+      }
+      mask &= mask - 1;
+    }
+  }
+
+  intptr_t j = find_default(haystack + i, n - i, needle, m);
+  return j < 0 ? j : j + i;
+}
+#endif
+
+typedef intptr_t (*find_function_t)(const char *, size_t, const char *, size_t);
+
+find_function_t get_find_function() {
+#ifdef DYND_TARGET_AVX2
+  if (nd::detail::get_simd_level() != nd::detail::simd_level_default) {
+    return &find_avx2;
+  }
+#endif
+#ifdef DYND_STRING_SEARCH_SSE2
+  return &find_sse2;
+#else
+  return &find_default;
+#endif
+}
+
+} // anonymous namespace
+
+intptr_t dynd::detail::string_find_short(const char *haystack, size_t n, const char *needle, size_t m) {
+  static const find_function_t find = get_find_function();
+
+  if (m > n) {
+    return -1;
+  }
+  return find(haystack, n, needle, m);
+}
+
+void dynd::detail::aho_corasick::assign(const std::vector<std::pair<const char *, size_t>> &patterns) {
+  // Bytes that appear in no pattern all behave the same, so share class 0
+  memset(m_classes, 0, sizeof(m_classes));
+  m_nclasses = 1;
+  for (const auto &pattern : patterns) {
+    for (size_t i = 0; i < pattern.second; ++i) {
+      uint8_t c = static_cast<uint8_t>(pattern.first[i]);
+      if (m_classes[c] == 0) {
+        m_classes[c] = static_cast<uint16_t>(m_nclasses++);
+      }
+    }
+  }
+
+  // Build the trie of the patterns, with state 0 as the root and 0 as "no edge"
+  m_transitions.assign(m_nclasses, 0);
+  m_accepting.assign(1, 0);
+  for (const auto &pattern : patterns) {
+    if (pattern.second == 0) {
+      continue;
+    }
+    uint32_t state = 0;
+    for (size_t i = 0; i < pattern.second; ++i) {
+      uint32_t &next = m_transitions[state * m_nclasses + m_classes[static_cast<uint8_t>(pattern.first[i])]];
+      if (next == 0) {
+        next = static_cast<uint32_t>(m_accepting.size());
+        m_accepting.push_back(0);
+        m_transitions.resize(m_transitions.size() + m_nclasses, 0);
+      }
+      state = m_transitions[state * m_nclasses + m_classes[static_cast<uint8_t>(pattern.first[i])]];
+    }
+    m_accepting[state] = 1;
+  }
+
+  // Fill in the missing edges breadth first from the failure links, so matching
+  // takes exactly one transition per byte
+  std::vector<uint32_t> failure(m_accepting.size(), 0);
+  std::deque<uint32_t> queue;
+  for (size_t c = 0; c < m_nclasses; ++c) {
+    if (m_transitions[c] != 0) {
+      queue.push_back(m_transitions[c]);
+    }
+  }
+  while (!queue.empty()) {
+    uint32_t state = queue.front();
+    queue.pop_front();
+    // A state whose longest proper suffix matches a pattern also matches it
+    if (m_accepting[failure[state]]) {
+      m_accepting[state] = 1;
+    }
+    for (size_t c = 0; c < m_nclasses; ++c) {
+      uint32_t &next = m_transitions[state * m_nclasses + c];
+      uint32_t fallback = m_transitions[failure[state] * m_nclasses + c];
+      if (next == 0) {
+        next = fallback;
+      } else {
+        failure[next] = fallback;
+        queue.push_back(next);
+      }
+    }
+  }
+}
+
+bool dynd::detail::aho_corasick::contains_any(const char *begin, const char *end) const {
+  uint32_t state = 0;
+  for (; begin != end; ++begin) {
+    state = m_transitions[state * m_nclasses + m_classes[static_cast<uint8_t>(*begin)]];
+    if (m_accepting[state]) {
+      return true;
+    }
+  }
+
+  return false;
+}
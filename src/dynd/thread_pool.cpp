@@ -0,0 +1,210 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <dynd/thread_pool.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+thread_local bool parallel_region = false;
+
+// The part of the range that one participant has yet to evaluate
+struct work_range {
+  std::mutex mutex;
+  size_t begin;
+  size_t end;
+};
+
+struct parallel_job {
+  const std::function<void(size_t, size_t)> &func;
+  size_t grain;
+  size_t nparticipants;
+  std::unique_ptr<work_range[]> ranges;
+
+  std::atomic<bool> cancelled;
+  std::mutex exception_mutex;
+  std::exception_ptr exception;
+
+  parallel_job(const std::function<void(size_t, size_t)> &func, size_t size, size_t grain, size_t nparticipants)
+      : func(func), grain(grain), nparticipants(nparticipants), ranges(new work_range[nparticipants]),
+        cancelled(false) {
+    for (size_t i = 0; i < nparticipants; ++i) {
+      ranges[i].begin = size * i / nparticipants;
+      ranges[i].end = size * (i + 1) / nparticipants;
+    }
+  }
+
+  /**
+   * Takes the next chunk for participant ``i`` from its own range or, when that is
+   * empty, steals the back half of another participant's range.
+   */
+  bool next(size_t i, size_t &begin, size_t &end) {
+    work_range &own = ranges[i];
+    {
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if (own.begin < own.end) {
+        begin = own.begin;
+        end = std::min(begin + grain, own.end);
+        own.begin = end;
+        return true;
+      }
+    }
+
+    for (size_t k = 1; k < nparticipants; ++k) {
+      work_range &victim = ranges[(i + k) % nparticipants];
+
+      size_t stolen_begin, stolen_end;
+      {
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        size_t remaining = victim.end - victim.begin;
+        if (remaining == 0) {
+          continue;
+        }
+
+        stolen_end = victim.end;
+        stolen_begin = (remaining <= grain) ? victim.begin : victim.end - remaining / 2;
+        victim.end = stolen_begin;
+      }
+
+      // Only one range is locked at a time, so participants stealing from each other can't deadlock
+      begin = stolen_begin;
+      end = std::min(begin + grain, stolen_end);
+
+      std::lock_guard<std::mutex> lock(own.mutex);
+      own.begin = end;
+      own.end = stolen_end;
+      return true;
+    }
+
+    return false;
+  }
+
+  void run(size_t i) {
+    size_t begin, end;
+    while (!cancelled.load(std::memory_order_relaxed) && next(i, begin, end)) {
+      try {
+        func(begin, end);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(exception_mutex);
+        if (!exception) {
+          exception = std::current_exception();
+        }
+        cancelled = true;
+      }
+    }
+  }
+};
+
+class thread_pool {
+  std::mutex m_mutex;
+  std::condition_variable m_work_cv;
+  std::condition_variable m_done_cv;
+  size_t m_nthreads;
+
+  // The job being evaluated, and how many participants have joined and finished it
+  parallel_job *m_job;
+  size_t m_joined;
+  size_t m_finished;
+
+  void work() {
+    parallel_region = true;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+      m_work_cv.wait(lock, [this] { return m_job != nullptr && m_joined < m_job->nparticipants; });
+
+      parallel_job *job = m_job;
+      size_t i = m_joined++;
+
+      lock.unlock();
+      job->run(i);
+      lock.lock();
+
+      if (++m_finished == m_joined) {
+        m_done_cv.notify_all();
+      }
+    }
+  }
+
+public:
+  // Held by the thread currently running a job
+  std::mutex busy;
+
+  thread_pool() : m_nthreads(0), m_job(nullptr), m_joined(0), m_finished(0) {}
+
+  void run(parallel_job &job) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      // Grow the pool to enough workers for the other participants
+      for (; m_nthreads + 1 < job.nparticipants; ++m_nthreads) {
+        std::thread(&thread_pool::work, this).detach();
+      }
+
+      m_job = &job;
+      m_joined = 1;
+      m_finished = 0;
+    }
+    m_work_cv.notify_all();
+
+    // The calling thread is participant 0
+    parallel_region = true;
+    job.run(0);
+    parallel_region = false;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_job = nullptr;
+    ++m_finished;
+    m_done_cv.wait(lock, [this] { return m_finished == m_joined; });
+  }
+};
+
+thread_pool &get_thread_pool() {
+  // Never destroyed, as the detached workers may outlive static destruction
+  static thread_pool *pool = new thread_pool();
+  return *pool;
+}
+
+} // anonymous namespace
+
+void dynd::parallel_for(size_t nthreads, size_t size, size_t grain, const std::function<void(size_t, size_t)> &func) {
+  if (size == 0) {
+    return;
+  }
+
+  grain = std::max(grain, static_cast<size_t>(1));
+  size_t nparticipants = std::min(nthreads, (size + grain - 1) / grain);
+  if (nparticipants <= 1 || parallel_region) {
+    func(0, size);
+    return;
+  }
+
+  thread_pool &pool = get_thread_pool();
+  std::unique_lock<std::mutex> busy(pool.busy, std::try_to_lock);
+  if (!busy.owns_lock()) {
+    func(0, size);
+    return;
+  }
+
+  parallel_job job(func, size, grain, nparticipants);
+  pool.run(job);
+
+  if (job.exception) {
+    std::rethrow_exception(job.exception);
+  }
+}
+
+bool dynd::in_parallel_region() { return parallel_region; }
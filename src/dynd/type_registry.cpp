@@ -24,6 +24,7 @@
 #include <dynd/types/float_kind_type.hpp>
 #include <dynd/types/int_kind_type.hpp>
 #include <dynd/types/scalar_kind_type.hpp>
+#include <dynd/types/string_view_type.hpp>
 #include <dynd/types/struct_type.hpp>
 #include <dynd/types/uint_kind_type.hpp>
 #include <dynd/types/var_dim_type.hpp>
@@ -69,6 +70,7 @@ DYNDT_API vector<id_info> &detail::infos() {
       {"fixed_string", fixed_string_kind_id, ndt::type(), nullptr, &ndt::fixed_string_type::parse_type_args},
       {"char", string_kind_id, ndt::make_type<ndt::char_type>(), nullptr, &ndt::char_type::parse_type_args},
       {"string", string_kind_id, ndt::make_type<dynd::string>(), nullptr, nullptr},
+      {"string_view", string_kind_id, ndt::make_type<dynd::string_view>(), nullptr, nullptr},
       {"tuple", scalar_kind_id, ndt::type(), nullptr, nullptr},
       {"struct", scalar_kind_id, ndt::type(), nullptr, nullptr},
       {"Fixed", dim_kind_id, ndt::type(), &ndt::fixed_dim_kind_type::construct_type, nullptr},
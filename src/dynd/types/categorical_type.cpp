@@ -10,11 +10,14 @@
 #include <dynd/array_range.hpp>
 #include <dynd/assignment.hpp>
 #include <dynd/callable.hpp>
+#include <dynd/hash_util.hpp>
 #include <dynd/parse_util.hpp>
 #include <dynd/search.hpp>
+#include <dynd/thread_pool.hpp>
 #include <dynd/types/categorical_type.hpp>
 #include <dynd/types/datashape_parser.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
+#include <dynd/types/string_type.hpp>
 
 using namespace dynd;
 using namespace std;
@@ -104,6 +107,33 @@ public:
 //     assign_from_commensurate_category::scalar_to_contiguous_kernel
 // };
 
+/**
+ * Whether values of the category type are equal exactly when their bytes are,
+ * so they can be found through the hash table. Other types, e.g. floating point
+ * where 0.0 == -0.0, or structs with padding, keep the compare-based lookup.
+ */
+bool is_hashable_category_type(const ndt::type &tp) {
+  switch (tp.get_id()) {
+  case string_id:
+  case fixed_string_id:
+  case fixed_bytes_id:
+    return true;
+  default:
+    return tp.is_builtin() && (tp.get_base_id() == bool_kind_id || tp.get_base_id() == int_kind_id ||
+                               tp.get_base_id() == uint_kind_id);
+  }
+}
+
+void get_category_bytes(const ndt::type &tp, const char *data, const char *&begin, const char *&end) {
+  if (tp.get_id() == string_id) {
+    begin = reinterpret_cast<const dynd::string *>(data)->begin();
+    end = reinterpret_cast<const dynd::string *>(data)->end();
+  } else {
+    begin = data;
+    end = data + tp.get_data_size();
+  }
+}
+
 } // anoymous namespace
 
 /** This function converts the set of char* pointers into a strided immutable
@@ -210,6 +240,34 @@ ndt::categorical_type::categorical_type(type_id_t id, const nd::array &categorie
   }
   this->m_data_size = m_storage_type.get_data_size();
   this->m_data_alignment = (uint8_t)m_storage_type.get_data_alignment();
+
+  build_category_table();
+}
+
+void ndt::categorical_type::build_category_table() {
+  if (!is_hashable_category_type(m_category_tp)) {
+    return;
+  }
+
+  // Keep the table at most half full, so probe sequences stay short
+  size_t category_count = get_category_count();
+  size_t table_size = 8;
+  while (table_size < 2 * category_count) {
+    table_size *= 2;
+  }
+
+  m_category_table.assign(table_size, 0);
+  size_t mask = table_size - 1;
+  intptr_t stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(m_categories.get()->metadata())->stride;
+  for (size_t i = 0; i < category_count; ++i) {
+    const char *begin, *end;
+    get_category_bytes(m_category_tp, m_categories.cdata() + i * stride, begin, end);
+    size_t j = dynd::detail::hash_bytes(begin, end) & mask;
+    while (m_category_table[j] != 0) {
+      j = (j + 1) & mask;
+    }
+    m_category_table[j] = i + 1;
+  }
 }
 
 void ndt::categorical_type::print_data(std::ostream &o, const char *DYND_UNUSED(arrmeta), const char *data) const {
@@ -261,14 +319,36 @@ void ndt::categorical_type::get_shape(intptr_t ndim, intptr_t i, intptr_t *out_s
   }
 }
 
+intptr_t ndt::categorical_type::find_category_index(const char *category_arrmeta, const char *category_data) const {
+  if (m_category_table.empty()) {
+    type dst_tp = make_type<intptr_t>();
+    type src_tp[2] = {m_categories.get_type(), m_category_tp};
+    const char *src_arrmeta[2] = {m_categories.get()->metadata(), category_arrmeta};
+    char *src_data[2] = {const_cast<char *>(m_categories.cdata()), const_cast<char *>(category_data)};
+    return nd::binary_search->call(dst_tp, 2, src_tp, src_arrmeta, src_data, 0, NULL,
+                                   std::map<std::string, ndt::type>())
+        .as<intptr_t>();
+  }
+
+  const char *begin, *end;
+  get_category_bytes(m_category_tp, category_data, begin, end);
+  size_t size = end - begin;
+  size_t mask = m_category_table.size() - 1;
+  intptr_t stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(m_categories.get()->metadata())->stride;
+  for (size_t j = dynd::detail::hash_bytes(begin, end) & mask; m_category_table[j] != 0; j = (j + 1) & mask) {
+    intptr_t i = m_category_table[j] - 1;
+    const char *category_begin, *category_end;
+    get_category_bytes(m_category_tp, m_categories.cdata() + i * stride, category_begin, category_end);
+    if (size_t(category_end - category_begin) == size && memcmp(category_begin, begin, size) == 0) {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
 uint32_t ndt::categorical_type::get_value_from_category(const char *category_arrmeta, const char *category_data) const {
-  type dst_tp = make_type<intptr_t>();
-  type src_tp[2] = {m_categories.get_type(), m_category_tp};
-  const char *src_arrmeta[2] = {m_categories.get()->metadata(), category_arrmeta};
-  char *src_data[2] = {const_cast<char *>(m_categories.cdata()), const_cast<char *>(category_data)};
-  intptr_t i =
-      nd::binary_search->call(dst_tp, 2, src_tp, src_arrmeta, src_data, 0, NULL, std::map<std::string, ndt::type>())
-          .as<intptr_t>();
+  intptr_t i = find_category_index(category_arrmeta, category_data);
   if (i < 0) {
     stringstream ss;
     ss << "Unrecognized category value ";
@@ -291,18 +371,58 @@ uint32_t ndt::categorical_type::get_value_from_category(const nd::array &categor
     c.assign(category);
   }
 
-  intptr_t i = nd::binary_search(m_categories, c).as<intptr_t>();
-  if (i < 0) {
-    stringstream ss;
-    ss << "Unrecognized category value ";
-    m_category_tp.print_data(ss, c.get()->metadata(), c.data());
-    ss << " assigning to dynd type " << type(this, true);
-    throw std::runtime_error(ss.str());
+  return get_value_from_category(c.get()->metadata(), c.cdata());
+}
+
+void ndt::categorical_type::encode(size_t count, char *dst, intptr_t dst_stride, const char *src_arrmeta,
+                                   const char *src, intptr_t src_stride, const eval::eval_context *ectx) const {
+  type_id_t storage_id = m_storage_type.get_id();
+  auto encode_range = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      uint32_t value = get_value_from_category(src_arrmeta, src + i * src_stride);
+      char *dst_data = dst + i * dst_stride;
+      switch (storage_id) {
+      case uint8_id:
+        *reinterpret_cast<uint8_t *>(dst_data) = static_cast<uint8_t>(value);
+        break;
+      case uint16_id:
+        *reinterpret_cast<uint16_t *>(dst_data) = static_cast<uint16_t>(value);
+        break;
+      default:
+        *reinterpret_cast<uint32_t *>(dst_data) = value;
+        break;
+      }
+    }
+  };
+
+  // Only the hash table lookup is safe to share across threads
+  if (!m_category_table.empty() && ectx->nthreads > 1 && !in_parallel_region() && count >= 2 * ectx->grain_size) {
+    parallel_for(ectx->nthreads, count, ectx->grain_size, encode_range);
   } else {
-    return (uint32_t)unchecked_fixed_dim_get<intptr_t>(m_category_index_to_value, i);
+    encode_range(0, count);
   }
 }
 
+nd::array ndt::categorical_type::encode(const nd::array &values, const eval::eval_context *ectx) const {
+  intptr_t dim_size, src_stride;
+  type el_tp;
+  const char *el_arrmeta;
+  values.get_type().get_as_strided(values.get()->metadata(), &dim_size, &src_stride, &el_tp, &el_arrmeta);
+
+  nd::array src = values;
+  if (el_tp != m_category_tp) {
+    src = nd::empty(dim_size, m_category_tp);
+    src.assign(values);
+    src.get_type().get_as_strided(src.get()->metadata(), &dim_size, &src_stride, &el_tp, &el_arrmeta);
+  }
+
+  nd::array result = nd::empty(dim_size, type(this, true));
+  encode(dim_size, result.data(), reinterpret_cast<const fixed_dim_type_arrmeta *>(result.get()->metadata())->stride,
+         el_arrmeta, src.cdata(), src_stride, ectx);
+
+  return result;
+}
+
 const char *ndt::categorical_type::get_category_arrmeta() const {
   const char *arrmeta = m_categories.get()->metadata();
   m_categories.get_type().extended()->at_single(0, &arrmeta, NULL);
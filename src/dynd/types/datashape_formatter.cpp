@@ -100,6 +100,7 @@ static void format_dim_datashape(std::ostream &o, const ndt::type &tp, const cha
 static void format_string_datashape(std::ostream &o, const ndt::type &tp) {
   switch (tp.get_id()) {
   case string_id:
+  case string_view_id:
   case fixed_string_id:
     // data shape only has one kind of string
     o << "string";
@@ -140,6 +141,7 @@ static void format_datashape(std::ostream &o, const ndt::type &tp, const char *a
     break;
   case fixed_string_id:
   case string_id:
+  case string_view_id:
     format_string_datashape(o, tp);
     break;
   case complex_float32_id:
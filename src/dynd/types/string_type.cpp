@@ -21,15 +21,34 @@ void ndt::string_type::get_string_range(const char **out_begin, const char **out
   *out_end = reinterpret_cast<const string *>(data)->end();
 }
 
-void ndt::string_type::set_from_utf8_string(const char *DYND_UNUSED(arrmeta), char *dst, const char *utf8_begin,
+void ndt::string_type::set_from_utf8_string(const char *arrmeta, char *dst, const char *utf8_begin,
                                             const char *utf8_end, const eval::eval_context *ectx) const
+{
+  set_from_utf8_string(arrmeta, dst, utf8_begin, utf8_end, NULL, ectx);
+}
+
+void ndt::string_type::set_from_utf8_string(const char *DYND_UNUSED(arrmeta), char *dst, const char *utf8_begin,
+                                            const char *utf8_end, nd::base_memory_block *string_arena,
+                                            const eval::eval_context *ectx) const
 {
   assign_error_mode errmode = ectx->errmode;
+  if (errmode != assign_error_nocheck) {
+    // Checked decoding throws on invalid input, so the output would be the same bytes
+    validate_utf8_string(utf8_begin, utf8_end);
+    if (string_arena != NULL) {
+      reinterpret_cast<string *>(dst)->assign(utf8_begin, utf8_end - utf8_begin, *string_arena);
+    } else {
+      reinterpret_cast<string *>(dst)->assign(utf8_begin, utf8_end - utf8_begin);
+    }
+    return;
+  }
+
   const intptr_t src_charsize = 1;
   intptr_t dst_charsize = string_encoding_char_size_table[string_encoding_utf_8];
   char *dst_current;
   next_unicode_codepoint_t next_fn = get_next_unicode_codepoint_function(string_encoding_utf_8, errmode);
   append_unicode_codepoint_t append_fn = get_append_unicode_codepoint_function(string_encoding_utf_8, errmode);
+  transcode_ascii_t transcode_ascii = get_transcode_ascii_function(string_encoding_utf_8, string_encoding_utf_8);
   uint32_t cp;
 
   // Allocate the initial output as the src number of characters + some padding
@@ -41,6 +60,10 @@ void ndt::string_type::set_from_utf8_string(const char *DYND_UNUSED(arrmeta), ch
 
   dst_current = dst_begin;
   while (utf8_begin < utf8_end) {
+    transcode_ascii(dst_current, dst_end, utf8_begin, utf8_end);
+    if (utf8_begin == utf8_end) {
+      break;
+    }
     cp = next_fn(utf8_begin, utf8_end);
     // Append the codepoint, or increase the allocated memory as necessary
     if (dst_end - dst_current >= 8) {
@@ -58,7 +81,11 @@ void ndt::string_type::set_from_utf8_string(const char *DYND_UNUSED(arrmeta), ch
   }
 
   // Set the output
-  reinterpret_cast<string *>(dst)->assign(dst_d.begin(), dst_current - dst_begin);
+  if (string_arena != NULL) {
+    reinterpret_cast<string *>(dst)->assign(dst_d.begin(), dst_current - dst_begin, *string_arena);
+  } else {
+    reinterpret_cast<string *>(dst)->assign(dst_d.begin(), dst_current - dst_begin);
+  }
 }
 
 void ndt::string_type::print_data(std::ostream &o, const char *DYND_UNUSED(arrmeta), const char *data) const
@@ -3,8 +3,11 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <cstring>
+
 #include <dynd/buffer.hpp>
 #include <dynd/exceptions.hpp>
+#include <dynd/hash_util.hpp>
 #include <dynd/shape_tools.hpp>
 #include <dynd/types/any_kind_type.hpp>
 #include <dynd/types/str_util.hpp>
@@ -25,10 +28,38 @@ void ndt::struct_type::print_data(std::ostream &o, const char *arrmeta, const ch
   o << "]";
 }
 
-intptr_t ndt::struct_type::get_field_index(const std::string &name) const {
-  auto it = std::find(m_field_names.begin(), m_field_names.end(), name);
-  if (it != m_field_names.end()) {
-    return it - m_field_names.begin();
+void ndt::struct_type::build_field_name_table() {
+  // Keep the table at most half full, so probe sequences stay short
+  size_t table_size = 8;
+  while (table_size < 2 * static_cast<size_t>(m_field_count)) {
+    table_size *= 2;
+  }
+
+  m_field_name_table.assign(table_size, 0);
+  size_t mask = table_size - 1;
+  for (intptr_t i = 0; i < m_field_count; ++i) {
+    const std::string &name = m_field_names[i];
+    // With duplicate names, the first field wins as it would with a linear search
+    if (get_field_index(name.data(), name.data() + name.size()) == -1) {
+      size_t j = dynd::detail::hash_bytes(name.data(), name.data() + name.size()) & mask;
+      while (m_field_name_table[j] != 0) {
+        j = (j + 1) & mask;
+      }
+      m_field_name_table[j] = i + 1;
+    }
+  }
+}
+
+intptr_t ndt::struct_type::get_field_index(const char *name_begin, const char *name_end) const {
+  size_t size = name_end - name_begin;
+  size_t mask = m_field_name_table.size() - 1;
+  for (size_t j = dynd::detail::hash_bytes(name_begin, name_end) & mask; m_field_name_table[j] != 0;
+       j = (j + 1) & mask) {
+    intptr_t i = m_field_name_table[j] - 1;
+    const std::string &name = m_field_names[i];
+    if (name.size() == size && memcmp(name.data(), name_begin, size) == 0) {
+      return i;
+    }
   }
 
   return -1;
@@ -3,16 +3,21 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <stdexcept>
 
+#include "../test_eval_context.hpp"
 #include "../test_memory.hpp"
 
 #include <dynd/array.hpp>
 #include <dynd/assignment.hpp>
+#include <dynd/callable.hpp>
+#include <dynd/functional.hpp>
 #include <dynd/gtest.hpp>
 #include <dynd/json_parser.hpp>
+#include <dynd/kernels/base_strided_kernel.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -596,6 +601,125 @@ TEST(ArrayAssign, ArrayValsAtType) {
   }
 }
 
+namespace {
+
+// Copies an int, recording the longest run the elwise loops pass it at once
+struct max_run_kernel : nd::base_strided_kernel<max_run_kernel, 1> {
+  static size_t max_run;
+
+  void single(char *dst, char *const *src) { *reinterpret_cast<int *>(dst) = *reinterpret_cast<int *>(src[0]); }
+
+  void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+    max_run = std::max(max_run, count);
+    for (size_t i = 0; i < count; ++i) {
+      *reinterpret_cast<int *>(dst + static_cast<intptr_t>(i) * dst_stride) =
+          *reinterpret_cast<int *>(src[0] + static_cast<intptr_t>(i) * src_stride[0]);
+    }
+  }
+};
+
+size_t max_run_kernel::max_run = 0;
+
+} // unnamed namespace
+
+TEST(ArrayAssign, Transpose) {
+  nd::array a = nd::empty(300, 200, ndt::make_type<int>());
+  int *a_data = reinterpret_cast<int *>(a.data());
+  for (int i = 0; i < 60000; ++i) {
+    a_data[i] = i;
+  }
+
+  nd::array b = nd::empty(200, 300, ndt::make_type<int>());
+  b.assign(a.transpose());
+  const int *b_data = reinterpret_cast<const int *>(b.cdata());
+  for (int i = 0; i < 300; ++i) {
+    for (int j = 0; j < 200; ++j) {
+      ASSERT_EQ(200 * i + j, b_data[300 * j + i]);
+    }
+  }
+
+  // With a conversion, and into a transposed view
+  nd::array c = nd::empty(300, 200, ndt::make_type<double>());
+  c.transpose().assign(b);
+  const double *c_data = reinterpret_cast<const double *>(c.cdata());
+  for (int i = 0; i < 60000; ++i) {
+    ASSERT_EQ(i, c_data[i]);
+  }
+
+  nd::array d = nd::empty(20, 30, 40, ndt::make_type<int>());
+  int *d_data = reinterpret_cast<int *>(d.data());
+  for (int i = 0; i < 24000; ++i) {
+    d_data[i] = i;
+  }
+
+  nd::array e = nd::empty(30, 40, 20, ndt::make_type<int>());
+  e.assign(d.rotate(2, 0));
+  const int *e_data = reinterpret_cast<const int *>(e.cdata());
+  for (int i = 0; i < 20; ++i) {
+    for (int j = 0; j < 30; ++j) {
+      for (int k = 0; k < 40; ++k) {
+        ASSERT_EQ(1200 * i + 40 * j + k, e_data[800 * j + 20 * k + i]);
+      }
+    }
+  }
+
+  // Sizes that aren't multiples of the tile size leave partial tiles along both edges
+  for (intptr_t size0 : {65, 129, 300}) {
+    for (intptr_t size1 : {65, 200, 257}) {
+      nd::array src = nd::empty(size0, size1, ndt::make_type<int>());
+      int *src_data = reinterpret_cast<int *>(src.data());
+      for (intptr_t i = 0; i < size0 * size1; ++i) {
+        src_data[i] = static_cast<int>(i);
+      }
+
+      nd::array dst = nd::empty(size1, size0, ndt::make_type<int>());
+      dst.assign(src.transpose());
+      const int *dst_data = reinterpret_cast<const int *>(dst.cdata());
+      for (intptr_t i = 0; i < size0; ++i) {
+        for (intptr_t j = 0; j < size1; ++j) {
+          ASSERT_EQ(size1 * i + j, dst_data[size0 * j + i]) << "size " << size0 << " x " << size1;
+        }
+      }
+    }
+  }
+
+  // The child is called for each row of a tile, never for a whole row of the array
+  {
+    scoped_eval_context serial(1, eval::default_eval_context.grain_size);
+    nd::callable copy = nd::functional::elwise(nd::make_callable<max_run_kernel>(ndt::make_type<int(int)>()));
+
+    nd::array h = nd::empty(200, 300, ndt::make_type<int>());
+    max_run_kernel::max_run = 0;
+    copy({a.transpose()}, {{"dst", h}});
+    EXPECT_ARRAY_EQ(b, h);
+    EXPECT_GT(max_run_kernel::max_run, 0u);
+    EXPECT_LT(max_run_kernel::max_run, 200u);
+
+    // Without a transpose nothing is tiled, and the loops merge into one run
+    max_run_kernel::max_run = 0;
+    copy({b}, {{"dst", h}});
+    EXPECT_ARRAY_EQ(b, h);
+    EXPECT_EQ(60000u, max_run_kernel::max_run);
+  }
+
+  // Rows of tiles are split among threads
+  scoped_eval_context ectx(4, 1024);
+  nd::array f = nd::empty(200, 300, ndt::make_type<int>());
+  f.assign(a.transpose());
+  nd::array g = nd::empty(40, 20, 30, ndt::make_type<int>());
+  g.assign(d.rotate(0, 2));
+
+  EXPECT_ARRAY_EQ(b, f);
+  const int *g_data = reinterpret_cast<const int *>(g.cdata());
+  for (int i = 0; i < 20; ++i) {
+    for (int j = 0; j < 30; ++j) {
+      for (int k = 0; k < 40; ++k) {
+        ASSERT_EQ(1200 * i + 40 * j + k, g_data[600 * k + 30 * i + j]);
+      }
+    }
+  }
+}
+
 #if !(defined(_WIN32) && !defined(_M_X64)) // TODO: How to mark as expected failures in googletest?
 REGISTER_TYPED_TEST_CASE_P(ArrayAssign, ScalarAssignment_Bool, ScalarAssignment_Int8, ScalarAssignment_UInt16,
                            ScalarAssignment_Float32, ScalarAssignment_Float64, ScalarAssignment_Uint64,
@@ -5,9 +5,15 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <sstream>
 #include <stdexcept>
+#include <vector>
 
+#include <dynd/eval/eval_context.hpp>
 #include <dynd/gtest.hpp>
 #include <dynd/json_formatter.hpp>
 #include <dynd/json_parser.hpp>
@@ -48,6 +54,56 @@ TEST(JSONFormatter, Builtins) {
   EXPECT_EQ("null", format_json(a).as<std::string>());
 }
 
+TEST(JSONFormatter, Numbers) {
+  nd::array a;
+  a = numeric_limits<int64_t>::min();
+  EXPECT_EQ("-9223372036854775808", format_json(a).as<std::string>());
+  a = numeric_limits<uint64_t>::max();
+  EXPECT_EQ("18446744073709551615", format_json(a).as<std::string>());
+  a = (int32_t)0;
+  EXPECT_EQ("0", format_json(a).as<std::string>());
+
+  // Floating point values use the shortest digits that round trip
+  a = 0.1;
+  EXPECT_EQ("0.1", format_json(a).as<std::string>());
+  a = 0.1f;
+  EXPECT_EQ("0.1", format_json(a).as<std::string>());
+  a = 1.0 / 3.0;
+  EXPECT_EQ("0.3333333333333333", format_json(a).as<std::string>());
+  a = 100.0;
+  EXPECT_EQ("100", format_json(a).as<std::string>());
+  a = -0.0;
+  EXPECT_EQ("-0", format_json(a).as<std::string>());
+  a = 1.5e-7;
+  EXPECT_EQ("1.5e-7", format_json(a).as<std::string>());
+  a = 0.000001;
+  EXPECT_EQ("0.000001", format_json(a).as<std::string>());
+  a = 1e21;
+  EXPECT_EQ("1e+21", format_json(a).as<std::string>());
+  a = 123456789012345680000.0;
+  EXPECT_EQ("123456789012345680000", format_json(a).as<std::string>());
+  a = numeric_limits<double>::max();
+  EXPECT_EQ("1.7976931348623157e+308", format_json(a).as<std::string>());
+  a = numeric_limits<double>::denorm_min();
+  EXPECT_EQ("5e-324", format_json(a).as<std::string>());
+  a = numeric_limits<float>::max();
+  EXPECT_EQ("3.4028235e+38", format_json(a).as<std::string>());
+  a = dynd::complex<double>(1.5, -0.1);
+  EXPECT_EQ("(1.5 + -0.1j)", format_json(a).as<std::string>());
+
+  // Values spread over the whole range parse back exactly
+  uint64_t bits = 12345;
+  for (int i = 0; i < 10000; ++i) {
+    bits = bits * UINT64_C(6364136223846793005) + UINT64_C(1442695040888963407);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    if (std::isfinite(value)) {
+      a = value;
+      EXPECT_EQ(value, strtod(format_json(a).as<std::string>().c_str(), NULL));
+    }
+  }
+}
+
 TEST(JSONFormatter, String) {
   nd::array a;
   a = "testing string";
@@ -77,3 +133,56 @@ TEST(JSONFormatter, UniformDim) {
   a = parse_json("var * ?real", "[1.5, null, 3.125, 9.25, null, null]");
   EXPECT_EQ("[1.5,null,3.125,9.25,null,null]", format_json(a).as<std::string>());
 }
+
+TEST(JSONFormatter, Sink) {
+  nd::array a = parse_json("var * {a: int32, b: string}", "[{\"a\": 1, \"b\": \"one\"}, {\"a\": 2, \"b\": \"two\"}]");
+
+  // The output arrives in chunks no bigger than requested
+  std::string out;
+  size_t max_chunk = 0;
+  write_json(a, [&](const char *begin, const char *end) {
+    out.append(begin, end);
+    max_chunk = std::max(max_chunk, static_cast<size_t>(end - begin));
+  }, false, false, 8);
+  EXPECT_EQ(format_json(a).as<std::string>(), out);
+  EXPECT_LE(max_chunk, 8u);
+
+  // A chunk size of zero could never pass anything to the sink
+  EXPECT_THROW(write_json(a, [&](const char *, const char *) {}, false, false, 0), invalid_argument);
+  EXPECT_THROW(write_json(a, [&](const char *, const char *) {}, false, false, static_cast<size_t>(-1)),
+               invalid_argument);
+
+  stringstream ss;
+  write_json(a, ss, false, true);
+  EXPECT_EQ("{\"a\":1,\"b\":\"one\"}\n{\"a\":2,\"b\":\"two\"}\n", ss.str());
+
+  ss.str("");
+  write_json(nd::array(3.5), ss);
+  EXPECT_EQ("3.5", ss.str());
+  EXPECT_THROW(write_json(nd::array(3.5), ss, false, true), invalid_argument);
+}
+
+TEST(JSONFormatter, SinkParallel) {
+  std::vector<int64_t> vals(1000);
+  for (size_t i = 0; i < vals.size(); ++i) {
+    vals[i] = i * i;
+  }
+  nd::array a = nd::array(vals);
+
+  eval::eval_context ectx;
+  ectx.nthreads = 4;
+  ectx.grain_size = 16;
+  for (bool ndjson : {false, true}) {
+    stringstream serial, parallel;
+    write_json(a, serial, false, ndjson);
+    write_json(a, parallel, false, ndjson, &ectx);
+    EXPECT_EQ(serial.str(), parallel.str());
+  }
+
+  std::string out;
+  write_json(a, [&](const char *begin, const char *end) {
+    EXPECT_LE(end - begin, 64);
+    out.append(begin, end);
+  }, false, false, 64, &ectx);
+  EXPECT_EQ(format_json(a).as<std::string>(), out);
+}
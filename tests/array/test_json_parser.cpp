@@ -6,11 +6,16 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
 
 #include <dynd/callable.hpp>
+#include <dynd/eval/eval_context.hpp>
 #include <dynd/gtest.hpp>
+#include <dynd/json_index.hpp>
 #include <dynd/json_parser.hpp>
+#include <dynd/memblock/pod_memory_block.hpp>
+#include <dynd/number_parse.hpp>
 #include <dynd/parse.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
 #include <dynd/types/option_type.hpp>
@@ -108,6 +113,61 @@ TEST(JSONParser, BuiltinsFromFloat) {
   EXPECT_EQ(1.5e2, n.as<double>());
 }
 
+TEST(JSONParser, Numbers) {
+  nd::array n;
+
+  // Halfway cases round to even, and long inputs round by all of their digits
+  n = parse_json(ndt::make_type<double>(), "9007199254740993");
+  EXPECT_EQ(9007199254740992., n.as<double>());
+  n = parse_json(ndt::make_type<double>(), "9007199254740993.0000000000000000001");
+  EXPECT_EQ(9007199254740994., n.as<double>());
+  n = parse_json(ndt::make_type<double>(), "0.1000000000000000055511151231257827021181583404541015625");
+  EXPECT_EQ(0.1, n.as<double>());
+  n = parse_json(ndt::make_type<double>(), "-0.0");
+  EXPECT_TRUE(std::signbit(n.as<double>()));
+  n = parse_json(ndt::make_type<double>(), "1.7976931348623157e308");
+  EXPECT_EQ(numeric_limits<double>::max(), n.as<double>());
+  n = parse_json(ndt::make_type<double>(), "1.8e308");
+  EXPECT_EQ(numeric_limits<double>::infinity(), n.as<double>());
+  n = parse_json(ndt::make_type<double>(), "4.9406564584124654e-324");
+  EXPECT_EQ(numeric_limits<double>::denorm_min(), n.as<double>());
+  n = parse_json(ndt::make_type<double>(), "2.2250738585072011e-308");
+  EXPECT_EQ(2.2250738585072011e-308, n.as<double>());
+  n = parse_json(ndt::make_type<double>(), "1e-400");
+  EXPECT_EQ(0., n.as<double>());
+  n = parse_json(ndt::make_type<float>(), "16777217");
+  EXPECT_EQ(16777216.f, n.as<float>());
+  n = parse_json(ndt::make_type<float>(), "3.4028235e38");
+  EXPECT_EQ(numeric_limits<float>::max(), n.as<float>());
+  n = parse_json(ndt::make_type<float>(), "1.401298464324817e-45");
+  EXPECT_EQ(numeric_limits<float>::denorm_min(), n.as<float>());
+
+  // Integers of more than eight digits are consumed eight at a time
+  n = parse_json(ndt::make_type<uint64_t>(), "1234567890123456789");
+  EXPECT_EQ(1234567890123456789ULL, n.as<uint64_t>());
+  n = parse_json(ndt::make_type<int64_t>(), "-9223372036854775808");
+  EXPECT_EQ(numeric_limits<int64_t>::min(), n.as<int64_t>());
+  EXPECT_THROW(parse_json(ndt::make_type<uint8_t>(), "00000000256"), exception);
+
+  // Values spread over the whole range parse to the same value as strtod
+  uint64_t bits = 12345;
+  char buffer[64];
+  for (int i = 0; i < 10000; ++i) {
+    bits = bits * UINT64_C(6364136223846793005) + UINT64_C(1442695040888963407);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    if (std::isfinite(value)) {
+      int size = snprintf(buffer, sizeof(buffer), (i % 2) ? "%.17g" : "%.25e", value);
+      double parsed;
+      EXPECT_TRUE(parse_decimal_number(buffer, buffer + size, parsed));
+      EXPECT_EQ(strtod(buffer, NULL), parsed) << buffer;
+      float parsed_float;
+      EXPECT_TRUE(parse_decimal_number(buffer, buffer + size, parsed_float));
+      EXPECT_EQ(strtof(buffer, NULL), parsed_float) << buffer;
+    }
+  }
+}
+
 TEST(JSONParser, Struct) {
   nd::array n;
   ndt::type sdt = ndt::make_type<ndt::struct_type>({{ndt::make_type<int>(), "id"},
@@ -133,6 +193,14 @@ TEST(JSONParser, Struct) {
   EXPECT_EQ("Jean", n(2).as<std::string>());
   EXPECT_EQ("2012-09-19", n(3).as<std::string>());
 
+  // Keys in the declared order, with near misses of the next field name in between
+  n = parse_json(sdt, "{\"id\":24601,\"amoun\":1,\"amount\":3.75,\"nam\\u0065\":\"Jean\","
+                      " \"namex\":2,\"when\":\"2012-09-19\"}");
+  EXPECT_EQ(24601, n(0).as<int>());
+  EXPECT_EQ(3.75, n(1).as<double>());
+  EXPECT_EQ("Jean", n(2).as<std::string>());
+  EXPECT_EQ("2012-09-19", n(3).as<std::string>());
+
   // Every field must be populated, though
   EXPECT_THROW(parse_json(sdt, "{\"amount\":3.75,\"discarded\":[1,2,3],"
                                " \"when\":\"2012-09-19\",\"name\":\"Jean\"}"),
@@ -222,6 +290,167 @@ TEST(JSON, ParserWithMissingValue) {
   EXPECT_TRUE(a.p("y").is_na());
 }
 
+TEST(JSONParser, StructuralIndex) {
+  // Brackets and escaped quotes inside strings aren't structural, with the key's escape crossing a 64 byte block
+  std::string json = "{\"a\": [1, {\"b\": \"x]}\\\"\"}], \"" + std::string(35, 'c') + "\\\\\": \"[\\\\\\\"{\"}";
+  json_structural_index index(json.data(), json.data() + json.size());
+  ASSERT_TRUE(index.is_valid());
+
+  std::string structural;
+  for (size_t i = 0; i < index.size(); ++i) {
+    structural += *index[i];
+  }
+  EXPECT_EQ("{\"\"[{\"\"\"\"}]\"\"\"\"}", structural);
+
+  const char *begin = json.data();
+  EXPECT_EQ(begin + json.size(), index.skip(begin));
+  EXPECT_EQ(nullptr, index.skip(begin + 2));
+  const char *list = begin + json.find('[');
+  EXPECT_EQ(begin + json.find(']', json.find("\\\"")) + 1, index.skip(list));
+  const char *key = begin + json.find("\"ccc");
+  EXPECT_EQ(key + 39, index.skip(key));
+
+  json = "{\"a\": [1, 2}";
+  index.build(json.data(), json.data() + json.size());
+  EXPECT_FALSE(index.is_valid());
+  EXPECT_EQ(nullptr, index.skip(json.data()));
+}
+
+TEST(JSONParser, SkipUnknownFields) {
+  nd::array a = parse_json("var * {id: int32, name: string}",
+                           "[{\"x\": {\"y\": [1, \"]\", {\"z\": \"\\\"}\"}]}, \"id\": 1, \"name\": \"Alice\"},\n"
+                           " {\"name\": \"B\\\"ob\", \"w\": [[], {}, \"{\"], \"id\": 2, \"v\": null}]");
+  ASSERT_EQ(2, a.get_dim_size());
+  EXPECT_EQ(1, a(0, 0).as<int32_t>());
+  EXPECT_EQ("Alice", a(0, 1).as<std::string>());
+  EXPECT_EQ(2, a(1, 0).as<int32_t>());
+  EXPECT_EQ("B\"ob", a(1, 1).as<std::string>());
+
+  // Unbalanced input is still reported by the parser
+  EXPECT_THROW(parse_json("{id: int32, name: string}", "{\"x\": [1, 2}, \"id\": 1, \"name\": \"A\"}"),
+               invalid_argument);
+}
+
+TEST(JSONParser, NDJSON) {
+  ndjson_parser parser(ndt::type("{id: int32, name: string}"));
+  parser.feed("{\"id\": 1, \"name\": \"Alice\"}\n{\"id\": 2, ");
+  EXPECT_EQ(1u, parser.size());
+  parser.feed("\"name\": \"Bob\"}\n\n{\"id\": 3, \"na");
+  parser.feed("me\": \"A name longer than the short string buffer\"}");
+  EXPECT_EQ(2u, parser.size());
+
+  nd::array a = parser.finish();
+  EXPECT_EQ(ndt::type("var * {id: int32, name: string}"), a.get_type());
+  ASSERT_EQ(3, a.get_dim_size());
+  EXPECT_EQ(1, a(0, 0).as<int32_t>());
+  EXPECT_EQ("Alice", a(0, 1).as<std::string>());
+  EXPECT_EQ(2, a(1, 0).as<int32_t>());
+  EXPECT_EQ("Bob", a(1, 1).as<std::string>());
+  EXPECT_EQ(3, a(2, 0).as<int32_t>());
+  EXPECT_EQ("A name longer than the short string buffer", a(2, 1).as<std::string>());
+
+  // The parser starts over after finishing
+  EXPECT_EQ(0u, parser.size());
+  EXPECT_EQ(0, parser.finish().get_dim_size());
+
+  // Errors give the line of the bad record
+  parser.feed("{\"id\": 4, \"name\": \"w\"}\n{\"id\": 5, \"name\": \"x\"}\n");
+  try {
+    parser.feed("{\"id\": 6, \"name\": \"y\"}\n{\"id\": true, \"name\": \"z\"}\n");
+    FAIL() << "expected an invalid_argument exception";
+  } catch (const invalid_argument &e) {
+    EXPECT_NE(std::string::npos, std::string(e.what()).find("line 4"));
+  }
+}
+
+TEST(JSONParser, NDJSONStream) {
+  std::stringstream ss;
+  for (int i = 0; i < 10000; ++i) {
+    ss << "[" << i << ", \"" << std::string(i % 40, 'a') << "\"]\n";
+  }
+
+  // A small chunk size splits most records across chunks
+  nd::array a = parse_ndjson(ndt::type("(int64, string)"), ss, 7);
+  ASSERT_EQ(10000, a.get_dim_size());
+  for (int i = 0; i < 10000; i += 37) {
+    EXPECT_EQ(i, a(i, 0).as<int64_t>());
+    EXPECT_EQ(std::string(i % 40, 'a'), a(i, 1).as<std::string>());
+  }
+
+  // A chunk size of zero would never reach the end of the stream
+  ss.clear();
+  ss.seekg(0);
+  EXPECT_THROW(parse_ndjson(ndt::type("(int64, string)"), ss, 0), invalid_argument);
+  EXPECT_THROW(parse_ndjson(ndt::type("(int64, string)"), ss, static_cast<size_t>(-1)), invalid_argument);
+}
+
+TEST(JSONParser, Parallel) {
+  eval::eval_context ectx;
+  ectx.nthreads = 4;
+  ectx.grain_size = 16;
+
+  std::stringstream ss;
+  ss << "[";
+  for (int i = 0; i < 1000; ++i) {
+    ss << (i == 0 ? "" : ",\n") << "{\"b\": \"" << std::string(i % 30, 'x') << "\", \"skip\": [{}], \"a\": " << i
+       << "}";
+  }
+  ss << "]";
+  std::string json = ss.str();
+
+  nd::array a = parse_json(ndt::type("1000 * {a: int32, b: string}"), json, &ectx);
+  nd::array b = parse_json(ndt::type("var * {a: int32, b: string}"), json, &ectx);
+  ASSERT_EQ(1000, b.get_dim_size());
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(i, a(i, 0).as<int32_t>());
+    EXPECT_EQ(std::string(i % 30, 'x'), a(i, 1).as<std::string>());
+    EXPECT_EQ(i, b(i, 0).as<int32_t>());
+    EXPECT_EQ(std::string(i % 30, 'x'), b(i, 1).as<std::string>());
+  }
+
+  // The threads' string buffers are taken over by the string arena of the result
+  nd::pod_memory_block *arena = dynamic_cast<nd::pod_memory_block *>(a.get_data_memblock()->get_string_arena());
+  ASSERT_NE(nullptr, arena);
+  EXPECT_LT(1u, arena->m_memory_handles.size());
+
+  // Arrays inside one too short to split are parsed on the calling thread
+  nd::array c = parse_json(ndt::type("2 * 1000 * {a: int32, b: string}"), "[" + json + ", " + json + "]", &ectx);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(i, c(1, i, 0).as<int32_t>());
+    EXPECT_EQ(std::string(i % 30, 'x'), c(1, i, 1).as<std::string>());
+  }
+
+  // Errors in any element are reported with their position
+  json.replace(json.rfind("\"a\": 999"), 8, "\"a\": [9]");
+  try {
+    parse_json(ndt::type("var * {a: int32, b: string}"), json, &ectx);
+    FAIL() << "expected an invalid_argument exception";
+  } catch (const invalid_argument &e) {
+    EXPECT_NE(std::string::npos, std::string(e.what()).find("line 1000"));
+  }
+
+  // A mismatched size is still an error
+  EXPECT_THROW(parse_json(ndt::type("999 * {a: int32, b: string}"), json, &ectx), invalid_argument);
+}
+
+TEST(JSONParser, NDJSONParallel) {
+  eval::eval_context ectx;
+  ectx.nthreads = 4;
+  ectx.grain_size = 16;
+
+  std::stringstream ss;
+  for (int i = 0; i < 1000; ++i) {
+    ss << "{\"id\": " << i << ", \"name\": \"" << std::string(i % 30, 'n') << "\"}\n";
+  }
+
+  nd::array a = parse_ndjson(ndt::type("{id: int64, name: string}"), ss, 1 << 16, &ectx);
+  ASSERT_EQ(1000, a.get_dim_size());
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(i, a(i, 0).as<int64_t>());
+    EXPECT_EQ(std::string(i % 30, 'n'), a(i, 1).as<std::string>());
+  }
+}
+
 /*
 TEST(JSON, DiscoverBool)
 {
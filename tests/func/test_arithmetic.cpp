@@ -257,6 +257,41 @@ TEST(Arithmetic, Minus) {
   EXPECT_ARRAY_EQ(nd::array({-0.0, -1.0, -2.0, -3.0, -4.0}), -a);
 }
 
+TEST(Arithmetic, Contiguous) {
+  nd::array a = nd::empty(1001, ndt::make_type<int>());
+  nd::array b = nd::empty(1001, ndt::make_type<double>());
+  nd::array c = nd::empty(1001, ndt::make_type<int8_t>());
+  int *a_data = reinterpret_cast<int *>(a.data());
+  double *b_data = reinterpret_cast<double *>(b.data());
+  int8_t *c_data = reinterpret_cast<int8_t *>(c.data());
+  for (int i = 0; i < 1001; ++i) {
+    a_data[i] = i - 500;
+    b_data[i] = 0.5 * i;
+    c_data[i] = static_cast<int8_t>(i);
+  }
+
+  // Unit strides take the vectorized loops, including when one side is a broadcast scalar
+  nd::array sum = a + a, diff = a - 7, prod = 3 * a, quot = b / b(irange().by(-1));
+  nd::array lt = a < b, promoted = c + c;
+  for (int i = 0; i < 1001; ++i) {
+    ASSERT_EQ(2 * (i - 500), sum(i).as<int>());
+    ASSERT_EQ(i - 507, diff(i).as<int>());
+    ASSERT_EQ(3 * (i - 500), prod(i).as<int>());
+    ASSERT_EQ((0.5 * i) / (0.5 * (1000 - i)), quot(i).as<double>());
+    ASSERT_EQ(i - 500 < 0.5 * i, lt(i).as<bool>());
+    ASSERT_EQ(2 * static_cast<int8_t>(i), promoted(i).as<int>());
+  }
+
+  // Other strides fall back to the generic loop
+  nd::array strided = a(irange().by(2)) * b(irange().by(2));
+  for (int i = 0; i < 501; ++i) {
+    ASSERT_EQ((2 * i - 500) * (0.5 * 2 * i), strided(i).as<double>());
+  }
+
+  a_data[1000] = 0;
+  EXPECT_THROW(a / a, zero_division_error);
+}
+
 /*
 TEST(Arithmetic, CompoundDiv)
 {
@@ -11,10 +11,12 @@
 #include <dynd/arithmetic.hpp>
 #include <dynd/array.hpp>
 #include <dynd/callable.hpp>
+#include <dynd/callables/base_callable.hpp>
 #include <dynd/functional.hpp>
 #include <dynd/gtest.hpp>
 #include <dynd/index.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/kernels/base_strided_kernel.hpp>
 #include <dynd/types/fixed_string_type.hpp>
 
 using namespace std;
@@ -161,6 +163,140 @@ TEST(Callable, Assignment_CallInterface) {
   EXPECT_THROW(af(false), invalid_argument);
 }
 
+TEST(Callable, RepeatedCalls) {
+  nd::callable f([](int x, int y) { return x - y; });
+
+  // Repeated calls with the same types reuse the resolved call graph
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_ARRAY_EQ(i - 3, f(i, 3));
+  }
+
+  // Same types but different shapes and strides must not share a ckernel
+  nd::array a = {1, 2, 3, 4, 5, 6};
+  nd::array b = {6, 5, 4, 3, 2, 1};
+  EXPECT_ARRAY_EQ((nd::array{2, 4, 6, 8, 10, 12}), nd::add(a, a));
+  EXPECT_ARRAY_EQ((nd::array{7, 7, 7, 7, 7, 7}), nd::add(a, b));
+  EXPECT_ARRAY_EQ((nd::array{2, 6, 10}), nd::add(a(irange().by(2)), a(irange().by(2))));
+  EXPECT_ARRAY_EQ((nd::array{7, 7, 7}), nd::add(a(irange() < 3), b(irange() < 3)));
+  EXPECT_ARRAY_EQ((nd::array{7, 7, 7, 7, 7, 7}), nd::add(a, b));
+}
+
+namespace {
+
+// Keeps the number of times it was called, so a reused instance would add to its result
+struct counting_kernel : nd::base_strided_kernel<counting_kernel, 1> {
+  int calls = 0;
+
+  void single(char *dst, char *const *src) {
+    *reinterpret_cast<int *>(dst) = *reinterpret_cast<int *>(src[0]) + calls++;
+  }
+};
+
+struct copying_kernel : nd::base_strided_kernel<copying_kernel, 1> {
+  void single(char *dst, char *const *src) { *reinterpret_cast<int *>(dst) = *reinterpret_cast<int *>(src[0]); }
+};
+
+} // unnamed namespace
+
+namespace dynd {
+namespace nd {
+
+  template <>
+  struct is_stateless_kernel<copying_kernel> : std::true_type {};
+
+} // namespace dynd::nd
+} // namespace dynd
+
+namespace {
+
+// Counts how often it is resolved and instantiated, and builds either a
+// counting_kernel or a copying_kernel, the latter declared stateless
+class counting_callable : public nd::base_callable {
+  bool m_stateless_kernel;
+  bool m_stateful;
+
+public:
+  static int nresolve, ninstantiate;
+
+  counting_callable(bool stateless_kernel, bool stateful)
+      : nd::base_callable(ndt::type("(int32) -> int32")), m_stateless_kernel(stateless_kernel), m_stateful(stateful) {
+  }
+
+  ndt::type resolve(nd::base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), nd::call_graph &cg,
+                    const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc),
+                    const ndt::type *DYND_UNUSED(src_tp), size_t DYND_UNUSED(nkwd), const nd::array *DYND_UNUSED(kwds),
+                    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
+    ++nresolve;
+    if (m_stateful) {
+      cg.mark_stateful();
+    }
+
+    cg.emplace_back([stateless_kernel = m_stateless_kernel](
+        nd::kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+        const char *DYND_UNUSED(dst_arrmeta), size_t DYND_UNUSED(nsrc), const char *const *DYND_UNUSED(src_arrmeta)) {
+      ++ninstantiate;
+      if (stateless_kernel) {
+        kb.emplace_back<copying_kernel>(kernreq);
+      } else {
+        kb.emplace_back<counting_kernel>(kernreq);
+      }
+    });
+
+    return get_ret_type();
+  }
+};
+
+int counting_callable::nresolve = 0;
+int counting_callable::ninstantiate = 0;
+
+} // unnamed namespace
+
+TEST(Callable, CallCache) {
+  counting_callable::nresolve = 0;
+  counting_callable::ninstantiate = 0;
+
+  // The call graph and the ckernel of a stateless kernel are both reused
+  nd::callable f = nd::make_callable<counting_callable>(true, false);
+  EXPECT_ARRAY_EQ(5, f(5));
+  EXPECT_ARRAY_EQ(5, f(5));
+  EXPECT_EQ(1, counting_callable::nresolve);
+  EXPECT_EQ(1, counting_callable::ninstantiate);
+
+  // Invalidating the caches resolves and instantiates again
+  nd::base_callable::invalidate_call_caches();
+  EXPECT_ARRAY_EQ(5, f(5));
+  EXPECT_EQ(2, counting_callable::nresolve);
+  EXPECT_EQ(2, counting_callable::ninstantiate);
+
+  // A kernel that doesn't declare itself stateless gets a fresh ckernel for each call, so nothing carries over
+  nd::callable g = nd::make_callable<counting_callable>(false, false);
+  EXPECT_ARRAY_EQ(5, g(5));
+  EXPECT_ARRAY_EQ(5, g(5));
+  EXPECT_EQ(3, counting_callable::nresolve);
+  EXPECT_EQ(4, counting_callable::ninstantiate);
+
+  // The same goes for a call graph marked stateful
+  nd::callable h = nd::make_callable<counting_callable>(true, true);
+  EXPECT_ARRAY_EQ(5, h(5));
+  EXPECT_ARRAY_EQ(5, h(5));
+  EXPECT_EQ(4, counting_callable::nresolve);
+  EXPECT_EQ(6, counting_callable::ninstantiate);
+
+  // And for functors that change when called
+  int n = 0;
+  nd::callable k = nd::functional::apply([n](int x) mutable { return x + n++; });
+  EXPECT_ARRAY_EQ(5, k(5));
+  EXPECT_ARRAY_EQ(5, k(5));
+}
+
+TEST(Callable, StatefulRepeatedCalls) {
+  nd::callable f = nd::functional::elwise([](nd::state st, int x) { return x + static_cast<int>(st.index[0]); });
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_ARRAY_EQ((nd::array{1, 2, 3}), f(nd::array{1, 1, 1}));
+  }
+}
+
 /*
 #include <llvm/Bitcode/ReaderWriter.h>
 #include <llvm/IR/LLVMContext.h>
@@ -7,6 +7,7 @@
 #include <cmath>
 #include <iostream>
 #include <stdexcept>
+#include <string>
 
 #include <dynd/array.hpp>
 #include <dynd/assignment.hpp>
@@ -18,6 +19,8 @@
 #include <dynd/index.hpp>
 #include <dynd/registry.hpp>
 #include <dynd/types/fixed_string_type.hpp>
+#include <dynd/types/string_type.hpp>
+#include <dynd/types/string_view_type.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -35,6 +38,47 @@ TEST(Compose, Simple) {
   EXPECT_DOUBLE_EQ(sin(3.1), a.as<double>());
 }
 
+TEST(Compose, Strided) {
+  // Several chunks through the same buffer, which holds strings in the second case
+  nd::callable composed = nd::functional::elwise(nd::functional::compose(
+      nd::functional::apply([](int x) { return 0.5 * x; }), nd::functional::apply([](double x) { return 4 * x; }),
+      ndt::make_type<double>()));
+  nd::callable round_trip = nd::functional::elwise(nd::functional::compose(
+      nd::functional::apply([](int x) { return dynd::string(std::to_string(x)); }),
+      nd::functional::apply([](dynd::string s) { return std::stoi(std::string(s.begin(), s.end())); }),
+      ndt::make_type<ndt::string_type>()));
+
+  nd::array a = nd::empty(1000, ndt::make_type<int>());
+  int *a_data = reinterpret_cast<int *>(a.data());
+  for (int i = 0; i < 1000; ++i) {
+    a_data[i] = 7 * i - 3000;
+  }
+
+  nd::array b = composed(a);
+  nd::array c = round_trip(a);
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(2 * a_data[i], b(i).as<double>());
+    ASSERT_EQ(a_data[i], c(i).as<int>());
+  }
+}
+
+TEST(Compose, BlockrefBuffer) {
+  // The views are copied into the buffer's memory block, which is reset after every call
+  nd::callable composed = nd::functional::compose(nd::copy, nd::copy, ndt::type("3 * string_view"));
+  nd::array a = nd::empty(ndt::type("3 * string"));
+  nd::array b = nd::empty(ndt::type("3 * string"));
+  for (int i = 0; i < 100; ++i) {
+    std::string s = std::to_string(i), t(200, static_cast<char>('a' + i % 26));
+    a(0).vals() = s;
+    a(1).vals() = s + s;
+    a(2).vals() = t;
+    composed({a}, {{"dst", b}});
+    ASSERT_EQ(s, b(0).as<std::string>());
+    ASSERT_EQ(s + s, b(1).as<std::string>());
+    ASSERT_EQ(t, b(2).as<std::string>());
+  }
+}
+
 /*
 TEST(Convert, Unary)
 {
@@ -27,3 +27,14 @@ TEST(Functional, Constant) {
   EXPECT_ARRAY_EQ(10.0, f(2.0));
   EXPECT_ARRAY_EQ(10.0, f(nd::array{0.0, 1.0, 2.0}));
 }
+
+TEST(Functional, ConstantToOtherType) {
+  // As the identity of a reduction, the value is written to a destination of the reduced type
+  nd::callable f = nd::functional::constant(7);
+
+  char *const *args = nullptr;
+  ndt::type dst_tp = ndt::make_type<double>();
+  EXPECT_ARRAY_EQ(7.0, f->call(dst_tp, 0, nullptr, nullptr, args, 0, nullptr, map<std::string, ndt::type>()));
+  dst_tp = ndt::make_type<int64_t>();
+  EXPECT_ARRAY_EQ(7LL, f->call(dst_tp, 0, nullptr, nullptr, args, 0, nullptr, map<std::string, ndt::type>()));
+}
@@ -17,6 +17,8 @@
 #include <dynd/json_parser.hpp>
 #include <dynd/types/fixed_string_type.hpp>
 
+#include "../test_eval_context.hpp"
+
 using namespace std;
 using namespace dynd;
 
@@ -218,6 +220,146 @@ TEST(Elwise, Binary_FixedDim) {
   EXPECT_ARRAY_EQ((nd::array{3, 5, 7}), f({{0, 1, 2}, {3, 4, 5}}, {}));
 }
 
+TEST(Elwise, Parallel) {
+  scoped_eval_context ectx(4, 64);
+
+  nd::array a = nd::empty(10000, ndt::make_type<int>());
+  nd::array b = nd::empty(100, 100, ndt::make_type<int>());
+  int *a_data = reinterpret_cast<int *>(a.data());
+  int *b_data = reinterpret_cast<int *>(b.data());
+  for (int i = 0; i < 10000; ++i) {
+    a_data[i] = i;
+    b_data[i] = 2 * i;
+  }
+
+  nd::callable f = nd::functional::elwise(nd::functional::apply([](int x, int y) { return x + y; }));
+  nd::callable g = nd::functional::elwise(nd::functional::apply([](int x) {
+    if (x == 9999) {
+      throw std::runtime_error("error at 9999");
+    }
+    return x;
+  }));
+
+  nd::array c = f(a, a);
+  nd::array d = f(b, b(irange().by(-1)));
+  nd::array e = f(b, a(irange() < 100));
+
+  // Strings allocate from the result's memory block, so this runs on one thread
+  nd::callable h = nd::functional::elwise(nd::functional::apply([](int x) { return dynd::string(std::to_string(x)); }));
+  nd::array s = h(a);
+
+  EXPECT_EQ(ndt::type("10000 * string"), s.get_type());
+  for (int i = 0; i < 10000; i += 97) {
+    ASSERT_EQ(std::to_string(i), s(i).as<std::string>());
+  }
+
+  const int *c_data = reinterpret_cast<const int *>(c.cdata());
+  for (int i = 0; i < 10000; ++i) {
+    ASSERT_EQ(2 * i, c_data[i]);
+  }
+  for (int i = 0; i < 100; ++i) {
+    for (int j = 0; j < 100; ++j) {
+      ASSERT_EQ(2 * (100 * i + j) + 2 * (100 * (99 - i) + j), d(i, j).as<int>());
+      ASSERT_EQ(2 * (100 * i + j) + j, e(i, j).as<int>());
+    }
+  }
+
+  // An exception in any of the threads is rethrown in the calling one
+  EXPECT_THROW(g(a), runtime_error);
+}
+
+TEST(Elwise, ParallelStatefulChild) {
+  nd::array a = nd::empty(100000, ndt::make_type<int>());
+  nd::array b = nd::empty(250, 400, ndt::make_type<int>());
+  int *a_data = reinterpret_cast<int *>(a.data());
+  int *b_data = reinterpret_cast<int *>(b.data());
+  for (int i = 0; i < 100000; ++i) {
+    a_data[i] = i;
+    b_data[i] = i;
+  }
+
+  // The functor counts the elements it has seen, so it must see them all, in order, from one thread
+  auto make_counting = [] {
+    int n = 0;
+    return nd::functional::elwise(nd::functional::apply([n](int x) mutable { return x + n++; }));
+  };
+
+  nd::array serial_a, serial_b;
+  {
+    scoped_eval_context ectx(1, 64);
+    serial_a = make_counting()(a);
+    serial_b = make_counting()(b);
+  }
+
+  scoped_eval_context ectx(4, 64);
+  nd::array parallel_a = make_counting()(a);
+  nd::array parallel_b = make_counting()(b);
+  EXPECT_ARRAY_EQ(serial_a, parallel_a);
+  EXPECT_ARRAY_EQ(serial_b, parallel_b);
+
+  const int *parallel_data = reinterpret_cast<const int *>(parallel_a.cdata());
+  for (int i = 0; i < 100000; ++i) {
+    ASSERT_EQ(2 * i, parallel_data[i]);
+  }
+}
+
+TEST(Elwise, LoopOrder) {
+  nd::array a = nd::empty(1000, 3, ndt::make_type<int>());
+  nd::array b = nd::empty(3, 1000, ndt::make_type<int>());
+  int *a_data = reinterpret_cast<int *>(a.data());
+  int *b_data = reinterpret_cast<int *>(b.data());
+  for (int i = 0; i < 3000; ++i) {
+    a_data[i] = i;
+    b_data[i] = 3 * i;
+  }
+
+  nd::callable f = nd::functional::elwise(nd::functional::apply([](int x, int y) { return x - y; }));
+
+  // Contiguous dimensions, which are merged into one loop
+  nd::array c = f(a, a(irange(), irange() < 1));
+  for (int i = 0; i < 1000; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      ASSERT_EQ(j, c(i, j).as<int>());
+    }
+  }
+
+  // Operands with different orders, a reversed dimension, and a broadcast one
+  c = f(a, b.transpose());
+  nd::array d = f(b.transpose(), a(irange().by(-1)));
+  nd::array e = f(a, nd::array{100, 200, 300});
+  for (int i = 0; i < 1000; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      ASSERT_EQ((3 * i + j) - 3 * (1000 * j + i), c(i, j).as<int>());
+      ASSERT_EQ(3 * (1000 * j + i) - (3 * (999 - i) + j), d(i, j).as<int>());
+      ASSERT_EQ((3 * i + j) - 100 * (j + 1), e(i, j).as<int>());
+    }
+  }
+
+  // Assigning into a transposed view
+  nd::array g = nd::empty(3, 1000, ndt::make_type<int>());
+  g.transpose().assign(a);
+  for (int i = 0; i < 1000; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      ASSERT_EQ(3 * i + j, g(j, i).as<int>());
+    }
+  }
+
+  // Three dimensions, with a size one dimension in between
+  nd::array h = nd::empty(4, 1, 5, ndt::make_type<int>());
+  int *h_data = reinterpret_cast<int *>(h.data());
+  for (int i = 0; i < 20; ++i) {
+    h_data[i] = i;
+  }
+  nd::array k = f(h.rotate(2, 0), h.rotate(2, 0));
+  EXPECT_EQ(ndt::make_type<int[1][5][4]>(), k.get_type());
+  k = f(h.rotate(2, 0), nd::array(0));
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 5; ++j) {
+      ASSERT_EQ(5 * i + j, k(0, j, i).as<int>());
+    }
+  }
+}
+
 /*
 // TODO Reenable once there's a convenient way to make the binary callable
 TEST(LiftCallable, Expr_MultiDimVarToVarDim) {
@@ -0,0 +1,136 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+
+#include <dynd/arithmetic.hpp>
+#include <dynd/array.hpp>
+#include <dynd/expression.hpp>
+#include <dynd/gtest.hpp>
+
+#include "../test_eval_context.hpp"
+
+using namespace std;
+using namespace dynd;
+
+TEST(Expression, Fused) {
+  // Long enough to be evaluated in several chunks
+  nd::array a = nd::empty(1000, ndt::make_type<double>());
+  nd::array b = nd::empty(1000, ndt::make_type<double>());
+  nd::array c = nd::empty(1000, ndt::make_type<int>());
+  double *a_data = reinterpret_cast<double *>(a.data());
+  double *b_data = reinterpret_cast<double *>(b.data());
+  int *c_data = reinterpret_cast<int *>(c.data());
+  for (int i = 0; i < 1000; ++i) {
+    a_data[i] = 0.5 * i;
+    b_data[i] = 1000 - i;
+    c_data[i] = i % 7;
+  }
+
+  nd::expression e = nd::lazy(a) + b * c;
+  EXPECT_EQ(ndt::make_type<double>(), e.get_dtype());
+  EXPECT_TRUE(e.is_fusable());
+  EXPECT_ARRAY_EQ(a + b * c, e.eval());
+
+  e = -(nd::lazy(a) - b) / (nd::lazy(c) + 1);
+  EXPECT_TRUE(e.is_fusable());
+  EXPECT_ARRAY_EQ(-(a - b) / (c + 1), e.eval());
+
+  // The result of a subexpression and a repeated array are both used twice
+  nd::expression t = nd::lazy(a) * a;
+  e = t + t * b;
+  EXPECT_TRUE(e.is_fusable());
+  EXPECT_ARRAY_EQ(a * a + a * a * b, e.eval());
+
+  // An expression of one array is that array
+  EXPECT_EQ(a.cdata(), nd::lazy(a).eval().cdata());
+}
+
+TEST(Expression, Types) {
+  // Integers of each size and signedness mixed with floats, some of them strided
+  nd::array a = nd::empty(2000, ndt::make_type<int8_t>());
+  nd::array b = nd::empty(1000, ndt::make_type<uint16_t>());
+  nd::array c = nd::empty(1000, ndt::make_type<float>());
+  nd::array d = nd::empty(1000, ndt::make_type<int64_t>());
+  nd::array u = nd::empty(1000, ndt::make_type<uint32_t>());
+  int8_t *a_data = reinterpret_cast<int8_t *>(a.data());
+  uint16_t *b_data = reinterpret_cast<uint16_t *>(b.data());
+  float *c_data = reinterpret_cast<float *>(c.data());
+  int64_t *d_data = reinterpret_cast<int64_t *>(d.data());
+  uint32_t *u_data = reinterpret_cast<uint32_t *>(u.data());
+  for (int i = 0; i < 2000; ++i) {
+    a_data[i] = static_cast<int8_t>(i % 200 - 100) | 1;
+  }
+  for (int i = 0; i < 1000; ++i) {
+    b_data[i] = static_cast<uint16_t>(65 * i + 1);
+    c_data[i] = 0.25f * i - 100.125f;
+    d_data[i] = 1000000007LL * (i - 500);
+    u_data[i] = 3 * i;
+  }
+  a = a(irange().by(2));
+
+  nd::expression e = nd::lazy(a) * b - d;
+  EXPECT_TRUE(e.is_fusable());
+  EXPECT_ARRAY_EQ(a * b - d, e.eval());
+
+  e = -nd::lazy(b) + c / a;
+  EXPECT_TRUE(e.is_fusable());
+  EXPECT_ARRAY_EQ(-b + c / a, e.eval());
+
+  e = (nd::lazy(d) - a) / c * c;
+  EXPECT_ARRAY_EQ((d - a) / c * c, e.eval());
+
+  e = -nd::lazy(u) * u + 7u;
+  EXPECT_ARRAY_EQ(-u * u + 7u, e.eval());
+
+  // Integer division, which raises an exception on zero
+  e = nd::lazy(d) / b + a;
+  EXPECT_ARRAY_EQ(d / b + a, e.eval());
+}
+
+TEST(Expression, Broadcast) {
+  nd::array a = {{1, 2, 3}, {4, 5, 6}};
+  nd::array b = {10.0, 20.0, 30.0};
+
+  nd::expression e = nd::lazy(a) * b + 2;
+  EXPECT_EQ(ndt::make_type<double>(), e.get_dtype());
+  EXPECT_ARRAY_EQ(a * b + 2, e.eval());
+
+  e = nd::lazy(nd::array(3)) * 4 - 1;
+  EXPECT_ARRAY_EQ(nd::array(11), e.eval());
+}
+
+TEST(Expression, Unfused) {
+  // More arrays than a fused kernel takes, which are evaluated one operation at a time
+  nd::array a[8];
+  nd::expression e = nd::lazy(nd::array({0, 0, 0}));
+  for (int i = 0; i < 8; ++i) {
+    a[i] = nd::array({i, 2 * i, 3 * i});
+    e = e + a[i];
+  }
+  EXPECT_FALSE(e.is_fusable());
+  EXPECT_ARRAY_EQ(nd::array({28, 56, 84}), e.eval());
+}
+
+TEST(Expression, Parallel) {
+  scoped_eval_context ectx(4, 64);
+
+  nd::array a = nd::empty(10000, ndt::make_type<int>());
+  nd::array b = nd::empty(10000, ndt::make_type<int>());
+  int *a_data = reinterpret_cast<int *>(a.data());
+  int *b_data = reinterpret_cast<int *>(b.data());
+  for (int i = 0; i < 10000; ++i) {
+    a_data[i] = i;
+    b_data[i] = 2 * i;
+  }
+
+  nd::array c = (nd::lazy(a) * 3 + b - a).eval();
+
+  const int *c_data = reinterpret_cast<const int *>(c.cdata());
+  for (int i = 0; i < 10000; ++i) {
+    ASSERT_EQ(4 * i, c_data[i]);
+  }
+}
@@ -8,9 +8,13 @@
 #include <iostream>
 #include <stdexcept>
 
+#include <dynd/eval/eval_context.hpp>
 #include <dynd/gtest.hpp>
+#include <dynd/index.hpp>
 #include <dynd/statistics.hpp>
 
+#include "../test_eval_context.hpp"
+
 using namespace std;
 using namespace dynd;
 
@@ -51,3 +55,32 @@ TEST(Max, FixedDimVarDim) {
   EXPECT_ARRAY_EQ(10, nd::max(parse_json(ndt::type("2 * var * int32"), "[[0], [10, 2]]")));
   EXPECT_ARRAY_EQ(23.5, nd::max(parse_json(ndt::type("3 * var * float64"), "[[23.5], [10, 2, 15], [-4]]")));
 }
+
+TEST(Max, Parallel) {
+  scoped_eval_context ectx(4, 64);
+
+  nd::array a = nd::empty(100000, ndt::make_type<int>());
+  nd::array b = nd::empty(100000, ndt::make_type<double>());
+  int *a_data = reinterpret_cast<int *>(a.data());
+  double *b_data = reinterpret_cast<double *>(b.data());
+  for (int i = 0; i < 100000; ++i) {
+    a_data[i] = (i * 7919) % 100003;
+    b_data[i] = -0.5 * a_data[i];
+  }
+
+  nd::array a_max = nd::max(a), a_min = nd::min(a);
+  nd::array b_max = nd::max(b), b_min = nd::min(b), a_strided_max = nd::max(a(irange().by(2)));
+
+  int expected_max = *std::max_element(a_data, a_data + 100000);
+  int expected_min = *std::min_element(a_data, a_data + 100000);
+  EXPECT_ARRAY_EQ(expected_max, a_max);
+  EXPECT_ARRAY_EQ(expected_min, a_min);
+  EXPECT_ARRAY_EQ(-0.5 * expected_min, b_max);
+  EXPECT_ARRAY_EQ(-0.5 * expected_max, b_min);
+
+  int expected_strided_max = a_data[0];
+  for (int i = 0; i < 100000; i += 2) {
+    expected_strided_max = std::max(expected_strided_max, a_data[i]);
+  }
+  EXPECT_ARRAY_EQ(expected_strided_max, a_strided_max);
+}
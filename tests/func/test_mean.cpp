@@ -8,17 +8,16 @@
 #include <iostream>
 #include <stdexcept>
 
-#include <dynd/statistics.hpp>
 #include <dynd/gtest.hpp>
+#include <dynd/index.hpp>
+#include <dynd/statistics.hpp>
+
+#include "../test_eval_context.hpp"
 
 using namespace std;
 using namespace dynd;
 
-/*
-ToDo: Fix this.
-
-TEST(Mean, 1D)
-{
+TEST(Mean, 1D) {
   EXPECT_ARRAY_EQ(0.0, nd::mean(nd::array{0.0}));
   EXPECT_ARRAY_EQ(1.0, nd::mean(nd::array{1.0}));
   EXPECT_ARRAY_EQ(2.0, nd::mean(nd::array{0.0, 2.0, 4.0}));
@@ -26,10 +25,21 @@ TEST(Mean, 1D)
   EXPECT_ARRAY_EQ(4.5, nd::mean(nd::array{0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0}));
 }
 
-TEST(Mean, 2D)
-{
+TEST(Mean, 2D) {
   EXPECT_ARRAY_EQ(4.5, nd::mean(nd::array({{0.0, 1.0, 2.0, 3.0, 4.0}, {5.0, 6.0, 7.0, 8.0, 9.0}})));
   EXPECT_ARRAY_EQ(4.5, nd::mean(nd::array({{9.0, 8.0, 7.0, 6.0, 5.0}, {4.0, 3.0, 2.0, 1.0, 0.0}})));
 }
 
-*/
+TEST(Mean, Parallel) {
+  scoped_eval_context ectx(4, 64);
+
+  // Long enough for the sum to be added pairwise and split across threads
+  nd::array a = nd::empty(100000, ndt::make_type<double>());
+  double *a_data = reinterpret_cast<double *>(a.data());
+  for (int i = 0; i < 100000; ++i) {
+    a_data[i] = 0.1 * (i % 1000);
+  }
+
+  EXPECT_NEAR(49.95, nd::mean(a).as<double>(), 1e-9);
+  EXPECT_NEAR(50.0, nd::mean(a(irange().by(-2))).as<double>(), 1e-9);
+}
@@ -8,9 +8,12 @@
 #include <iostream>
 #include <stdexcept>
 
+#include <dynd/eval/eval_context.hpp>
 #include <dynd/functional.hpp>
 #include <dynd/gtest.hpp>
 
+#include "../test_eval_context.hpp"
+
 using namespace std;
 using namespace dynd;
 
@@ -193,3 +196,23 @@ TEST(Reduction, Except) {
   // Cannot have a child with no arguments
   //  EXPECT_THROW(nd::functional::reduction(nd::functional::apply([]() { return 0; })), invalid_argument);
 }
+
+TEST(Reduction, Parallel) {
+  scoped_eval_context ectx(4, 64);
+
+  nd::array a = nd::empty(10000, ndt::make_type<int>());
+  int *a_data = reinterpret_cast<int *>(a.data());
+  for (int i = 0; i < 10000; ++i) {
+    a_data[i] = i;
+  }
+
+  // The identity is added once, so this must not be split into partial results
+  nd::callable f =
+      nd::functional::reduction([] { return 100; }, [](const return_wrapper<int> &res, int x) { res += x; });
+  nd::callable g = nd::functional::reduction([] { return 0; },
+                                             [](const return_wrapper<int> &res, int x) { res += x; }, nd::associative);
+  nd::array f_res = f(a), g_res = g(a);
+
+  EXPECT_ARRAY_EQ(100 + 49995000, f_res);
+  EXPECT_ARRAY_EQ(49995000, g_res);
+}
@@ -6,11 +6,18 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <limits>
+#include <random>
 #include <stdexcept>
 
+#include <dynd/access.hpp>
+#include <dynd/eval/eval_context.hpp>
 #include <dynd/gtest.hpp>
+#include <dynd/index.hpp>
 #include <dynd/sort.hpp>
 
+#include "../test_eval_context.hpp"
+
 using namespace std;
 using namespace dynd;
 
@@ -24,11 +31,133 @@ TEST(Sort, 1D) {
   EXPECT_ARRAY_EQ((nd::array{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19}), a);
 }
 
-/*
+TEST(Sort, Typed) {
+  default_random_engine gen;
+  uniform_int_distribution<int64_t> d(-1000000000000LL, 1000000000000LL);
+
+  for (size_t size : {10, 1000, 100000}) {
+    nd::array a = nd::empty(size, ndt::make_type<int64_t>());
+    nd::array b = nd::empty(size, ndt::make_type<double>());
+    nd::array c = nd::empty(size, ndt::make_type<uint8_t>());
+    int64_t *a_data = reinterpret_cast<int64_t *>(a.data());
+    double *b_data = reinterpret_cast<double *>(b.data());
+    uint8_t *c_data = reinterpret_cast<uint8_t *>(c.data());
+    for (size_t i = 0; i < size; ++i) {
+      a_data[i] = d(gen);
+      b_data[i] = 1e-6 * d(gen);
+      c_data[i] = static_cast<uint8_t>(a_data[i]);
+    }
+    vector<int64_t> a_expected(a_data, a_data + size);
+    vector<double> b_expected(b_data, b_data + size);
+    vector<uint8_t> c_expected(c_data, c_data + size);
+    sort(a_expected.begin(), a_expected.end());
+    sort(b_expected.begin(), b_expected.end());
+    sort(c_expected.begin(), c_expected.end());
+
+    nd::sort(a);
+    nd::sort(b);
+    nd::sort(c);
+    EXPECT_EQ(a_expected, vector<int64_t>(a_data, a_data + size));
+    EXPECT_EQ(b_expected, vector<double>(b_data, b_data + size));
+    EXPECT_EQ(c_expected, vector<uint8_t>(c_data, c_data + size));
+  }
+
+  // A strided view is sorted in place, leaving the elements in between alone
+  nd::array a = {5, -1, 4, -2, 3, -3, 2, -4, 1, -5, 0, -6};
+  nd::sort(a(irange().by(2)));
+  EXPECT_ARRAY_EQ((nd::array{0, -1, 1, -2, 2, -3, 3, -4, 4, -5, 5, -6}), a);
+
+  const float inf = numeric_limits<float>::infinity();
+  a = {2.5f, -0.5f, -inf, inf, -2.5f, 0.0f};
+  nd::sort(a);
+  EXPECT_ARRAY_EQ((nd::array{-inf, -2.5f, -0.5f, 0.0f, 2.5f, inf}), a);
+
+  a = {true, false, true, false};
+  nd::sort(a);
+  EXPECT_ARRAY_EQ((nd::array{false, false, true, true}), a);
+}
+
+TEST(Sort, Parallel) {
+  scoped_eval_context ectx(3, 64);
+
+  default_random_engine gen;
+  uniform_int_distribution<int32_t> d;
+
+  nd::array a = nd::empty(100001, ndt::make_type<int32_t>());
+  int32_t *a_data = reinterpret_cast<int32_t *>(a.data());
+  for (int i = 0; i < 100001; ++i) {
+    a_data[i] = d(gen);
+  }
+  vector<int32_t> expected(a_data, a_data + 100001);
+  sort(expected.begin(), expected.end());
+
+  nd::sort(a);
+
+  EXPECT_EQ(expected, vector<int32_t>(a_data, a_data + 100001));
+}
+
 TEST(Unique, 1D)
 {
-  nd::array a{0, 0, 1, 2, 2, 3};
-  nd::unique(a);
-  EXPECT_ARRAY_EQ((nd::array{0, 1, 2, 3}), a);
+  nd::array a{3, 1, 3, 0, 1, 1};
+  EXPECT_ARRAY_EQ(nd::array({3, 1, 0}).cast(ndt::type("var * int32")), nd::unique(a));
+  // The argument is not modified
+  EXPECT_ARRAY_EQ((nd::array{3, 1, 3, 0, 1, 1}), a);
+
+  a = nd::empty(ndt::type("0 * int32"));
+  EXPECT_ARRAY_EQ(nd::empty(ndt::type("0 * int32")).cast(ndt::type("var * int32")), nd::unique(a));
+
+  a = nd::array{2.5, -0.0, 1.0, 0.0, 2.5};
+  EXPECT_ARRAY_EQ(nd::array({2.5, -0.0, 1.0}).cast(ndt::type("var * float64")), nd::unique(a));
+
+  a = nd::array{1, 2, 1, 3, 2, 4};
+  EXPECT_ARRAY_EQ(nd::array({1, 2}).cast(ndt::type("var * int32")), nd::unique(a(irange().by(2))));
+}
+
+TEST(Unique, String)
+{
+  nd::array a{"banana", "apple", "a rather longer string", "banana", "", "a rather longer string"};
+  EXPECT_ARRAY_EQ(nd::array({"banana", "apple", "a rather longer string", ""}).cast(ndt::type("var * string")),
+                  nd::unique(a));
+}
+
+TEST(Unique, CountsInverse)
+{
+  nd::array a{"x", "y", "x", "z", "x", "y"};
+
+  nd::array res = nd::unique({a}, {{"counts", true}, {"inverse", true}});
+  EXPECT_EQ(ndt::type("{values: var * string, counts: var * int64, inverse: 6 * int64}"), res.get_type());
+  EXPECT_ARRAY_EQ(nd::array({"x", "y", "z"}).cast(ndt::type("var * string")), nd::field_access(res, "values"));
+  EXPECT_ARRAY_EQ(nd::array({3, 2, 1}).cast(ndt::type("var * int64")), nd::field_access(res, "counts"));
+  EXPECT_ARRAY_EQ(nd::array(vector<int64_t>{0, 1, 0, 2, 0, 1}), nd::field_access(res, "inverse"));
+
+  res = nd::unique({a}, {{"inverse", true}});
+  EXPECT_EQ(ndt::type("{values: var * string, inverse: 6 * int64}"), res.get_type());
+}
+
+TEST(Unique, Large)
+{
+  default_random_engine gen;
+  uniform_int_distribution<int64_t> d(0, 999);
+
+  nd::array a = nd::empty(100000, ndt::make_type<int64_t>());
+  int64_t *a_data = reinterpret_cast<int64_t *>(a.data());
+  for (int i = 0; i < 100000; ++i) {
+    a_data[i] = d(gen);
+  }
+
+  nd::array res = nd::unique({a}, {{"counts", true}, {"inverse", true}});
+  nd::array values = nd::field_access(res, "values");
+  nd::array counts = nd::field_access(res, "counts");
+  nd::array inverse = nd::field_access(res, "inverse");
+  ASSERT_EQ(1000, values.get_dim_size());
+
+  // Every element maps back to itself through the inverse, and the counts add up
+  int64_t total = 0;
+  for (intptr_t i = 0; i < values.get_dim_size(); ++i) {
+    total += counts(i).as<int64_t>();
+  }
+  EXPECT_EQ(100000, total);
+  for (int i = 0; i < 100000; i += 97) {
+    EXPECT_EQ(a_data[i], values(inverse(i).as<int64_t>()).as<int64_t>());
+  }
 }
-*/
@@ -9,9 +9,13 @@
 #include <stdexcept>
 
 #include <dynd/arithmetic.hpp>
+#include <dynd/eval/eval_context.hpp>
 #include <dynd/gtest.hpp>
+#include <dynd/index.hpp>
 #include <dynd/logic.hpp>
 
+#include "../test_eval_context.hpp"
+
 using namespace std;
 using namespace dynd;
 
@@ -62,3 +66,46 @@ TEST(Sum, 2D)
   EXPECT_ARRAY_EQ(15, nd::sum(nd::array{{0, 1, 2}, {3, 4, 5}}));
 }
 */
+
+TEST(Sum, Pairwise) {
+  nd::array a = nd::empty(1000001, ndt::make_type<float>());
+  float *a_data = reinterpret_cast<float *>(a.data());
+  for (int i = 0; i < 1000001; ++i) {
+    a_data[i] = 0.1f;
+  }
+
+  // Accumulating one value at a time is off by almost a thousand
+  EXPECT_NEAR(100000.1, nd::sum(a).as<float>(), 0.5);
+  EXPECT_NEAR(50000.1, nd::sum(a(irange().by(2))).as<float>(), 0.5);
+  EXPECT_NEAR(1000.0, nd::sum(a(irange() < 10000)).as<float>(), 0.01);
+
+  EXPECT_ARRAY_EQ(10.875f, nd::sum(nd::array{1.25f, -2.5f, 12.125f}));
+  EXPECT_ARRAY_EQ(-19999999987LL, nd::sum(nd::array{1LL, -20000000000LL, 12LL}));
+}
+
+TEST(Sum, Parallel) {
+  scoped_eval_context ectx(4, 64);
+
+  nd::array a = nd::empty(100000, ndt::make_type<int64_t>());
+  nd::array b = nd::empty(10, 10000, ndt::make_type<double>());
+  int64_t *a_data = reinterpret_cast<int64_t *>(a.data());
+  double *b_data = reinterpret_cast<double *>(b.data());
+  for (int i = 0; i < 100000; ++i) {
+    a_data[i] = i;
+    b_data[i] = 0.5 * (i % 100);
+  }
+
+  nd::array a_sum = nd::sum(a);
+  nd::array a_strided_sum = nd::sum(a(irange().by(-3)));
+  nd::array b_sum = nd::sum(b);
+  nd::array b_row_sum = nd::sum({b}, {{"axes", {1}}});
+  nd::array all = nd::all(a > -1);
+
+  EXPECT_ARRAY_EQ(4999950000LL, a_sum);
+  EXPECT_ARRAY_EQ(1666683333LL, a_strided_sum);
+  EXPECT_ARRAY_EQ(2475000.0, b_sum);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(247500.0, b_row_sum(i).as<double>());
+  }
+  EXPECT_ARRAY_EQ(true, all);
+}
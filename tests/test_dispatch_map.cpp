@@ -8,6 +8,7 @@
 #include <iostream>
 #include <stdexcept>
 
+#include <dynd/callable.hpp>
 #include <dynd/dispatcher.hpp>
 #include <dynd/gtest.hpp>
 #include <dynd/type_registry.hpp>
@@ -76,6 +77,39 @@ TEST(Sort, TopologicalSort) {
   EXPECT_EQ((vector<int>{5, 4, 2, 3, 1, 0}), res);
 }
 
+static void dispatch_arg0(const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+                          ndt::type *res_tp) {
+  res_tp[0] = src_tp[0];
+}
+
+TEST(Dispatcher, Cached) {
+  nd::callable f0([](int32_t x) { return x; });
+  nd::callable f1([](double x) { return x; });
+  dispatcher<1, nd::callable> dispatcher(dispatch_arg0, {f0, f1});
+
+  ndt::type int32_tp = ndt::make_type<int32_t>();
+  ndt::type float64_tp = ndt::make_type<double>();
+  ndt::type int64_tp = ndt::make_type<int64_t>();
+
+  // Repeated lookups for the same types hit the dispatch table and must agree with the first
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(f0.get(), dispatcher(ndt::type(), 1, &int32_tp).get());
+    EXPECT_EQ(f1.get(), dispatcher(ndt::type(), 1, &float64_tp).get());
+    EXPECT_THROW(dispatcher(ndt::type(), 1, &int64_tp), out_of_range);
+  }
+
+  // Inserting a child invalidates the table
+  nd::callable f2([](int64_t x) { return x; });
+  dispatcher.insert(f2);
+  EXPECT_EQ(f0.get(), dispatcher(ndt::type(), 1, &int32_tp).get());
+  EXPECT_EQ(f1.get(), dispatcher(ndt::type(), 1, &float64_tp).get());
+  EXPECT_EQ(f2.get(), dispatcher(ndt::type(), 1, &int64_tp).get());
+
+  // Dimension types are not cached, but still dispatch through the linear scan
+  ndt::type dim_tp = ndt::type("3 * int32");
+  EXPECT_THROW(dispatcher(ndt::type(), 1, &dim_tp), out_of_range);
+}
+
 /*
 TEST(Dispatcher, Unary) {
   dispatcher<1, int> dispatcher{
@@ -0,0 +1,29 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/eval/eval_context.hpp>
+
+/**
+ * Sets the number of threads and the grain size of the default evaluation
+ * context while it is in scope. The previous settings are restored on
+ * destruction, so a failing assertion can't leak them into other tests.
+ */
+class scoped_eval_context {
+  dynd::eval::eval_context m_saved;
+
+public:
+  scoped_eval_context(size_t nthreads, size_t grain_size) : m_saved(dynd::eval::default_eval_context) {
+    dynd::eval::default_eval_context.nthreads = nthreads;
+    dynd::eval::default_eval_context.grain_size = grain_size;
+  }
+
+  scoped_eval_context(const scoped_eval_context &) = delete;
+
+  scoped_eval_context &operator=(const scoped_eval_context &) = delete;
+
+  ~scoped_eval_context() { dynd::eval::default_eval_context = m_saved; }
+};
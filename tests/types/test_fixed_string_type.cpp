@@ -104,6 +104,48 @@ TEST(FixedstringDType, Casting) {
   EXPECT_EQ("abc", a.as<std::string>());
 }
 
+TEST(FixedstringDType, Transcoding) {
+  // Runs of ASCII longer than a vector step are copied in bulk, so mix them with
+  // characters that have to be transcoded one at a time
+  std::string ascii = "The quick brown fox jumps over the lazy dog, 0123456789 times over";
+  std::string mixed = ascii + "\xc3\xa9t\xc3\xa9 " + ascii + " \xe2\x82\xac" + ascii.substr(0, 17);
+
+  string_encoding_t encodings[] = {string_encoding_ascii, string_encoding_ucs_2, string_encoding_utf_8,
+                                   string_encoding_utf_16, string_encoding_utf_32};
+  for (string_encoding_t encoding : encodings) {
+    const std::string &s = (encoding == string_encoding_ascii) ? ascii : mixed;
+
+    nd::array a = nd::empty(ndt::make_type<ndt::fixed_string_type>(256, encoding));
+    a.assign(nd::array(s.c_str()));
+    EXPECT_EQ(s, a.as<std::string>()) << encoding;
+
+    // To and from other fixed_string encodings
+    nd::array b = nd::empty(ndt::make_type<ndt::fixed_string_type>(256, string_encoding_utf_32));
+    b.assign(a);
+    EXPECT_EQ(s, b.as<std::string>()) << encoding;
+    a.assign(b);
+    EXPECT_EQ(s, a.as<std::string>()) << encoding;
+
+    // Too small a destination stops at its end
+    nd::array c = nd::empty(ndt::make_type<ndt::fixed_string_type>(20, encoding));
+    c.assign(a, assign_error_nocheck);
+    EXPECT_EQ(s.substr(0, 20), c.as<std::string>()) << encoding;
+    EXPECT_THROW(c.assign(a), std::runtime_error);
+  }
+
+  // A shorter string assigned over a longer one is terminated where it ends
+  nd::array a = nd::empty(ndt::make_type<ndt::fixed_string_type>(256, string_encoding_utf_16));
+  a.assign(nd::array(mixed.c_str()));
+  nd::array b = nd::empty(ndt::make_type<ndt::fixed_string_type>(256, string_encoding_utf_16));
+  b.assign(nd::array(ascii.c_str()));
+  a.assign(b);
+  EXPECT_EQ(ascii, a.as<std::string>());
+
+  // Non-ASCII bytes in an ASCII string are still errors, however far in they are
+  nd::array d = nd::empty(ndt::make_type<ndt::fixed_string_type>(256, string_encoding_ascii));
+  EXPECT_THROW(d.assign(nd::array(mixed.c_str())), string_encode_error);
+}
+
 TEST(FixedstringDType, CanonicalDType) {
   EXPECT_EQ((ndt::make_type<ndt::fixed_string_type>(12, string_encoding_ascii)),
             (ndt::make_type<ndt::fixed_string_type>(12, string_encoding_ascii).get_canonical_type()));
@@ -9,10 +9,12 @@
 
 #include <dynd/array.hpp>
 #include <dynd/json_parser.hpp>
+#include <dynd/memblock/pod_memory_block.hpp>
 #include <dynd/string.hpp>
 #include <dynd/types/bytes_type.hpp>
 #include <dynd/types/fixed_string_type.hpp>
 #include <dynd/types/string_type.hpp>
+#include <dynd/types/string_view_type.hpp>
 #include <dynd/gtest.hpp>
 
 using namespace std;
@@ -170,6 +172,30 @@ TEST(StringType, Unicode)
 }
 */
 
+TEST(StringType, ValidateUTF8) {
+  std::string ascii(100, 'x');
+
+  validate_utf8_string(ascii.data(), ascii.data() + ascii.size());
+  std::string valid = ascii + "\xc3\xa9" + ascii + "\xf0\x9f\x98\x80" + std::string(1, '\0') + ascii;
+  validate_utf8_string(valid.data(), valid.data() + valid.size());
+
+  // Invalid bytes are found after long ASCII runs, and at the very end
+  const char *invalid[] = {"\xff", "\xc3", "\xc0\xaf", "\xed\xa0\x80", "\xe2\x82"};
+  for (const char *bad : invalid) {
+    std::string s = ascii + bad + ascii;
+    EXPECT_ANY_THROW(validate_utf8_string(s.data(), s.data() + s.size())) << s.size();
+    s = ascii + bad;
+    EXPECT_ANY_THROW(validate_utf8_string(s.data(), s.data() + s.size())) << s.size();
+  }
+
+  // JSON strings are validated with it
+  std::string json = "\"" + ascii + "\xc3\"";
+  EXPECT_ANY_THROW(parse_json(ndt::type("string"), json.c_str(), &eval::default_eval_context));
+  json = "\"" + valid.substr(0, 206) + "\"";
+  EXPECT_EQ(valid.substr(0, 206),
+            parse_json(ndt::type("string"), json.c_str(), &eval::default_eval_context).as<std::string>());
+}
+
 TEST(StringType, CanonicalDType) {
   // The canonical type of a string type is the same type
   EXPECT_EQ((ndt::make_type<ndt::string_type>()), (ndt::make_type<ndt::string_type>().get_canonical_type()));
@@ -417,6 +443,30 @@ TEST(StringType, Find3) {
   EXPECT_ARRAY_EQ(c, nd::string_find(a, b));
 }
 
+TEST(StringType, Find4) {
+  // Needles of 2 to 32 bytes are searched by comparing their first and last bytes
+  // at many positions at once, so check against std::string over long haystacks
+  std::string haystack;
+  for (int i = 0; i < 300; ++i) {
+    haystack += static_cast<char>('a' + (i * 7) % 5);
+  }
+  const char *needles[] = {"ab", "ac", "zz", "ecb", "aebd", "dacebdac", "bdacebdacebdacebdacebdacebdaceb"};
+  for (const char *needle : needles) {
+    for (size_t start = 0; start < 70; ++start) {
+      std::string s = haystack.substr(start);
+      size_t expected = s.find(needle);
+      EXPECT_EQ(expected == std::string::npos ? -1 : static_cast<intptr_t>(expected),
+                nd::string_find(nd::array(s.c_str()), nd::array(needle)).as<intptr_t>())
+          << "needle " << needle << ", start " << start;
+    }
+  }
+
+  // A match in the last bytes of the haystack
+  std::string s(100, 'x');
+  s += "xyz";
+  EXPECT_EQ(101, nd::string_find(nd::array(s.c_str()), "yz").as<intptr_t>());
+}
+
 TEST(StringType, RFind1) {
   nd::array a, b;
 
@@ -459,6 +509,30 @@ TEST(StringType, Count3) {
   EXPECT_ARRAY_EQ(c, nd::string_count(a, b));
 }
 
+TEST(StringType, Count4) {
+  nd::array a, b;
+
+  // Adjacent and overlapping occurrences, inside and past the first 32 bytes
+  a = {"abcabc", "aaaa", "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxabcabcabc", "abcab"};
+  b = {"abc", "aa", "abc", "abcab"};
+  intptr_t c[] = {2, 2, 3, 1};
+
+  EXPECT_ARRAY_EQ(c, nd::string_count(a, b));
+}
+
+TEST(StringType, Count5) {
+  nd::array a, b;
+
+  // Needles longer than 32 bytes, occurring back to back
+  std::string n = "0123456789abcdefghijklmnopqrstuvwxyzABCD";
+  std::string m = std::string(39, 'a') + "b";
+  a = {n + n, n + n + n, "x" + n + n + "y", m + m, std::string(5, 'a') + m + m};
+  b = {n, n, n, m, m};
+  intptr_t c[] = {2, 3, 2, 2, 2};
+
+  EXPECT_ARRAY_EQ(c, nd::string_count(a, b));
+}
+
 TEST(StringType, Replace) {
   nd::array a, b, c, d;
 
@@ -514,6 +588,88 @@ TEST(StringType, Split) {
   EXPECT_EQ("foobar", c(3)(0));
 }
 
+TEST(StringType, SplitMany) {
+  // Enough pieces to grow the output several times, for consecutive strings
+  std::string s0, s1;
+  for (int i = 0; i < 100; ++i) {
+    s0 += (i == 0 ? "" : ",") + std::to_string(i);
+    s1 += (i == 0 ? "" : ",") + std::string(20, 'a' + i % 26);
+  }
+  nd::array a = {s0.c_str(), "", s1.c_str()};
+
+  nd::array c = nd::string_split(a, ",");
+  EXPECT_EQ(100, c(0).get_dim_size());
+  EXPECT_EQ(1, c(1).get_dim_size());
+  EXPECT_EQ(100, c(2).get_dim_size());
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(std::to_string(i), c(0, i).as<std::string>());
+    EXPECT_EQ(std::string(20, 'a' + i % 26), c(2, i).as<std::string>());
+  }
+  EXPECT_EQ("", c(1, 0).as<std::string>());
+}
+
+TEST(StringType, SplitOffsets) {
+  nd::array a, b, c;
+
+  a = {"xaxxbxxxc", "xxxabcxxxabcxxx", "foobar", ""};
+  b = {"x", "abc", "", "x"};
+
+  c = nd::string_split_offsets(a, b);
+  EXPECT_EQ(ndt::type("4 * var * 2 * intptr"), c.get_type());
+
+  // The offsets pick out the same pieces string_split copies
+  nd::array d = nd::string_split(a, b);
+  for (intptr_t i = 0; i < 4; ++i) {
+    std::string s = a(i).as<std::string>();
+    ASSERT_EQ(d(i).get_dim_size(), c(i).get_dim_size());
+    for (intptr_t j = 0; j < c(i).get_dim_size(); ++j) {
+      intptr_t begin = c(i, j, 0).as<intptr_t>(), end = c(i, j, 1).as<intptr_t>();
+      EXPECT_EQ(d(i, j).as<std::string>(), s.substr(begin, end - begin));
+    }
+  }
+
+  EXPECT_EQ(3, c(1, 0, 1).as<intptr_t>());
+  EXPECT_EQ(6, c(1, 1, 0).as<intptr_t>());
+  EXPECT_EQ(15, c(1, 2, 1).as<intptr_t>());
+}
+
+TEST(StringType, Arena) {
+  const std::string long_value = "a string too long for the small string optimization";
+  nd::memory_block arena = nd::make_string_arena();
+
+  dynd::string s;
+  s.assign(long_value.data(), long_value.size(), *arena);
+  EXPECT_EQ(long_value, std::string(s.begin(), s.end()));
+  // Shorter values reuse the buffer, longer ones move to the heap
+  s.assign("short", 5, *arena);
+  EXPECT_EQ("short", std::string(s.begin(), s.end()));
+  s.assign(long_value.data(), long_value.size(), *arena);
+
+  // Copies and moves don't refer to the arena, so outlive it
+  dynd::string copied = s, moved = std::move(s);
+  s.clear();
+  arena = nd::memory_block();
+  EXPECT_EQ(long_value, std::string(copied.begin(), copied.end()));
+  EXPECT_EQ(long_value, std::string(moved.begin(), moved.end()));
+
+  // Strings parsed from JSON or split into var dims are freed with the array holding them
+  nd::array a = parse_json(ndt::type("3 * string"), "[\"" + long_value + "\", \"x\", \"" + long_value + "\\n\"]",
+                           &eval::default_eval_context);
+  nd::array b = a(2);
+  a = nd::array();
+  EXPECT_EQ(long_value + "\n", b.as<std::string>());
+
+  a = parse_json(ndt::type("var * {name: string}"), "[{\"name\": \"" + long_value + "\"}, {\"name\": \"y\"}]",
+                 &eval::default_eval_context);
+  EXPECT_EQ(long_value, a(0).p("name").as<std::string>());
+  EXPECT_EQ("y", a(1).p("name").as<std::string>());
+
+  a = nd::string_split(nd::array(long_value + "," + long_value), nd::array(","));
+  b = a(1);
+  a = nd::array();
+  EXPECT_EQ(long_value, b.as<std::string>());
+}
+
 TEST(StringType, StartsWith) {
   nd::array a, b, c;
 
@@ -544,6 +700,32 @@ TEST(StringType, Contains) {
   EXPECT_ARRAY_EQ(c, nd::string_contains(a, b));
 }
 
+TEST(StringType, ContainsAny) {
+  nd::array a, b, c;
+
+  a = {"ushers", "she", "his", "he", "", "hhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhers", "xshx"};
+  b = {"he", "she", "hers", "his"};
+  c = {true, true, true, true, false, true, false};
+  EXPECT_ARRAY_EQ(c, nd::string_contains_any({a}, {{"patterns", b}}));
+
+  // A pattern found only through the failure link of a longer one
+  b = {"abcd", "bc"};
+  c = {false, false, false, false, false, false, false};
+  EXPECT_ARRAY_EQ(c, nd::string_contains_any({a}, {{"patterns", b}}));
+  EXPECT_ARRAY_EQ(nd::array({true, true, false}),
+                  nd::string_contains_any({nd::array({"abce", "xbcx", "acbd"})}, {{"patterns", b}}));
+
+  // Empty patterns never match
+  b = {"", "zz"};
+  c = {false, false, false, false, false, false, false};
+  EXPECT_ARRAY_EQ(c, nd::string_contains_any({a}, {{"patterns", b}}));
+
+  // Views search the same way
+  a = parse_json(ndt::type("3 * string_view"), "[\"ushers\", \"his\", \"hi\"]", &eval::default_eval_context);
+  b = {"he", "is"};
+  EXPECT_ARRAY_EQ(nd::array({true, true, false}), nd::string_contains_any({a}, {{"patterns", b}}));
+}
+
 template <class T>
 static bool ascii_T_compare(const char *x, const T *y, intptr_t count) {
   for (intptr_t i = 0; i < count; ++i) {
@@ -0,0 +1,123 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include <dynd/array.hpp>
+#include <dynd/comparison.hpp>
+#include <dynd/json_parser.hpp>
+#include <dynd/string.hpp>
+#include <dynd/types/string_view_type.hpp>
+#include <dynd/gtest.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(StringViewType, Create) {
+  ndt::type d = ndt::make_type<dynd::string_view>();
+  EXPECT_EQ(string_view_id, d.get_id());
+  EXPECT_EQ(string_kind_id, d.get_base_id());
+  EXPECT_EQ(sizeof(dynd::string_view), d.get_data_size());
+  EXPECT_EQ(sizeof(string_view_type_arrmeta), d.get_arrmeta_size());
+  EXPECT_FALSE(d.is_expression());
+  EXPECT_EQ("string_view", d.str());
+  EXPECT_EQ(d, ndt::type("string_view"));
+  EXPECT_TRUE(ndt::type("String").match(d));
+}
+
+TEST(StringViewType, ParseJSON) {
+  nd::array a = parse_json(ndt::type("3 * string_view"), "[\"abc\", \"\", \"line\\nbreak\"]",
+                           &eval::default_eval_context);
+  EXPECT_EQ(ndt::type("3 * string_view"), a.get_type());
+  EXPECT_EQ("abc", a(0).as<std::string>());
+  EXPECT_EQ("", a(1).as<std::string>());
+  EXPECT_EQ("line\nbreak", a(2).as<std::string>());
+
+  // The viewed bytes are kept alive by the arrmeta
+  nd::array b = a(2);
+  a = nd::array();
+  EXPECT_EQ("line\nbreak", b.as<std::string>());
+
+  a = parse_json(ndt::type("var * {name: string_view}"), "[{\"name\": \"x\"}, {\"name\": \"\\u00e9t\\u00e9\"}]",
+                 &eval::default_eval_context);
+  EXPECT_EQ("x", a(0).p("name").as<std::string>());
+  EXPECT_EQ("\xc3\xa9t\xc3\xa9", a(1).p("name").as<std::string>());
+}
+
+TEST(StringViewType, Assign) {
+  nd::array a = nd::empty(ndt::type("2 * string_view"));
+  a(0).assign(nd::array("a string copied into the views' memory block"));
+  a(1).assign(nd::array(""));
+  EXPECT_EQ("a string copied into the views' memory block", a(0).as<std::string>());
+  EXPECT_EQ("", a(1).as<std::string>());
+
+  nd::array b = nd::empty(ndt::type("2 * string"));
+  b.assign(a);
+  EXPECT_EQ("a string copied into the views' memory block", b(0).as<std::string>());
+
+  // Assigning views between arrays copies the bytes
+  nd::array c = nd::empty(ndt::type("2 * string_view"));
+  c.assign(a);
+  a = nd::array();
+  EXPECT_EQ("a string copied into the views' memory block", c(0).as<std::string>());
+}
+
+TEST(StringViewType, Comparisons) {
+  nd::array a = parse_json(ndt::type("3 * string_view"), "[\"abc\", \"abd\", \"ab\"]", &eval::default_eval_context);
+  nd::array b = parse_json(ndt::type("3 * string_view"), "[\"abc\", \"abc\", \"abc\"]", &eval::default_eval_context);
+  nd::array c = {"abc", "abc", "abc"};
+
+  EXPECT_ARRAY_EQ(nd::array({true, false, false}), a == b);
+  EXPECT_ARRAY_EQ(nd::array({true, false, false}), a == c);
+  EXPECT_ARRAY_EQ(nd::array({true, false, false}), c == a);
+  EXPECT_ARRAY_EQ(nd::array({false, false, true}), a < b);
+  EXPECT_ARRAY_EQ(nd::array({false, false, true}), a < c);
+  EXPECT_ARRAY_EQ(nd::array({false, true, false}), c < a);
+  EXPECT_ARRAY_EQ(nd::array({false, true, false}), a > c);
+}
+
+TEST(StringViewType, Search) {
+  nd::array a = parse_json(ndt::type("4 * string_view"), "[\"abc\", \"ababc\", \"ababab\", \"abd\"]",
+                           &eval::default_eval_context);
+  nd::array b = parse_json(ndt::type("string_view"), "\"abc\"", &eval::default_eval_context);
+
+  intptr_t find[] = {0, 2, -1, -1};
+  EXPECT_ARRAY_EQ(find, nd::string_find(a, b));
+  EXPECT_ARRAY_EQ(find, nd::string_find(a, "abc"));
+
+  intptr_t count[] = {1, 1, 0, 0};
+  EXPECT_ARRAY_EQ(count, nd::string_count(a, "abc"));
+
+  EXPECT_ARRAY_EQ(nd::array({true, true, false, false}), nd::string_contains(a, b));
+  EXPECT_ARRAY_EQ(nd::array({true, false, false, false}), nd::string_startswith(a, "abc"));
+  EXPECT_ARRAY_EQ(nd::array({true, true, false, false}), nd::string_endswith(a, b));
+  EXPECT_ARRAY_EQ(nd::array({false, false, false, false}), nd::string_startswith("ab", a));
+}
+
+TEST(StringViewType, Split) {
+  nd::array a =
+      parse_json(ndt::type("2 * string_view"), "[\"a,bc,,d\", \"xyz\"]", &eval::default_eval_context);
+  nd::array b = nd::string_split(a, ",");
+  EXPECT_EQ(ndt::type("2 * var * string_view"), b.get_type());
+  EXPECT_EQ(4, b(0).get_dim_size());
+  EXPECT_EQ("a", b(0, 0).as<std::string>());
+  EXPECT_EQ("bc", b(0, 1).as<std::string>());
+  EXPECT_EQ("", b(0, 2).as<std::string>());
+  EXPECT_EQ("d", b(0, 3).as<std::string>());
+  EXPECT_EQ(1, b(1).get_dim_size());
+  EXPECT_EQ("xyz", b(1, 0).as<std::string>());
+
+  // The pieces view the bytes of the source without copying them
+  const dynd::string_view &src = *reinterpret_cast<const dynd::string_view *>(a(0).cdata());
+  const dynd::string_view &piece = *reinterpret_cast<const dynd::string_view *>(b(0, 1).cdata());
+  EXPECT_EQ(src.data() + 2, piece.data());
+  a = nd::array();
+  EXPECT_EQ("bc", b(0, 1).as<std::string>());
+
+  // Splitting strings still makes strings
+  EXPECT_EQ(ndt::type("var * string"), nd::string_split(nd::array("a,b"), ",").get_type());
+}
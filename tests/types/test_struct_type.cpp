@@ -436,3 +436,30 @@ TEST(StructType, InvalidFieldName) {
 }
 
 TEST(StructType, IDOf) { EXPECT_EQ(struct_id, ndt::id_of<ndt::struct_type>::value); }
+
+TEST(StructType, FieldIndexLookup) {
+  vector<std::string> names;
+  vector<ndt::type> types;
+  for (int i = 0; i < 100; ++i) {
+    names.push_back("field" + to_string(i));
+    types.push_back(ndt::make_type<int32_t>());
+  }
+  names.push_back("field7");
+  types.push_back(ndt::make_type<double>());
+  ndt::type tp = ndt::make_type<ndt::struct_type>(names, types);
+  const ndt::struct_type *sd = tp.extended<ndt::struct_type>();
+
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(i, sd->get_field_index(names[i]));
+  }
+  // A duplicate name finds the first field with it
+  EXPECT_EQ(7, sd->get_field_index("field7"));
+  EXPECT_EQ(-1, sd->get_field_index("field100"));
+  EXPECT_EQ(-1, sd->get_field_index(""));
+
+  const char name[] = "field42, field43";
+  EXPECT_EQ(42, sd->get_field_index(name, name + 7));
+  EXPECT_EQ(-1, sd->get_field_index(name, name + 8));
+
+  EXPECT_EQ(-1, ndt::make_type<ndt::struct_type>().extended<ndt::struct_type>()->get_field_index("x"));
+}